@@ -0,0 +1,203 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   extheap.h
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   Interface of external memory priority queue.
+      Others:   The items are copied in by value. The items added are kept in
+                a heap in memery until it's full, then they are written to a
+                temporary file in ascending order as a run, and the memery is
+                used again. The least item is the less of the heap root and
+                the head of the least run, the runs are read ahead a block at
+                a time, so both writing and reading are sequential. Every
+                EXTHEAP_WAYS runs of the same level are merged into one run of
+                the next level, which keeps the runs few. Include stdlib.h,
+                type.h, err.h and heap.h before this file
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+#ifndef _EXTHEAP_H_
+#define _EXTHEAP_H_
+
+/**a sorted run in a temporary file**/
+typedef struct tagExtRun_S
+{
+    VOID *pvHead;             /*the least item left in the run*/
+    PF_COMPARE pfCompare;     /*to compare the heads of two runs*/
+    VOID *pvFile;             /*FILE* of the run, unlinked once created*/
+    CHAR *pcBuf;              /*items read ahead*/
+    UINT uiHave;              /*how many items in pcBuf*/
+    UINT uiPos;               /*place of the head in pcBuf*/
+    ULONG ulBufOffset;        /*file offset of pcBuf*/
+    ULONG ulNextOffset;       /*file offset of the next read*/
+    UINT uiLevel;             /*0 for a run spilled from memery*/
+}ExtRun_S;
+
+typedef struct tagExtHeap_S
+{
+    UINT uiItemSize;
+    UINT uiMemSize;           /*how many items can be kept in memery*/
+    UINT uiBufSize;           /*how many items read ahead for each run*/
+    CHAR *pcTmpDir;           /*directory of the temporary files*/
+    PF_COMPARE pfCompare;
+    CHAR *pcSlot;             /*memery of the items in memery*/
+    VOID **ppvFree;           /*free slots in pcSlot*/
+    UINT uiFree;
+    Heap_S *pstMem;           /*items in memery*/
+    Heap_S *pstRun;           /*runs by their heads*/
+    ExtRun_S **ppstRun;       /*all runs*/
+    UINT uiRuns;
+    UINT uiRunSize;           /*how many runs ppstRun can hold*/
+    ULONG ulNum;              /*items in memery and runs*/
+}ExtHeap_S;
+
+/*******************************************************************************
+    Func Name:  ExtHeapCreate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create an external memery priority queue
+        Input:  IN UINT uiItemSize, bytes of an item
+                IN ULONG ulMemory, bytes of memery for the items and buffers
+                IN CHAR *pcTmpDir, directory of the temporary files, NULL for
+                                   /tmp
+                IN PF_COMPARE pfCompare, callback function to compare two items
+       Output:  NONE
+       Return:  ExtHeap_S*,  the queue struct
+                NULL,        error occured
+      Caution:  uiItemSize should not be 0, pfCompare should not be NULL. The
+                least item by pfCompare is the root, reverse pfCompare to get
+                the max one first. 3/4 of ulMemory keeps the items in memery,
+                each costs uiItemSize and 2 pointers, and the rest is shared
+                by the read ahead buffers of 64 runs. The files are removed
+                once created, so none is left behind even if the process dies
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ExtHeap_S* ExtHeapCreate(IN UINT uiItemSize, IN ULONG ulMemory,
+                         IN CHAR *pcTmpDir,
+                         IN PF_COMPARE pfCompare);
+
+/*******************************************************************************
+    Func Name:  ExtHeapFree
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To free a given queue
+        Input:  IN ExtHeap_S *pstHeap, the queue to be freed
+       Output:  NONE
+       Return:  NONE
+      Caution:  The temporary files are closed and gone
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID ExtHeapFree(IN ExtHeap_S *pstHeap);
+
+/*******************************************************************************
+    Func Name:  ExtHeapAdd
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add an item to queue
+        Input:  IN ExtHeap_S *pstHeap
+                IN VOID *pvItem, the item to be copied in
+       Output:  OUT ExtHeap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, nothing is added
+      Caution:  costs O(log m) for m items in memery, and a spill of all of
+                them when the memery is full. It fails if the run can't be
+                written, then the items stay in memery. A merge that fails
+                leaves its runs as they were and is tried at the next spill
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG ExtHeapAdd(INOUT ExtHeap_S *pstHeap, IN VOID *pvItem);
+
+/*******************************************************************************
+    Func Name:  ExtHeapGetRoot
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Copy out the least item without removing it
+        Input:  IN ExtHeap_S *pstHeap
+       Output:  OUT VOID *pvItem, uiItemSize bytes
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, or the queue is empty
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG ExtHeapGetRoot(IN ExtHeap_S *pstHeap, OUT VOID *pvItem);
+
+/*******************************************************************************
+    Func Name:  ExtHeapRemoveRoot
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Copy out and remove the least item
+        Input:  IN ExtHeap_S *pstHeap
+       Output:  OUT ExtHeap_S *pstHeap
+                OUT VOID *pvItem, uiItemSize bytes
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, or the queue is empty
+      Caution:  costs O(log m + log r) for m items in memery and r runs, and
+                a read of a block when the head of a run goes out of its
+                buffer. The item is not removed if the read fails
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG ExtHeapRemoveRoot(INOUT ExtHeap_S *pstHeap, OUT VOID *pvItem);
+
+/*******************************************************************************
+    Func Name:  ExtHeapNumber
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many items in queue
+        Input:  IN ExtHeap_S *pstHeap
+       Output:  NONE
+       Return:  ULONG
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG ExtHeapNumber(IN ExtHeap_S *pstHeap);
+
+/*******************************************************************************
+    Func Name:  ExtHeapRuns
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many runs in temporary files
+        Input:  IN ExtHeap_S *pstHeap
+       Output:  NONE
+       Return:  UINT
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT ExtHeapRuns(IN ExtHeap_S *pstHeap);
+
+#endif
@@ -18,17 +18,52 @@ Copyright(C):   Huazhong University of Science & Technology.
 
 #define HEAP_MINI     0
 #define HEAP_MAXI     1
-#define HEAP_UPSPACE  2
+#define HEAP_MINMAX   2       /*both the minimal and the max item can be removed*/
+#define HEAP_UPSPACE  3
+#define HEAP_TYPEMASK 0xFF    /*the flags below can be or-ed to uiType*/
+
+#define HEAP_INDEXED  0x100   /*items can be located by handle*/
+#define HEAP_ARITY4   0x200   /*every node has 4 children*/
+#define HEAP_ARITY8   0x400   /*every node has 8 children*/
+#define HEAP_ARITYMASK (HEAP_ARITY4 | HEAP_ARITY8)
+#define HEAP_BLOCKED  0x800   /*subtrees are laid in 4KB pages, B-heap*/
 
 typedef struct tagHeap_S
 {
     UINT uiSize;
+    VOID **ppvBase;           /*memery of places, the root is not the first*/
     VOID **ppvHeap;
     VOID **ppvTail;
     UINT uiType;
+    UINT uiFlag;
+    UINT uiShift;             /*log2 of how many children a node has*/
+    UINT uiTopLevel;          /*levels in the first page, HEAP_BLOCKED only*/
     PF_COMPARE pfCompare;
     PF_PRINT pfPrint;
     PF_FREE pfFree;
+    UINT *puiHandle;          /*handle of item in each place, HEAP_INDEXED only*/
+    UINT *puiPlace;           /*place of item of each handle, HEAP_INDEXED only*/
+    BOOL_T bGrow;             /*grow automatically, see HeapSetGrow*/
+    UINT uiShrink;
+    UINT uiMinSize;
+    UINT uiNextSize;          /*the memery being moved to when growing or shrinking*/
+    UINT uiNextTopLevel;
+    VOID **ppvNextBase;
+    VOID **ppvNext;
+    UINT *puiNextHandle;
+    UINT *puiNextPlace;
+    UINT uiMoved;             /*places before it have been moved*/
+    UINT uiHandleMoved;       /*handles before it have been moved*/
+    PF_HASH pfHash;           /*hash of item, see HeapSetHash*/
+    UINT uiHashSize;          /*how many places the hash index can hold*/
+    UINT uiBucketMask;        /*buckets of the index - 1*/
+    UINT *puiBucket;          /*place of the item in each bucket*/
+    ULONG *pulBucketHash;     /*hash of the item in each bucket*/
+    UINT *puiEntry;           /*bucket of the item in each place*/
+    UINT uiNextBucketMask;    /*the index being built when growing*/
+    UINT *puiNextBucket;
+    ULONG *pulNextBucketHash;
+    UINT *puiNextEntry;
 }Heap_S;
 
   /*******************************************************************************
@@ -37,7 +72,11 @@ typedef struct tagHeap_S
        Author:  Zhulinfeng
   Description:  To create a data structure of heap
         Input:  IN UINT uiSize, how many items the heap can store.
-                IN UINT uiType, HEAP_MINI for minimal heap, HEAP_MAXI for maximum heap 
+                IN UINT uiType, HEAP_MINI for minimal heap, HEAP_MAXI for maximum heap,
+                                HEAP_MINMAX for min-max heap, 
+                                or-ed with HEAP_INDEXED to locate items by handle,
+                                HEAP_ARITY4 or HEAP_ARITY8 for 4-ary or 8-ary heap,
+                                HEAP_BLOCKED to lay subtrees in pages
                 IN PF_COMPARE pfCompare, callback function to compare two items
                 IN PF_PRINT pfPrint, callback function to print item
                 IN PF_FREE pfFree, callback function to free item
@@ -48,6 +87,12 @@ typedef struct tagHeap_S
                 pfPrint can be NULL
                 pfFree can be NULL if you don't want your data to be freed when deleting
                 the heap
+                HEAP_MINMAX heap is always binary
+                HEAP_BLOCKED heap is binary and not HEAP_MINMAX, a path of 9
+                levels stays in one 4KB page, so a sift through a heap much
+                larger than memery touches a page every 9 levels instead of
+                every level. The tree is as deep as the flat one, but the
+                memery may be up to twice as large
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
@@ -59,6 +104,87 @@ Heap_S* HeapCreate(IN UINT uiSize, IN UINT uiType,
                    IN PF_PRINT pfPrint,
                    IN PF_FREE pfFree);
 
+/*******************************************************************************
+    Func Name:  HeapCreateFromArray
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a heap filled with the items of an array
+        Input:  IN VOID **ppvItems, the items to be put into heap
+                IN UINT uiNum, how many items in ppvItems
+                IN UINT uiSize, how many items the heap can store.
+                IN UINT uiType, HEAP_MINI for minimal heap, HEAP_MAXI for maximum heap 
+                IN PF_COMPARE pfCompare, callback function to compare two items
+                IN PF_PRINT pfPrint, callback function to print item
+                IN PF_FREE pfFree, callback function to free item
+       Output:  NONE  
+       Return:  Heap_S*,  the heap struct
+                NULL,     error occured
+      Caution:  uiSize should not be less than uiNum, and no item in ppvItems
+                can be NULL. The items are copied in one go and heapified 
+                bottom-up, costs O(n) instead of O(n log n) of n HeapAdd.
+                In HEAP_INDEXED heap the handle of ppvItems[i] is i
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+Heap_S* HeapCreateFromArray(IN VOID **ppvItems, IN UINT uiNum,
+                            IN UINT uiSize, IN UINT uiType,
+                            IN PF_COMPARE pfCompare,
+                            IN PF_PRINT pfPrint,
+                            IN PF_FREE pfFree);
+
+/*******************************************************************************
+    Func Name:  HeapSetGrow
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Make a heap grow automatically instead of being full
+        Input:  IN Heap_S *pstHeap
+                IN UINT uiShrink, shrink the heap to half if less than 
+                                  1/uiShrink of it is used, 0 for never
+       Output:  OUT Heap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed
+      Caution:  uiShrink should be 0 or not less than 4. The heap doubles when
+                it is 3/4 full, and never shrinks below the size it's created
+                with. The items are copied to the new memery a few a time by
+                every add and remove, so no one of them stalls for copying the
+                whole heap. HEAP_INDEXED heap never shrinks, for the handles 
+                can't be renumbered
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+ULONG HeapSetGrow(INOUT Heap_S *pstHeap, IN UINT uiShrink);
+
+/*******************************************************************************
+    Func Name:  HeapSetHash
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Index the items of a heap by hash
+        Input:  IN Heap_S *pstHeap
+                IN PF_HASH pfHash, callback function to hash item
+       Output:  OUT Heap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, or the heap is indexed already
+      Caution:  Items equal by pfCompare should have the same hash. Then
+                HeapSearch costs O(1) and HeapRemoveItem costs O(log n), but
+                every add hashes the item once. The items already in heap are
+                indexed at once. The index is rebuilt when the heap grows,
+                costs O(n) but no hash is called
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+ULONG HeapSetHash(INOUT Heap_S *pstHeap, IN PF_HASH pfHash);
+
 /*******************************************************************************
     Func Name:  HeapFree
  Date Created:  2014-9-17
@@ -98,6 +224,31 @@ VOID HeapFree(IN Heap_S *pstHeap);
 *******************************************************************************/
 ULONG HeapAdd(INOUT Heap_S *pstHeap, IN VOID *pvItem);
 
+/*******************************************************************************
+    Func Name:  HeapAddBatch
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add a batch of items to heap
+        Input:  IN Heap_S *pstHeap
+                IN VOID **ppvItems, items to be added
+                IN UINT uiNum, how many items in ppvItems
+       Output:  OUT Heap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, nothing is added
+      Caution:  No item in ppvItems can be NULL. A small batch is sifted up item
+                by item, costs O(k log n), while a large one makes the whole 
+                heap rebuilt, costs O(n + k). A HeapSetGrow heap moves to the
+                next memery step by step as HeapAdd does, it's grown at once
+                only if the batch can't fit the memery
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+ULONG HeapAddBatch(INOUT Heap_S *pstHeap, IN VOID **ppvItems, IN UINT uiNum);
+
 /*******************************************************************************
     Func Name:  HeapSearch
  Date Created:  2014-9-17
@@ -108,7 +259,7 @@ ULONG HeapAdd(INOUT Heap_S *pstHeap, IN VOID *pvItem);
        Output:  NONE
        Return:  VOID*, the item found
                 NULL,  not found
-      Caution:  NONE
+      Caution:  costs O(n), or O(1) if the heap is indexed by HeapSetHash
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
@@ -127,7 +278,11 @@ VOID* HeapSearch(IN Heap_S *pstHeap, IN VOID *pvItem);
        Return:  VOID*, the item removed out
                 NULL, failed, the heap is empty
       Caution:  The function only removes items from heap, but the memery is 
-                left to users to free
+                left to users to free. The root is removed bottom up: the hole
+                it leaves goes down to a leaf without comparing with the tail
+                item, which then goes up from there. It saves about half of
+                the compares, for the tail item seldom goes far up. HEAP_MINMAX
+                heap sifts the tail item down from the root instead
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
@@ -166,7 +321,8 @@ VOID* HeapRemoveTail(IN Heap_S *pstHeap);
        Return:  VOID*, the item removed out
                 NULL, not found
       Caution:  The function only removes items from heap, but the memery is 
-                left to users to free
+                left to users to free. It costs O(n) to find the item, or
+                O(1) if the heap is indexed by HeapSetHash
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
@@ -175,6 +331,94 @@ VOID* HeapRemoveTail(IN Heap_S *pstHeap);
 *******************************************************************************/
 VOID* HeapRemoveItem(IN Heap_S *pstHeap, IN VOID *pvItem);
 
+/*******************************************************************************
+    Func Name:  HeapAddHandle
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add an item to heap and get its handle
+        Input:  IN Heap_S *pstHeap
+                IN VOID *pvItem, item to be added
+       Output:  OUT Heap_S *pstHeap
+                OUT UINT *puiHandle, handle of the item
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed
+      Caution:  The heap should be HEAP_INDEXED, the handle keeps valid until
+                the item is removed, then it may be reused by another item
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+ULONG HeapAddHandle(INOUT Heap_S *pstHeap, IN VOID *pvItem,
+                    OUT UINT *puiHandle);
+
+/*******************************************************************************
+    Func Name:  HeapUpdate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Keep heap healthy after the key of an item changed
+        Input:  IN Heap_S *pstHeap
+                IN UINT uiHandle, handle of the changed item
+       Output:  OUT Heap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, the handle is not in use
+      Caution:  The heap should be HEAP_INDEXED, costs O(log n). The item is
+                indexed again by its new hash if HeapSetHash is set
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+ULONG HeapUpdate(INOUT Heap_S *pstHeap, IN UINT uiHandle);
+
+/*******************************************************************************
+    Func Name:  HeapDecreaseKey
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Keep heap healthy after an item became more prior, that's 
+                the key decreased in HEAP_MINI heap or increased in HEAP_MAXI
+                heap
+        Input:  IN Heap_S *pstHeap
+                IN UINT uiHandle, handle of the changed item
+       Output:  OUT Heap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, the handle is not in use
+      Caution:  The heap should be HEAP_INDEXED, costs O(log n). The item is
+                indexed again by its new hash if HeapSetHash is set
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+ULONG HeapDecreaseKey(INOUT Heap_S *pstHeap, IN UINT uiHandle);
+
+/*******************************************************************************
+    Func Name:  HeapRemoveHandle
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  remove the item of a handle from heap
+        Input:  IN Heap_S *pstHeap
+                IN UINT uiHandle, handle of the item to be removed
+       Output:  NONE
+       Return:  VOID*, the item removed out
+                NULL, the handle is not in use
+      Caution:  The heap should be HEAP_INDEXED, costs O(log n). The function 
+                only removes items from heap, but the memery is left to users
+                to free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+VOID* HeapRemoveHandle(IN Heap_S *pstHeap, IN UINT uiHandle);
+
 /*******************************************************************************
     Func Name:  HeapPrint
  Date Created:  2014-9-17
@@ -218,7 +462,7 @@ UINT HeapNumber(IN Heap_S *pstHeap);
        Output:  NONE
        Return:  VOID*, the max item
                 NULL, failed
-      Caution:  NONE
+      Caution:  costs O(1) in HEAP_MINMAX heap
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
@@ -236,7 +480,7 @@ VOID* HeapMax(IN Heap_S *pstHeap);
        Output:  NONE
        Return:  VOID*, the minimal item
                 NULL, failed
-      Caution:  NONE
+      Caution:  costs O(1) in HEAP_MINMAX heap
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
@@ -245,4 +489,188 @@ VOID* HeapMax(IN Heap_S *pstHeap);
 *******************************************************************************/
 VOID* HeapMin(IN Heap_S *pstHeap);
 
+/*******************************************************************************
+    Func Name:  HeapRemoveMin
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  remove the minimal item from heap
+        Input:  IN Heap_S *pstHeap
+       Output:  NONE
+       Return:  VOID*, the item removed out
+                NULL, failed, the heap is empty
+      Caution:  costs O(log n) in HEAP_MINMAX heap, O(n) if it's not the root
+                of HEAP_MINI or HEAP_MAXI heap. The function only removes items
+                from heap, but the memery is left to users to free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+VOID* HeapRemoveMin(IN Heap_S *pstHeap);
+
+/*******************************************************************************
+    Func Name:  HeapRemoveMax
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  remove the max item from heap
+        Input:  IN Heap_S *pstHeap
+       Output:  NONE
+       Return:  VOID*, the item removed out
+                NULL, failed, the heap is empty
+      Caution:  costs O(log n) in HEAP_MINMAX heap, O(n) if it's not the root
+                of HEAP_MINI or HEAP_MAXI heap. The function only removes items
+                from heap, but the memery is left to users to free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+VOID* HeapRemoveMax(IN Heap_S *pstHeap);
+
+
+/*******************************************************************************
+    Func Name:  HeapPushPop
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add an item to heap, then remove the root
+        Input:  IN Heap_S *pstHeap
+                IN VOID *pvItem, item to be added
+       Output:  OUT Heap_S *pstHeap
+       Return:  VOID*, the item removed out, it's pvItem itself if the heap is
+                       empty or pvItem is not behind the root
+                NULL, failed
+      Caution:  pvItem should not be NULL. The heap is not touched if pvItem
+                is returned, otherwise it sifts once, costs O(log n). In
+                HEAP_INDEXED heap the item added takes the handle of the root
+                removed. The memery of the item removed is left to users to
+                free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* HeapPushPop(INOUT Heap_S *pstHeap, IN VOID *pvItem);
+
+/*******************************************************************************
+    Func Name:  HeapReplace
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Remove the root from heap, then add an item
+        Input:  IN Heap_S *pstHeap
+                IN VOID *pvItem, item to be added
+       Output:  OUT Heap_S *pstHeap
+       Return:  VOID*, the item removed out
+                NULL, failed, the heap is empty and pvItem is not added
+      Caution:  pvItem should not be NULL, it's added even if it's prior to
+                the root removed. It sifts once, costs O(log n). In
+                HEAP_INDEXED heap the item added takes the handle of the root
+                removed. The memery of the item removed is left to users to
+                free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* HeapReplace(INOUT Heap_S *pstHeap, IN VOID *pvItem);
+
+/*******************************************************************************
+    Func Name:  HeapRemoveRootN
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Remove at most k roots from heap one after another
+        Input:  IN Heap_S *pstHeap
+                IN UINT uiK, how many roots to remove at most
+       Output:  OUT Heap_S *pstHeap
+                OUT VOID **ppvItems, the items removed, the prior first
+       Return:  UINT, how many items removed, less than uiK if the heap runs
+                      out
+      Caution:  ppvItems should hold uiK items. Each root is removed as
+                HeapRemoveRoot does. The memery of the items is left to users
+                to free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT HeapRemoveRootN(INOUT Heap_S *pstHeap, IN UINT uiK, OUT VOID **ppvItems);
+
+/*******************************************************************************
+    Func Name:  HeapRemoveIf
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Remove all items matching a predicate from heap
+        Input:  IN Heap_S *pstHeap
+                IN PF_PREDICATE pfPredicate, callback function to test item
+                IN VOID *pvCtx, given to pfPredicate
+                IN PF_FREE pfOnRemoved, called with each item removed
+       Output:  OUT Heap_S *pstHeap
+       Return:  UINT, how many items removed
+      Caution:  pfPredicate should not be NULL, pfOnRemoved can be NULL. The
+                items kept are packed in front in one pass and the heap is
+                rebuilt once, costs O(n) however many are removed, while a
+                HeapRemoveItem for each costs O(n) for every item. pfOnRemoved
+                is called after the heap is rebuilt, neither callback should
+                change the heap. The handles of the items removed are freed
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT HeapRemoveIf(INOUT Heap_S *pstHeap, IN PF_PREDICATE pfPredicate,
+                  IN VOID *pvCtx, IN PF_FREE pfOnRemoved);
+
+/*******************************************************************************
+    Func Name:  HeapSort
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Sort an array of items in ascending order
+        Input:  IN VOID **ppvItems, items to be sorted
+                IN UINT uiNum, how many items in ppvItems
+                IN PF_COMPARE pfCompare, callback function to compare two items
+       Output:  OUT VOID **ppvItems, items sorted
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, nothing is changed
+      Caution:  No item in ppvItems can be NULL. It's heapsort in place, costs
+                O(n log n) at worst and allocates nothing, but it's not stable
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG HeapSort(INOUT VOID **ppvItems, IN UINT uiNum, IN PF_COMPARE pfCompare);
+
+/*******************************************************************************
+    Func Name:  HeapPartialSort
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Put the k minimal items of an array in its front in ascending
+                order
+        Input:  IN VOID **ppvItems, items to be sorted
+                IN UINT uiNum, how many items in ppvItems
+                IN UINT uiK, how many items to be sorted
+                IN PF_COMPARE pfCompare, callback function to compare two items
+       Output:  OUT VOID **ppvItems, the first k items are sorted, the others
+                                     are behind them in no order
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, nothing is changed
+      Caution:  No item in ppvItems can be NULL, the whole array is sorted if
+                uiK is not less than uiNum. Costs O(n log k), allocates nothing
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG HeapPartialSort(INOUT VOID **ppvItems, IN UINT uiNum, IN UINT uiK,
+                      IN PF_COMPARE pfCompare);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,192 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   heapdef.h
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   Generator of heaps specialized on item type and order.
+      Others:   HEAP_DEFINE(Name, T, LESS) stamps out a binary heap storing
+                items of type T by value, ordered by the macro or function
+                LESS, which is inlined at each compare instead of called by
+                a PF_COMPARE pointer, and no item is reached through a
+                pointer. The root is the least item by LESS, a max heap is
+                made by a LESS returning whether a is greater. Include
+                stdlib.h, type.h and err.h before this file
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+#ifndef _HEAPDEF_H_
+#define _HEAPDEF_H_
+
+/*******************************************************************************
+    Func Name:  HEAP_DEFINE
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Define a heap of items of type T ordered by LESS
+        Input:  Name, prefix of the type and the functions defined
+                T, type of item
+                LESS, LESS(a, b) is true if item a should be above item b,
+                      a and b are lvalues of type T
+       Output:  NONE
+       Return:  NONE
+      Caution:  Defines the type Name_S and the functions below, which work
+                like the Heap functions of the same names:
+                Name_S* NameCreate(IN UINT uiSize)
+                VOID NameFree(IN Name_S *pstHeap)
+                ULONG NameAdd(INOUT Name_S *pstHeap, IN T tItem)
+                ULONG NameGetRoot(IN Name_S *pstHeap, OUT T *ptItem)
+                ULONG NameRemoveRoot(INOUT Name_S *pstHeap, OUT T *ptItem)
+                UINT NameNumber(IN Name_S *pstHeap)
+                The items are copied in and out. A heap holds uiSize items at
+                most, an add fails when it's full. The getters fail when the
+                heap is empty. Use it at file scope, once for each Name
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+#define HEAP_DEFINE(Name, T, LESS) \
+\
+typedef struct tag##Name##_S \
+{ \
+    T *ptItem; \
+    UINT uiNum; \
+    UINT uiSize; \
+}Name##_S; \
+\
+static inline Name##_S* Name##Create(IN UINT uiSize) \
+{ \
+    Name##_S *pstHeap = NULL; \
+\
+    if (0 == uiSize) \
+    { \
+        return NULL; \
+    } \
+\
+    pstHeap = (Name##_S *)malloc(sizeof(Name##_S)); \
+    if (NULL == pstHeap) \
+    { \
+        return NULL; \
+    } \
+\
+    pstHeap->ptItem = (T *)malloc(sizeof(T) * uiSize); \
+    if (NULL == pstHeap->ptItem) \
+    { \
+        free(pstHeap); \
+        return NULL; \
+    } \
+    pstHeap->uiNum = 0; \
+    pstHeap->uiSize = uiSize; \
+\
+    return pstHeap; \
+} \
+\
+static inline VOID Name##Free(IN Name##_S *pstHeap) \
+{ \
+    if (NULL == pstHeap) \
+    { \
+        return; \
+    } \
+\
+    free(pstHeap->ptItem); \
+    free(pstHeap); \
+\
+    return; \
+} \
+\
+/**the hole climbs until its parent is not behind the item**/ \
+static inline ULONG Name##Add(INOUT Name##_S *pstHeap, IN T tItem) \
+{ \
+    UINT uiHole = 0; \
+    UINT uiParent = 0; \
+\
+    if (NULL == pstHeap || pstHeap->uiNum >= pstHeap->uiSize) \
+    { \
+        return ERROR_FAILED; \
+    } \
+\
+    uiHole = pstHeap->uiNum++; \
+    while (uiHole > 0) \
+    { \
+        uiParent = (uiHole - 1) >> 1; \
+        if (!(LESS(tItem, pstHeap->ptItem[uiParent]))) \
+        { \
+            break; \
+        } \
+        pstHeap->ptItem[uiHole] = pstHeap->ptItem[uiParent]; \
+        uiHole = uiParent; \
+    } \
+    pstHeap->ptItem[uiHole] = tItem; \
+\
+    return ERROR_SUCCESS; \
+} \
+\
+static inline ULONG Name##GetRoot(IN Name##_S *pstHeap, OUT T *ptItem) \
+{ \
+    if (NULL == pstHeap || NULL == ptItem || 0 == pstHeap->uiNum) \
+    { \
+        return ERROR_FAILED; \
+    } \
+\
+    *ptItem = pstHeap->ptItem[0]; \
+\
+    return ERROR_SUCCESS; \
+} \
+\
+/**the hole left by the root goes down until the tail item fits in it**/ \
+static inline ULONG Name##RemoveRoot(INOUT Name##_S *pstHeap, OUT T *ptItem) \
+{ \
+    T *ptBase = NULL; \
+    UINT uiHole = 0; \
+    UINT uiChild = 0; \
+    UINT uiNum = 0; \
+\
+    if (NULL == pstHeap || NULL == ptItem || 0 == pstHeap->uiNum) \
+    { \
+        return ERROR_FAILED; \
+    } \
+\
+    ptBase = pstHeap->ptItem; \
+    *ptItem = ptBase[0]; \
+    uiNum = --pstHeap->uiNum; \
+    if (0 == uiNum) \
+    { \
+        return ERROR_SUCCESS; \
+    } \
+\
+    uiChild = 1; \
+    while (uiChild < uiNum) \
+    { \
+        if (uiChild + 1 < uiNum && LESS(ptBase[uiChild + 1], ptBase[uiChild])) \
+        { \
+            uiChild++; \
+        } \
+        if (!(LESS(ptBase[uiChild], ptBase[uiNum]))) \
+        { \
+            break; \
+        } \
+        ptBase[uiHole] = ptBase[uiChild]; \
+        uiHole = uiChild; \
+        uiChild = (uiHole << 1) + 1; \
+    } \
+    ptBase[uiHole] = ptBase[uiNum]; \
+\
+    return ERROR_SUCCESS; \
+} \
+\
+static inline UINT Name##Number(IN Name##_S *pstHeap) \
+{ \
+    if (NULL == pstHeap) \
+    { \
+        return 0; \
+    } \
+\
+    return pstHeap->uiNum; \
+}
+
+#endif
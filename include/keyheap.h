@@ -0,0 +1,176 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   keyheap.h
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   Interface of heap with inline 64-bit keys.
+      Others:   The keys are compared inline instead of by a callback, and
+                kept in an array apart from the items, so sifting streams
+                through contiguous keys without touching the items
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+#ifndef _KEYHEAP_H_
+#define _KEYHEAP_H_
+
+#define KEYHEAP_MINI     0
+#define KEYHEAP_MAXI     1
+#define KEYHEAP_UPSPACE  2
+
+typedef struct tagKeyHeap_S
+{
+    UINT uiSize;
+    UINT uiNum;
+    UINT uiType;
+    UINT64 ullMask;           /*keys are stored xor-ed by it, all ones for max heap*/
+    UINT64 *pullBase;         /*memery of keys, the root is not the first*/
+    UINT64 *pullKey;          /*key of the item in each place*/
+    VOID **ppvItem;           /*item in each place*/
+    PF_PRINT pfPrint;
+    PF_FREE pfFree;
+}KeyHeap_S;
+
+/*******************************************************************************
+    Func Name:  KeyHeapCreate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a heap of items with 64-bit keys
+        Input:  IN UINT uiSize, how many items the heap can store.
+                IN UINT uiType, KEYHEAP_MINI for minimal heap, KEYHEAP_MAXI
+                                for maximum heap
+                IN PF_PRINT pfPrint, callback function to print item
+                IN PF_FREE pfFree, callback function to free item
+       Output:  NONE
+       Return:  KeyHeap_S*,  the heap struct
+                NULL,        error occured
+      Caution:  pfPrint can be NULL
+                pfFree can be NULL if you don't want your data to be freed when
+                deleting the heap
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+KeyHeap_S* KeyHeapCreate(IN UINT uiSize, IN UINT uiType,
+                         IN PF_PRINT pfPrint,
+                         IN PF_FREE pfFree);
+
+/*******************************************************************************
+    Func Name:  KeyHeapFree
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To free a given heap
+        Input:  IN KeyHeap_S *pstHeap, the heap to be freed
+       Output:  NONE
+       Return:  NONE
+      Caution:  If you have installed PF_FREE callback function, then all the
+                itmes in the heap will be freed, otherwise it's the user's
+                responsibility to free the memeries of all items
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID KeyHeapFree(IN KeyHeap_S *pstHeap);
+
+/*******************************************************************************
+    Func Name:  KeyHeapAdd
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add an item with its key to heap
+        Input:  IN KeyHeap_S *pstHeap
+                IN UINT64 ullKey, key of the item
+                IN VOID *pvItem, item to be added
+       Output:  OUT KeyHeap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed
+      Caution:  pvItem should not be NULL, costs O(log n)
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG KeyHeapAdd(INOUT KeyHeap_S *pstHeap, IN UINT64 ullKey, IN VOID *pvItem);
+
+/*******************************************************************************
+    Func Name:  KeyHeapGetRoot
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  look for the root item of heap
+        Input:  IN KeyHeap_S *pstHeap
+       Output:  OUT UINT64 *pullKey, key of the root item
+       Return:  VOID*, the root item
+                NULL, the heap is empty
+      Caution:  pullKey can be NULL if the key is not wanted
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* KeyHeapGetRoot(IN KeyHeap_S *pstHeap, OUT UINT64 *pullKey);
+
+/*******************************************************************************
+    Func Name:  KeyHeapRemoveRoot
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  remove the root item from heap
+        Input:  IN KeyHeap_S *pstHeap
+       Output:  OUT UINT64 *pullKey, key of the root item
+       Return:  VOID*, the item removed out
+                NULL, failed, the heap is empty
+      Caution:  pullKey can be NULL if the key is not wanted, costs O(log n).
+                The function only removes items from heap, but the memery is
+                left to users to free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* KeyHeapRemoveRoot(INOUT KeyHeap_S *pstHeap, OUT UINT64 *pullKey);
+
+/*******************************************************************************
+    Func Name:  KeyHeapPrint
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  print all items in heap
+        Input:  IN KeyHeap_S *pstHeap
+       Output:  NONE
+       Return:  NONE
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID KeyHeapPrint(IN KeyHeap_S *pstHeap);
+
+/*******************************************************************************
+    Func Name:  KeyHeapNumber
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many items in heap
+        Input:  IN KeyHeap_S *pstHeap
+       Output:  NONE
+       Return:  UINT
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT KeyHeapNumber(IN KeyHeap_S *pstHeap);
+
+#endif
@@ -16,6 +16,9 @@ Copyright(C):   Huazhong University of Science & Technology.
 #ifndef _LENGTH_H_
 #define _LENGTH_H_
 
-
+/**CACHE_LINE**/
+#ifndef CACHE_LINE
+#define CACHE_LINE  64
+#endif
 
 #endif
\ No newline at end of file
@@ -0,0 +1,223 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   lfstack.h
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   Interface of lock-free stack, shared by threads.
+      Others:   A Treiber stack. The nodes are taken from a pool made at
+                create, and a popped node goes back to the free list of the
+                pool, which is a Treiber stack too, so no node is ever freed
+                while another thread may still read it. Each head is a 64 bit
+                word of a tag and a node place, the tag is bumped by every
+                change, so a single width CAS fails if the head has been
+                popped and pushed back between the read and the CAS (ABA).
+                With elimination set, a push or a pop that loses the CAS of
+                the top goes to a random slot of a side array instead, where
+                a push waits a moment for a pop to take its item, so the two
+                cancel out without touching the top (Hendler et al., A
+                Scalable Lock-free Stack Algorithm, SPAA 2004). Include
+                stdlib.h, type.h and length.h before this file
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+#ifndef _LFSTACK_H_
+#define _LFSTACK_H_
+
+typedef struct tagLFStackNode_S
+{
+    VOID *pvItem;
+    UINT uiNext;              /*place + 1 of the node below, 0 for none*/
+}LFStackNode_S;
+
+/**a slot of the elimination array, see LFStackSetEliminate**/
+typedef struct tagLFStackSlot_S
+{
+    UINT64 ullOffer;          /*tag << 32 | place + 1 of the node offered*/
+    CHAR acPad[CACHE_LINE - sizeof(UINT64)];  /*a slot a line*/
+}LFStackSlot_S;
+
+typedef struct tagLFStack_S
+{
+    UINT64 ullTop;            /*tag << 32 | place + 1 of the top node*/
+    CHAR acPad1[CACHE_LINE - sizeof(UINT64)];  /*a head a line*/
+    UINT64 ullFree;           /*the same of the top free node*/
+    CHAR acPad2[CACHE_LINE - sizeof(UINT64)];
+    UINT uiNum;
+    CHAR acPad3[CACHE_LINE - sizeof(UINT)];
+    UINT uiSize;
+    LFStackNode_S *pstNode;   /*the pool*/
+    PF_PRINT pfPrint;
+    PF_FREE pfFree;
+    LFStackSlot_S *pstSlot;   /*the elimination array, NULL if not set*/
+    UINT uiSlots;
+}LFStack_S;
+
+/*******************************************************************************
+    Func Name:  LFStackCreate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a lock-free stack
+        Input:  IN UINT uiSize, how many items the stack can store
+                IN PF_PRINT pfPrint, callback function to print item
+                IN PF_FREE pfFree, callback function to free item
+       Output:  NONE
+       Return:  LFStack_S*,  the stack struct
+                NULL,        error occured
+      Caution:  uiSize should not be 0. The stack never grows, all its nodes
+                are allocated here. pfPrint and pfFree can be NULL. Create
+                and free the stack when no other thread is using it
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+LFStack_S* LFStackCreate(IN UINT uiSize, IN PF_PRINT pfPrint,
+                         IN PF_FREE pfFree);
+
+/*******************************************************************************
+    Func Name:  LFStackSetEliminate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Set the elimination array of a given stack
+        Input:  IN LFStack_S *pstStack
+                IN UINT uiSlots, slots of the array, 0 for no elimination
+       Output:  OUT LFStack_S *pstStack
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, the stack is left as it was
+      Caution:  Call it when no other thread is using the stack. About half
+                the threads is a good choice of uiSlots, less slots make a
+                push and a pop meet more likely, more slots make them fight
+                less for a slot. It only pays under contention, a push that
+                wins the CAS never waits in a slot
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG LFStackSetEliminate(INOUT LFStack_S *pstStack, IN UINT uiSlots);
+
+/*******************************************************************************
+    Func Name:  LFStackFree
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To free a given stack
+        Input:  IN LFStack_S *pstStack, the stack to be freed
+       Output:  NONE
+       Return:  NONE
+      Caution:  If you have installed PF_FREE callback function, then all the
+                itmes in the stack will be freed, otherwise it's the user's
+                responsibility to free the memeries of all items
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID LFStackFree(IN LFStack_S *pstStack);
+
+/*******************************************************************************
+    Func Name:  LFStackPush
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Push an item onto stack
+        Input:  IN LFStack_S *pstStack
+                IN VOID *pvItem, the item to be pushed
+       Output:  OUT LFStack_S *pstStack
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, or the stack is full
+      Caution:  Thread safe. pvItem should not be NULL. A CAS is retried only
+                when another thread has changed the same head meanwhile. With
+                elimination set, a push may end by a pop taking its item in
+                the elimination array, it's never on the top then
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG LFStackPush(INOUT LFStack_S *pstStack, IN VOID *pvItem);
+
+/*******************************************************************************
+    Func Name:  LFStackPop
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Pop the top item of stack
+        Input:  IN LFStack_S *pstStack
+       Output:  OUT LFStack_S *pstStack
+       Return:  VOID*, the item popped
+                NULL, the stack is empty
+      Caution:  Thread safe. With elimination set, the item may be taken from
+                a push in the elimination array instead of the top
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* LFStackPop(INOUT LFStack_S *pstStack);
+
+/*******************************************************************************
+    Func Name:  LFStackPeek
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Look for the top item of stack without popping it
+        Input:  IN LFStack_S *pstStack
+       Output:  NONE
+       Return:  VOID*, the top item
+                NULL, the stack is empty
+      Caution:  Thread safe. The item was on the top at some moment during the
+                call, another thread may have popped it when it's returned
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* LFStackPeek(IN LFStack_S *pstStack);
+
+/*******************************************************************************
+    Func Name:  LFStackPrint
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Print all items in stack from top to bottom
+        Input:  IN LFStack_S *pstStack
+       Output:  NONE
+       Return:  NONE
+      Caution:  Not thread safe, call it when no other thread is changing the
+                stack
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID LFStackPrint(IN LFStack_S *pstStack);
+
+/*******************************************************************************
+    Func Name:  LFStackNumber
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many items in stack
+        Input:  IN LFStack_S *pstStack
+       Output:  NONE
+       Return:  UINT
+      Caution:  Thread safe, but the count may be behind a push or a pop still
+                going on in another thread
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT LFStackNumber(IN LFStack_S *pstStack);
+
+#endif
@@ -0,0 +1,180 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   losertree.h
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   Interface of k-way merge by loser tree.
+      Others:   Each of the k sorted streams is a leaf of the tree, each inner
+                node keeps the loser of the match below it, and the winner of
+                all is kept apart. After the winner is pulled out, the next
+                item of its stream replays the matches on the path up to the
+                top, costs log2(k) compares, while a heap costs about twice
+                as many for the same output
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+#ifndef _LOSERTREE_H_
+#define _LOSERTREE_H_
+
+/*******************************************************************************
+    Func Name:  PF_NEXT
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Callback function to read the next item of a stream.
+        Input:  IN VOID *pvStream, the stream given to LoserTreeCreate
+       Output:  NONE
+       Return:  VOID*, the next item
+                NULL, the stream runs out
+      Caution:  The items of a stream should be in ascending order by the
+                compare function. It's not called again for a stream after it
+                returns NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+typedef VOID* (*PF_NEXT)(IN VOID *pvStream);
+
+/**a player of the tree, the head item of a stream**/
+typedef struct tagLoserNode_S
+{
+    VOID *pvItem;             /*NULL if the stream runs out*/
+    UINT uiWay;               /*which stream*/
+}LoserNode_S;
+
+typedef struct tagLoserTree_S
+{
+    UINT uiWays;              /*how many streams*/
+    UINT uiLive;              /*streams not run out*/
+    LoserNode_S *pstNode;     /*loser of each inner node, the winner in 0*/
+    VOID **ppvStream;
+    PF_NEXT pfNext;
+    PF_COMPARE pfCompare;
+}LoserTree_S;
+
+/*******************************************************************************
+    Func Name:  LoserTreeCreate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a loser tree merging some sorted streams
+        Input:  IN VOID **ppvStreams, the streams to be merged
+                IN UINT uiWays, how many streams in ppvStreams
+                IN PF_NEXT pfNext, callback function to read a stream
+                IN PF_COMPARE pfCompare, callback function to compare two items
+       Output:  NONE
+       Return:  LoserTree_S*, the loser tree struct
+                NULL,         error occured
+      Caution:  uiWays should not be 0, pfNext and pfCompare should not be
+                NULL. The first item of every stream is read here, costs
+                O(k). The streams are not freed with the tree
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+LoserTree_S* LoserTreeCreate(IN VOID **ppvStreams, IN UINT uiWays,
+                             IN PF_NEXT pfNext,
+                             IN PF_COMPARE pfCompare);
+
+/*******************************************************************************
+    Func Name:  LoserTreeFree
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To free a given loser tree
+        Input:  IN LoserTree_S *pstTree, the loser tree to be freed
+       Output:  NONE
+       Return:  NONE
+      Caution:  The items not pulled out yet are left in their streams, except
+                the head item read from each stream
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID LoserTreeFree(IN LoserTree_S *pstTree);
+
+/*******************************************************************************
+    Func Name:  LoserTreeNext
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Pull out the least item of all streams
+        Input:  IN LoserTree_S *pstTree
+       Output:  OUT LoserTree_S *pstTree
+       Return:  VOID*, the item pulled out
+                NULL, all streams run out
+      Caution:  costs log2(k) compares and one PF_NEXT call. Equal items come
+                out in the order of their streams, so the merge is stable
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* LoserTreeNext(INOUT LoserTree_S *pstTree);
+
+/*******************************************************************************
+    Func Name:  LoserTreeNextN
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Pull out at most n least items of all streams
+        Input:  IN LoserTree_S *pstTree
+                IN UINT uiNum, how many items to pull out at most
+       Output:  OUT LoserTree_S *pstTree
+                OUT VOID **ppvItems, items pulled out, in ascending order
+       Return:  UINT, how many items pulled out, less than uiNum if all
+                      streams run out
+      Caution:  ppvItems should hold uiNum items. It's the same as uiNum
+                LoserTreeNext calls, but without a call for each item
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT LoserTreeNextN(INOUT LoserTree_S *pstTree, IN UINT uiNum,
+                    OUT VOID **ppvItems);
+
+/*******************************************************************************
+    Func Name:  LoserTreePeek
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Look for the least item of all streams without pulling it out
+        Input:  IN LoserTree_S *pstTree
+       Output:  NONE
+       Return:  VOID*, the least item
+                NULL, all streams run out
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* LoserTreePeek(IN LoserTree_S *pstTree);
+
+/*******************************************************************************
+    Func Name:  LoserTreeLive
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many streams have not run out
+        Input:  IN LoserTree_S *pstTree
+       Output:  NONE
+       Return:  UINT
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT LoserTreeLive(IN LoserTree_S *pstTree);
+
+#endif
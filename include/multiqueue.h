@@ -0,0 +1,150 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   multiqueue.h
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   Interface of multiqueue, a relaxed concurrent priority queue.
+      Others:   Items are spread over m heaps, each guarded by a try-lock. An
+                add goes to a random heap, a remove takes the prior root of
+                two random heaps. The root removed is not always the prior
+                most one of all items, its rank is O(m) in expectation and
+                O(m log m) with high probability (Alistarh et al., The Power
+                of Choice in Priority Scheduling, PODC 2017). m = 2 to 4 times
+                the threads is a good choice, less heaps make less rank error
+                but more contention
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+#ifndef _MULTIQUEUE_H_
+#define _MULTIQUEUE_H_
+
+typedef struct tagMultiQueueSlot_S
+{
+    Heap_S *pstHeap;
+    UINT uiLock;              /*0 if free, 1 if taken*/
+    CHAR acPad[CACHE_LINE - sizeof(Heap_S *) - sizeof(UINT)];  /*a slot a line*/
+}MultiQueueSlot_S;
+
+typedef struct tagMultiQueue_S
+{
+    UINT uiHeaps;
+    UINT uiType;
+    MultiQueueSlot_S *pstSlot;
+}MultiQueue_S;
+
+/*******************************************************************************
+    Func Name:  MultiQueueCreate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a multiqueue
+        Input:  IN UINT uiHeaps, how many heaps the items are spread over
+                IN UINT uiSize, how many items a heap can store at first
+                IN UINT uiType, HEAP_MINI for minimal heap, HEAP_MAXI for
+                                maximum heap
+                IN PF_COMPARE pfCompare, callback function to compare two items
+                IN PF_PRINT pfPrint, callback function to print item
+                IN PF_FREE pfFree, callback function to free item
+       Output:  NONE
+       Return:  MultiQueue_S*,  the multiqueue struct
+                NULL,           error occured
+      Caution:  uiHeaps should not be less than 2. The heaps grow when they are
+                full, see HeapSetGrow. pfCompare should not be NULL, pfPrint
+                and pfFree can be NULL. Create and free the multiqueue when no
+                other thread is using it
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+MultiQueue_S* MultiQueueCreate(IN UINT uiHeaps, IN UINT uiSize, IN UINT uiType,
+                               IN PF_COMPARE pfCompare,
+                               IN PF_PRINT pfPrint,
+                               IN PF_FREE pfFree);
+
+/*******************************************************************************
+    Func Name:  MultiQueueFree
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To free a given multiqueue
+        Input:  IN MultiQueue_S *pstQueue, the multiqueue to be freed
+       Output:  NONE
+       Return:  NONE
+      Caution:  If you have installed PF_FREE callback function, then all the
+                itmes in the multiqueue will be freed, otherwise it's the
+                user's responsibility to free the memeries of all items
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID MultiQueueFree(IN MultiQueue_S *pstQueue);
+
+/*******************************************************************************
+    Func Name:  MultiQueueAdd
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add an item to a random heap of multiqueue
+        Input:  IN MultiQueue_S *pstQueue
+                IN VOID *pvItem, item to be added
+       Output:  OUT MultiQueue_S *pstQueue
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed
+      Caution:  pvItem should not be NULL. It's thread safe, a heap taken by
+                another thread is skipped instead of waited for
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG MultiQueueAdd(INOUT MultiQueue_S *pstQueue, IN VOID *pvItem);
+
+/*******************************************************************************
+    Func Name:  MultiQueueRemoveRoot
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Remove the prior root of two random heaps of multiqueue
+        Input:  IN MultiQueue_S *pstQueue
+       Output:  OUT MultiQueue_S *pstQueue
+       Return:  VOID*, the item removed out
+                NULL, the multiqueue is empty
+      Caution:  It's thread safe. The two heaps are both locked to compare
+                their roots, for a root read without lock may be removed and
+                freed by another thread. If random picks keep finding empty
+                heaps, all heaps are looked through before NULL is returned.
+                The memery of the item is left to users to free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* MultiQueueRemoveRoot(INOUT MultiQueue_S *pstQueue);
+
+/*******************************************************************************
+    Func Name:  MultiQueueNumber
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many items in multiqueue
+        Input:  IN MultiQueue_S *pstQueue
+       Output:  NONE
+       Return:  UINT
+      Caution:  Each heap is counted under its lock, the total is not exact if
+                other threads are changing the multiqueue
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT MultiQueueNumber(IN MultiQueue_S *pstQueue);
+
+#endif
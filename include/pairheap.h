@@ -0,0 +1,202 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   pairheap.h
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   Interface of pairing heap.
+      Others:   Two pairing heaps can be merged in O(1)
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+#ifndef _PAIRHEAP_H_
+#define _PAIRHEAP_H_
+
+#define PAIRHEAP_MINI     0
+#define PAIRHEAP_MAXI     1
+#define PAIRHEAP_UPSPACE  2
+
+typedef struct tagPairNode_S
+{
+    struct tagPairNode_S *pstChild;     /*the first child*/
+    struct tagPairNode_S *pstSibling;   /*the next child of the same parent*/
+    VOID *pvItem;
+}PairNode_S;
+
+typedef struct tagPairHeap_S
+{
+    PairNode_S *pstRoot;
+    UINT uiNum;
+    UINT uiType;
+    PF_COMPARE pfCompare;
+    PF_PRINT pfPrint;
+    PF_FREE pfFree;
+}PairHeap_S;
+
+/*******************************************************************************
+    Func Name:  PairHeapCreate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a pairing heap
+        Input:  IN UINT uiType, PAIRHEAP_MINI for minimal heap, PAIRHEAP_MAXI
+                                for maximum heap
+                IN PF_COMPARE pfCompare, callback function to compare two items
+                IN PF_PRINT pfPrint, callback function to print item
+                IN PF_FREE pfFree, callback function to free item
+       Output:  NONE
+       Return:  PairHeap_S*,  the heap struct
+                NULL,         error occured
+      Caution:  pfCompare should not be NULL,
+                pfPrint can be NULL
+                pfFree can be NULL if you don't want your data to be freed when
+                deleting the heap
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+PairHeap_S* PairHeapCreate(IN UINT uiType,
+                           IN PF_COMPARE pfCompare,
+                           IN PF_PRINT pfPrint,
+                           IN PF_FREE pfFree);
+
+/*******************************************************************************
+    Func Name:  PairHeapFree
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To free a given heap
+        Input:  IN PairHeap_S *pstHeap, the heap to be freed
+       Output:  NONE
+       Return:  NONE
+      Caution:  If you have installed PF_FREE callback function, then all the
+                itmes in the heap will be freed, otherwise it's the user's
+                responsibility to free the memeries of all items
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID PairHeapFree(IN PairHeap_S *pstHeap);
+
+/*******************************************************************************
+    Func Name:  PairHeapAdd
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add an item to heap
+        Input:  IN PairHeap_S *pstHeap
+                IN VOID *pvItem, item to be added
+       Output:  OUT PairHeap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed
+      Caution:  pvItem should not be NULL, costs O(1)
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG PairHeapAdd(INOUT PairHeap_S *pstHeap, IN VOID *pvItem);
+
+/*******************************************************************************
+    Func Name:  PairHeapMerge
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Move all items of a heap into another one
+        Input:  IN PairHeap_S *pstHeap, the heap to merge into
+                IN PairHeap_S *pstOther, the heap to be merged
+       Output:  OUT PairHeap_S *pstHeap
+                OUT PairHeap_S *pstOther, it's empty then
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, the heaps are of different types or
+                                compare functions
+      Caution:  costs O(1), no item is compared but the two roots. pstOther is
+                left empty but not freed
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG PairHeapMerge(INOUT PairHeap_S *pstHeap, INOUT PairHeap_S *pstOther);
+
+/*******************************************************************************
+    Func Name:  PairHeapGetRoot
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  look for the root item of heap
+        Input:  IN PairHeap_S *pstHeap
+       Output:  NONE
+       Return:  VOID*, the root item
+                NULL, the heap is empty
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* PairHeapGetRoot(IN PairHeap_S *pstHeap);
+
+/*******************************************************************************
+    Func Name:  PairHeapRemoveRoot
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  remove the root item from heap
+        Input:  IN PairHeap_S *pstHeap
+       Output:  NONE
+       Return:  VOID*, the item removed out
+                NULL, failed, the heap is empty
+      Caution:  amortized costs O(log n). The function only removes items from
+                heap, but the memery is left to users to free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* PairHeapRemoveRoot(INOUT PairHeap_S *pstHeap);
+
+/*******************************************************************************
+    Func Name:  PairHeapPrint
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  print all items in heap
+        Input:  IN PairHeap_S *pstHeap
+       Output:  NONE
+       Return:  NONE
+      Caution:  the root first, then each item before its children and its
+                younger siblings
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID PairHeapPrint(IN PairHeap_S *pstHeap);
+
+/*******************************************************************************
+    Func Name:  PairHeapNumber
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many items in heap
+        Input:  IN PairHeap_S *pstHeap
+       Output:  NONE
+       Return:  UINT
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT PairHeapNumber(IN PairHeap_S *pstHeap);
+
+#endif
@@ -24,6 +24,18 @@ typedef struct tagQueue_S
     VOID **ppvTail;
     PF_PRINT pfPrint;
     PF_FREE pfFree;
+    BOOL_T bGrow;             /*grow automatically, see QueueSetGrow*/
+    UINT uiShrink;
+    UINT uiMinSize;
+    UINT uiNextSize;          /*the memery being moved to when growing or shrinking*/
+    VOID **ppvNext;
+    VOID **ppvMove;           /*the next item to be moved*/
+    UINT uiMoved;             /*where to put the next item to be moved*/
+    UINT uiNextHead;          /*where the head is in the next memery*/
+    UINT uiElemSize;          /*bytes of a record, value queue only*/
+    CHAR *pcValue;            /*records of value queue, a ring of uiSize*/
+    UINT uiValueHead;         /*place of the first record*/
+    UINT uiValues;            /*records in value queue*/
 }Queue_S;
 
 /*******************************************************************************
@@ -48,6 +60,60 @@ typedef struct tagQueue_S
 *******************************************************************************/
 Queue_S* QueueCreate(IN UINT uiSize, PF_PRINT pfPrint, IN PF_FREE pfFree);
 
+/*******************************************************************************
+    Func Name:  QueueCreateValue
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a queue storing records by value
+        Input:  IN UINT uiSize, how many records the queue can store.
+                IN UINT uiElemSize, bytes of a record
+                IN PF_PRINT pfPrint, callback function to print record
+                IN PF_FREE pfFree, callback function to free what a record
+                                   refers to
+       Output:  NONE
+       Return:  Queue_S*,  the queue struct
+                NULL,     error occured
+      Caution:  QueueAdd copies uiElemSize bytes from the item into the slot at
+                the tail, so no memery is allocated for a record.
+                QueueGetFirst returns the slot, and QueueRemoveFirst the slot
+                it leaves, which keeps the record till the next add. The
+                callbacks get the slot, pfFree should not free it. The queue
+                never grows, QueueSetGrow fails on it, and so do QueueAddN and
+                QueueRemoveN
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+Queue_S* QueueCreateValue(IN UINT uiSize, IN UINT uiElemSize,
+                          IN PF_PRINT pfPrint, IN PF_FREE pfFree);
+
+/*******************************************************************************
+    Func Name:  QueueSetGrow
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Make a queue grow automatically instead of being full
+        Input:  IN Queue_S *pstQueue
+                IN UINT uiShrink, shrink the queue to half if less than 
+                                  1/uiShrink of it is used, 0 for never
+       Output:  OUT Queue_S *pstQueue
+       Return:  ULONG
+                ERROR_SUCCESS, success
+                ERROR_FAILED, failed
+      Caution:  uiShrink should be 0 or not less than 4. The queue doubles when
+                it is 3/4 full, and never shrinks below the size it's created 
+                with. The items are copied to the new memery a few a time by
+                every add and remove, so no one of them stalls for copying the
+                whole queue
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+ULONG QueueSetGrow(INOUT Queue_S *pstQueue, IN UINT uiShrink);
+
 /*******************************************************************************
     Func Name:  QueueFree
  Date Created:  2014-9-19
@@ -87,6 +153,32 @@ VOID QueueFree(IN Queue_S *pstQueue);
 *******************************************************************************/
 ULONG QueueAdd(IN Queue_S *pstQueue, IN VOID *pvItem);
 
+/*******************************************************************************
+    Func Name:  QueueAddN
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add some items into queue at once
+        Input:  IN Queue_S *pstQueue
+                IN VOID **ppvItems, items to be added, the first one first
+                IN UINT uiNum, how many items in ppvItems
+       Output:  OUT Queue_S *pstQueue
+       Return:  UINT, how many items added, less than uiNum if the
+                      queue is full
+      Caution:  Items in ppvItems should not be NULL, they're not checked one by
+                one. The room is checked once and the items are copied by two
+                memcpy at most, one to the end of memery and one from its
+                start. A growing queue moves on as many steps as adding the
+                items one by one would. Only if they can't fit, it finishes
+                moving and doubles at once till they fit in 3/4 of it. It
+                fails on value queue
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT QueueAddN(INOUT Queue_S *pstQueue, IN VOID **ppvItems, IN UINT uiNum);
+
 /*******************************************************************************
     Func Name:  QueueRemoveFirst
  Date Created:  2014-9-19
@@ -106,6 +198,29 @@ ULONG QueueAdd(IN Queue_S *pstQueue, IN VOID *pvItem);
 *******************************************************************************/
 VOID* QueueRemoveFirst(IN Queue_S *pstQueue);
 
+/*******************************************************************************
+    Func Name:  QueueRemoveN
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Remove some first items in queue at once
+        Input:  IN Queue_S *pstQueue
+                IN UINT uiNum, how many items to remove at most
+       Output:  OUT Queue_S *pstQueue
+                OUT VOID **ppvItems, items removed, the first one first
+       Return:  UINT, how many items removed, less than uiNum if the
+                      queue runs out
+      Caution:  ppvItems should hold uiNum items. The items are copied by two
+                memcpy at most, the memery of items is left to users to free.
+                It fails on value queue
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT QueueRemoveN(INOUT Queue_S *pstQueue, IN UINT uiNum,
+                  OUT VOID **ppvItems);
+
 /*******************************************************************************
     Func Name:  QueueGetFirst
  Date Created:  2014-9-19
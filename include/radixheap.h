@@ -0,0 +1,180 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   radixheap.h
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   Interface of monotone radix heap.
+      Others:   The keys removed never decrease, then an item is put in the
+                bucket of the highest bit where its key differs from the last
+                removed one, and no key is compared by callback
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+#ifndef _RADIXHEAP_H_
+#define _RADIXHEAP_H_
+
+#define RADIXHEAP_BUCKETS  65       /*bucket 0 for the last key, i for bit i-1*/
+
+typedef struct tagRadixHeap_S
+{
+    UINT uiSize;
+    UINT uiNum;
+    UINT64 ullLast;           /*the last removed key, no key can be less*/
+    UINT64 ullUsed;           /*bit i-1 is set if bucket i is not empty*/
+    UINT auiBucket[RADIXHEAP_BUCKETS];  /*first node of each bucket*/
+    UINT uiFree;              /*first free node*/
+    UINT64 *pullKey;          /*key of each node*/
+    VOID **ppvItem;           /*item of each node*/
+    UINT *puiNext;            /*next node in the same bucket or free list*/
+    PF_PRINT pfPrint;
+    PF_FREE pfFree;
+}RadixHeap_S;
+
+/*******************************************************************************
+    Func Name:  RadixHeapCreate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a monotone radix heap
+        Input:  IN UINT uiSize, how many items the heap can store.
+                IN PF_PRINT pfPrint, callback function to print item
+                IN PF_FREE pfFree, callback function to free item
+       Output:  NONE
+       Return:  RadixHeap_S*,  the heap struct
+                NULL,          error occured
+      Caution:  pfPrint can be NULL
+                pfFree can be NULL if you don't want your data to be freed when
+                deleting the heap
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+RadixHeap_S* RadixHeapCreate(IN UINT uiSize,
+                             IN PF_PRINT pfPrint,
+                             IN PF_FREE pfFree);
+
+/*******************************************************************************
+    Func Name:  RadixHeapFree
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To free a given heap
+        Input:  IN RadixHeap_S *pstHeap, the heap to be freed
+       Output:  NONE
+       Return:  NONE
+      Caution:  If you have installed PF_FREE callback function, then all the
+                itmes in the heap will be freed, otherwise it's the user's
+                responsibility to free the memeries of all items
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID RadixHeapFree(IN RadixHeap_S *pstHeap);
+
+/*******************************************************************************
+    Func Name:  RadixHeapAdd
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add an item with its key to heap
+        Input:  IN RadixHeap_S *pstHeap
+                IN UINT64 ullKey, key of the item
+                IN VOID *pvItem, item to be added
+       Output:  OUT RadixHeap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed
+      Caution:  pvItem should not be NULL, and ullKey should not be less than
+                the last removed key. Costs O(1)
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG RadixHeapAdd(INOUT RadixHeap_S *pstHeap, IN UINT64 ullKey,
+                   IN VOID *pvItem);
+
+/*******************************************************************************
+    Func Name:  RadixHeapGetRoot
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  look for the item of the minimal key in heap
+        Input:  IN RadixHeap_S *pstHeap
+       Output:  OUT UINT64 *pullKey, key of the item
+       Return:  VOID*, the item
+                NULL, the heap is empty
+      Caution:  pullKey can be NULL if the key is not wanted. The buckets may
+                be redistributed, and the key becomes the last removed one, so
+                no less key can be added after it
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* RadixHeapGetRoot(INOUT RadixHeap_S *pstHeap, OUT UINT64 *pullKey);
+
+/*******************************************************************************
+    Func Name:  RadixHeapRemoveRoot
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  remove the item of the minimal key from heap
+        Input:  IN RadixHeap_S *pstHeap
+       Output:  OUT UINT64 *pullKey, key of the item
+       Return:  VOID*, the item removed out
+                NULL, failed, the heap is empty
+      Caution:  pullKey can be NULL if the key is not wanted. Amortized costs
+                O(log C), C is the max difference between keys. The function
+                only removes items from heap, but the memery is left to users
+                to free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* RadixHeapRemoveRoot(INOUT RadixHeap_S *pstHeap, OUT UINT64 *pullKey);
+
+/*******************************************************************************
+    Func Name:  RadixHeapPrint
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  print all items in heap
+        Input:  IN RadixHeap_S *pstHeap
+       Output:  NONE
+       Return:  NONE
+      Caution:  bucket by bucket, the items of a bucket have keys less than
+                those of the buckets after it, but are not sorted in it
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID RadixHeapPrint(IN RadixHeap_S *pstHeap);
+
+/*******************************************************************************
+    Func Name:  RadixHeapNumber
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many items in heap
+        Input:  IN RadixHeap_S *pstHeap
+       Output:  NONE
+       Return:  UINT
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT RadixHeapNumber(IN RadixHeap_S *pstHeap);
+
+#endif
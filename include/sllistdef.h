@@ -0,0 +1,239 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   sllistdef.h
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   Generator of ordered singly linked lists specialized on item
+                type and order.
+      Others:   SLLIST_DEFINE(Name, T, LESS) stamps out an ordered singly
+                linked list, each node stores an item of type T by value, so
+                a compare reads the node itself instead of an item it points
+                to, and LESS is inlined instead of called by a PF_COMPARE
+                pointer. Include stdlib.h, type.h and err.h before this file
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+#ifndef _SLLISTDEF_H_
+#define _SLLISTDEF_H_
+
+/*******************************************************************************
+    Func Name:  SLLIST_DEFINE
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Define an ordered singly linked list of items of type T
+        Input:  Name, prefix of the types and the functions defined
+                T, type of item
+                LESS, LESS(a, b) is true if item a should be before item b,
+                      a and b are lvalues of type T
+       Output:  NONE
+       Return:  NONE
+      Caution:  Defines the types Name_S and NameNode_S and the functions
+                below, which work like the SLHead functions of the same names
+                on a LNKLST_MINORDER list:
+                Name_S* NameCreate(VOID)
+                VOID NameFree(IN Name_S *pstList)
+                ULONG NameAdd(INOUT Name_S *pstList, IN T tItem)
+                ULONG NameDelete(INOUT Name_S *pstList, IN T tKey,
+                                 OUT T *ptItem)
+                ULONG NameDelHead(INOUT Name_S *pstList, OUT T *ptItem)
+                ULONG NameGetFirst(IN Name_S *pstList, OUT T *ptItem)
+                ULONG NameGetItem(IN Name_S *pstList, IN T tKey,
+                                  OUT T *ptItem)
+                UINT NameNumber(IN Name_S *pstList)
+                An item is equal to the key if neither is less than the
+                other. An item added goes behind the equal ones. The lookups
+                stop at the first item behind the key. The getters fail if
+                no item is found. Use it at file scope, once for each Name
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+#define SLLIST_DEFINE(Name, T, LESS) \
+\
+typedef struct tag##Name##Node_S \
+{ \
+    struct tag##Name##Node_S *pstNext; \
+    T tItem; \
+}Name##Node_S; \
+\
+typedef struct tag##Name##_S \
+{ \
+    Name##Node_S *pstFirst; \
+    UINT uiNum; \
+}Name##_S; \
+\
+static inline Name##_S* Name##Create(VOID) \
+{ \
+    Name##_S *pstList = NULL; \
+\
+    pstList = (Name##_S *)malloc(sizeof(Name##_S)); \
+    if (NULL == pstList) \
+    { \
+        return NULL; \
+    } \
+    pstList->pstFirst = NULL; \
+    pstList->uiNum = 0; \
+\
+    return pstList; \
+} \
+\
+static inline VOID Name##Free(IN Name##_S *pstList) \
+{ \
+    Name##Node_S *pstNode = NULL; \
+    Name##Node_S *pstNext = NULL; \
+\
+    if (NULL == pstList) \
+    { \
+        return; \
+    } \
+\
+    for (pstNode = pstList->pstFirst; NULL != pstNode; pstNode = pstNext) \
+    { \
+        pstNext = pstNode->pstNext; \
+        free(pstNode); \
+    } \
+    free(pstList); \
+\
+    return; \
+} \
+\
+/**find the link to the first node behind tKey, or not before it if bEqual, \
+   the link may be the head of list**/ \
+static inline Name##Node_S** Name##_find(IN Name##_S *pstList, IN T *ptKey, \
+                                         IN BOOL_T bEqual) \
+{ \
+    Name##Node_S **ppstLink = &pstList->pstFirst; \
+\
+    while (NULL != *ppstLink) \
+    { \
+        if (BOOL_TRUE == bEqual ? !(LESS((*ppstLink)->tItem, *ptKey)) : \
+                                  LESS(*ptKey, (*ppstLink)->tItem)) \
+        { \
+            break; \
+        } \
+        ppstLink = &(*ppstLink)->pstNext; \
+    } \
+\
+    return ppstLink; \
+} \
+\
+static inline ULONG Name##Add(INOUT Name##_S *pstList, IN T tItem) \
+{ \
+    Name##Node_S *pstNode = NULL; \
+    Name##Node_S **ppstLink = NULL; \
+\
+    if (NULL == pstList) \
+    { \
+        return ERROR_FAILED; \
+    } \
+\
+    pstNode = (Name##Node_S *)malloc(sizeof(Name##Node_S)); \
+    if (NULL == pstNode) \
+    { \
+        return ERROR_FAILED; \
+    } \
+    pstNode->tItem = tItem; \
+\
+    ppstLink = Name##_find(pstList, &tItem, BOOL_FALSE); \
+    pstNode->pstNext = *ppstLink; \
+    *ppstLink = pstNode; \
+    pstList->uiNum++; \
+\
+    return ERROR_SUCCESS; \
+} \
+\
+static inline ULONG Name##Delete(INOUT Name##_S *pstList, IN T tKey, \
+                                 OUT T *ptItem) \
+{ \
+    Name##Node_S *pstNode = NULL; \
+    Name##Node_S **ppstLink = NULL; \
+\
+    if (NULL == pstList || NULL == ptItem) \
+    { \
+        return ERROR_FAILED; \
+    } \
+\
+    ppstLink = Name##_find(pstList, &tKey, BOOL_TRUE); \
+    pstNode = *ppstLink; \
+    if (NULL == pstNode || LESS(tKey, pstNode->tItem)) \
+    { \
+        return ERROR_FAILED; \
+    } \
+\
+    *ptItem = pstNode->tItem; \
+    *ppstLink = pstNode->pstNext; \
+    free(pstNode); \
+    pstList->uiNum--; \
+\
+    return ERROR_SUCCESS; \
+} \
+\
+static inline ULONG Name##DelHead(INOUT Name##_S *pstList, OUT T *ptItem) \
+{ \
+    Name##Node_S *pstNode = NULL; \
+\
+    if (NULL == pstList || NULL == ptItem || NULL == pstList->pstFirst) \
+    { \
+        return ERROR_FAILED; \
+    } \
+\
+    pstNode = pstList->pstFirst; \
+    *ptItem = pstNode->tItem; \
+    pstList->pstFirst = pstNode->pstNext; \
+    free(pstNode); \
+    pstList->uiNum--; \
+\
+    return ERROR_SUCCESS; \
+} \
+\
+static inline ULONG Name##GetFirst(IN Name##_S *pstList, OUT T *ptItem) \
+{ \
+    if (NULL == pstList || NULL == ptItem || NULL == pstList->pstFirst) \
+    { \
+        return ERROR_FAILED; \
+    } \
+\
+    *ptItem = pstList->pstFirst->tItem; \
+\
+    return ERROR_SUCCESS; \
+} \
+\
+static inline ULONG Name##GetItem(IN Name##_S *pstList, IN T tKey, \
+                                  OUT T *ptItem) \
+{ \
+    Name##Node_S *pstNode = NULL; \
+\
+    if (NULL == pstList || NULL == ptItem) \
+    { \
+        return ERROR_FAILED; \
+    } \
+\
+    pstNode = *Name##_find(pstList, &tKey, BOOL_TRUE); \
+    if (NULL == pstNode || LESS(tKey, pstNode->tItem)) \
+    { \
+        return ERROR_FAILED; \
+    } \
+\
+    *ptItem = pstNode->tItem; \
+\
+    return ERROR_SUCCESS; \
+} \
+\
+static inline UINT Name##Number(IN Name##_S *pstList) \
+{ \
+    if (NULL == pstList) \
+    { \
+        return 0; \
+    } \
+\
+    return pstList->uiNum; \
+}
+
+#endif
@@ -16,13 +16,32 @@ Copyright(C):   Huazhong University of Science & Technology.
 #ifndef _STACK_H_
 #define _STACK_H_
 
+/**a block of items of chunked stack, see StackCreateChunked**/
+typedef struct tagStackChunk_S
+{
+    struct tagStackChunk_S *pstBelow;
+    VOID *apvItem[];
+}StackChunk_S;
+
 typedef struct tagStack_S
 {
-    UINT uiSize;
+    UINT uiSize;              /*items of the top chunk in chunked stack*/
     VOID **ppvStack;
     VOID **ppvTop;
     PF_PRINT pfPrint;
     PF_FREE pfFree;
+    BOOL_T bGrow;             /*grow automatically, see StackSetGrow*/
+    UINT uiShrink;
+    UINT uiMinSize;
+    UINT uiNextSize;          /*the memery being moved to when growing or shrinking*/
+    VOID **ppvNext;
+    UINT uiMoved;             /*items below it have been moved*/
+    StackChunk_S *pstChunk;   /*top chunk, chunked stack only*/
+    StackChunk_S *pstSpare;   /*an empty chunk kept for the next push*/
+    UINT uiBelow;             /*items in the chunks below the top one*/
+    UINT uiElemSize;          /*bytes of a record, value stack only*/
+    CHAR *pcValue;            /*records of value stack*/
+    UINT uiValues;            /*records in value stack*/
 }Stack_S;
 
 /*******************************************************************************
@@ -47,6 +66,84 @@ typedef struct tagStack_S
 *******************************************************************************/
 Stack_S* StackCreate(IN UINT uiSize, PF_PRINT pfPrint, PF_FREE pfFree);
 
+/*******************************************************************************
+    Func Name:  StackCreateChunked
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a stack on a chain of chunks without a size limit
+        Input:  IN UINT uiChunkSize, how many items a chunk can store.
+                IN PF_PRINT pfPrint, callback function to print item
+                PF_FREE pfFree, callback function to free the memery of item
+       Output:  NONE  
+       Return:  Stack_S*,  the stack struct
+                NULL,     error occured
+      Caution:  A push onto a full chunk links a new one, and a pop leaves an
+                empty chunk to the spare one, so push and pop touch the top
+                chunk only and the items are never copied. One spare chunk is
+                kept, a push and pop at the edge of a chunk don't call malloc
+                and free each time. StackSetGrow fails on it
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+Stack_S* StackCreateChunked(IN UINT uiChunkSize, PF_PRINT pfPrint,
+                            PF_FREE pfFree);
+
+/*******************************************************************************
+    Func Name:  StackCreateValue
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a stack storing records by value
+        Input:  IN UINT uiSize, how many records the stack can store.
+                IN UINT uiElemSize, bytes of a record
+                IN PF_PRINT pfPrint, callback function to print record
+                PF_FREE pfFree, callback function to free what a record
+                                refers to
+       Output:  NONE
+       Return:  Stack_S*,  the stack struct
+                NULL,     error occured
+      Caution:  StackPush copies uiElemSize bytes from the item into the slot on
+                the top, so no memery is allocated for a record. StackPeek
+                returns the slot, and StackPop the slot it leaves, which keeps
+                the record till the next push. The callbacks get the slot,
+                pfFree should not free it. The stack never grows,
+                StackSetGrow fails on it, and so do StackPushN and StackPopN
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+Stack_S* StackCreateValue(IN UINT uiSize, IN UINT uiElemSize,
+                          PF_PRINT pfPrint, PF_FREE pfFree);
+
+/*******************************************************************************
+    Func Name:  StackSetGrow
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Make a stack grow automatically instead of being full
+        Input:  IN Stack_S *pstStack
+                IN UINT uiShrink, shrink the stack to half if less than 
+                                  1/uiShrink of it is used, 0 for never
+       Output:  OUT Stack_S *pstStack
+       Return:  ULONG
+                ERROR_SUCCESS, success
+                ERROR_FAILED, failed
+      Caution:  uiShrink should be 0 or not less than 4. The stack doubles when
+                it is 3/4 full, and never shrinks below the size it's created 
+                with. The items are copied to the new memery a few a time by
+                every push and pop, so no one of them stalls for copying the
+                whole stack. It fails on chunked stack
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+ULONG StackSetGrow(INOUT Stack_S *pstStack, IN UINT uiShrink);
+
 /*******************************************************************************
     Func Name:  StackFree
  Date Created:  2014-9-18
@@ -86,6 +183,32 @@ VOID StackFree(IN Stack_S *pStack_S);
 *******************************************************************************/
 ULONG StackPush(IN Stack_S *pStack_S, IN VOID *pvItem);
 
+/*******************************************************************************
+    Func Name:  StackPushN
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Push some items into stack at once
+        Input:  IN Stack_S *pstStack
+                IN VOID **ppvItems, items to be pushed, the last one is on the
+                                    top at the end
+                IN UINT uiNum, how many items in ppvItems
+       Output:  OUT Stack_S *pstStack
+       Return:  UINT, how many items pushed, less than uiNum if the
+                      stack is full
+      Caution:  Items in ppvItems should not be NULL, they're not checked one by
+                one. The room is checked once and the items are copied by a
+                memcpy, or one for each chunk of chunked stack. A growing
+                stack moves on as many steps as pushing the items one by one
+                would. Only if they can't fit, it finishes moving and doubles
+                at once till they fit in 3/4 of it. It fails on value stack
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT StackPushN(INOUT Stack_S *pstStack, IN VOID **ppvItems, IN UINT uiNum);
+
 /*******************************************************************************
     Func Name:  StackPop
  Date Created:  2014-9-18
@@ -105,6 +228,30 @@ ULONG StackPush(IN Stack_S *pStack_S, IN VOID *pvItem);
 *******************************************************************************/
 VOID* StackPop(IN Stack_S *pStack_S);
 
+/*******************************************************************************
+    Func Name:  StackPopN
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Pop some items out of stack at once
+        Input:  IN Stack_S *pstStack
+                IN UINT uiNum, how many items to pop at most
+       Output:  OUT Stack_S *pstStack
+                OUT VOID **ppvItems, items popped, in the order they were in
+                                     stack, the top one is the last
+       Return:  UINT, how many items popped, less than uiNum if the
+                      stack runs out
+      Caution:  ppvItems should hold uiNum items. The items are copied by a
+                memcpy, or one for each chunk of chunked stack. They keep the
+                order, so StackPushN of them puts them back as they were. It
+                fails on value stack
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT StackPopN(INOUT Stack_S *pstStack, IN UINT uiNum, OUT VOID **ppvItems);
+
 /*******************************************************************************
     Func Name:  StackPeek
  Date Created:  2014-9-18
@@ -0,0 +1,223 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   timerwheel.h
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   Interface of hierarchical timing wheel.
+      Others:   A timer is put in a slot of wheel 0 if it expires in 256
+                ticks, of wheel 1 if in 2^16 ticks, and so on. When wheel 0
+                turns a round, the next slot of wheel 1 is cascaded down into
+                it. Adding and cancelling a timer cost O(1), each timer is
+                cascaded at most TIMERWHEEL_LEVELS - 1 times
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+#ifndef _TIMERWHEEL_H_
+#define _TIMERWHEEL_H_
+
+#define TIMERWHEEL_BITS    8
+#define TIMERWHEEL_SLOTS   (1U << TIMERWHEEL_BITS)   /*slots of a wheel*/
+#define TIMERWHEEL_LEVELS  4
+
+/*******************************************************************************
+    Func Name:  PF_EXPIRE
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Callback function called when a timer expires.
+        Input:  IN VOID *pvItem, item of the timer
+       Output:  NONE
+       Return:  NONE
+      Caution:  The timer is removed before it's called, it can add or cancel
+                timers
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+typedef VOID (*PF_EXPIRE)(IN VOID *pvItem);
+
+typedef struct tagTimerWheel_S
+{
+    UINT uiSize;
+    UINT uiNum;
+    UINT64 ullNow;            /*the current tick*/
+    UINT uiFree;              /*first free node*/
+    UINT64 *pullExpire;       /*expire tick of each node*/
+    VOID **ppvItem;           /*item of each node*/
+    UINT *puiNext;            /*next node in the same slot or free list*/
+    UINT *puiPrev;            /*previous node in the same slot*/
+    UINT *puiSlot;            /*slot of each node, TIMERWHEEL_NIL if free*/
+    PF_EXPIRE pfExpire;
+    PF_PRINT pfPrint;
+    PF_FREE pfFree;
+    UINT auiSlot[TIMERWHEEL_LEVELS * TIMERWHEEL_SLOTS];  /*first node of slot*/
+}TimerWheel_S;
+
+/*******************************************************************************
+    Func Name:  TimerWheelCreate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a hierarchical timing wheel
+        Input:  IN UINT uiSize, how many timers the wheel can store.
+                IN PF_EXPIRE pfExpire, callback function when a timer expires
+                IN PF_PRINT pfPrint, callback function to print item
+                IN PF_FREE pfFree, callback function to free item
+       Output:  NONE
+       Return:  TimerWheel_S*,  the wheel struct
+                NULL,           error occured
+      Caution:  The current tick is 0 at first.
+                pfExpire and pfPrint can be NULL
+                pfFree can be NULL if you don't want your data to be freed when
+                deleting the wheel
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+TimerWheel_S* TimerWheelCreate(IN UINT uiSize,
+                               IN PF_EXPIRE pfExpire,
+                               IN PF_PRINT pfPrint,
+                               IN PF_FREE pfFree);
+
+/*******************************************************************************
+    Func Name:  TimerWheelFree
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To free a given wheel
+        Input:  IN TimerWheel_S *pstWheel, the wheel to be freed
+       Output:  NONE
+       Return:  NONE
+      Caution:  If you have installed PF_FREE callback function, then items of
+                all timers not expired will be freed, otherwise it's the
+                user's responsibility to free the memeries of all items
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID TimerWheelFree(IN TimerWheel_S *pstWheel);
+
+/*******************************************************************************
+    Func Name:  TimerWheelAdd
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add a timer to wheel
+        Input:  IN TimerWheel_S *pstWheel
+                IN UINT64 ullDelay, how many ticks later the timer expires
+                IN VOID *pvItem, item of the timer
+       Output:  OUT TimerWheel_S *pstWheel
+                OUT UINT *puiHandle, handle of the timer, can be NULL
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed
+      Caution:  pvItem should not be NULL, a delay of 0 is taken as 1. The
+                handle keeps valid until the timer expires or is cancelled,
+                then it may be reused by another timer. Costs O(1)
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG TimerWheelAdd(INOUT TimerWheel_S *pstWheel, IN UINT64 ullDelay,
+                    IN VOID *pvItem, OUT UINT *puiHandle);
+
+/*******************************************************************************
+    Func Name:  TimerWheelRemove
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Cancel a timer
+        Input:  IN TimerWheel_S *pstWheel
+                IN UINT uiHandle, handle of the timer
+       Output:  OUT TimerWheel_S *pstWheel
+       Return:  VOID*, item of the timer cancelled
+                NULL, the handle is not in use
+      Caution:  Costs O(1). The memery of the item is left to users to free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* TimerWheelRemove(INOUT TimerWheel_S *pstWheel, IN UINT uiHandle);
+
+/*******************************************************************************
+    Func Name:  TimerWheelAdvance
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Turn the wheel some ticks on, and expire the timers due
+        Input:  IN TimerWheel_S *pstWheel
+                IN UINT64 ullTicks, how many ticks to turn
+       Output:  OUT TimerWheel_S *pstWheel
+       Return:  UINT, how many timers expired
+      Caution:  PF_EXPIRE is called for each timer expired, timers of the same
+                tick expire in no order. The ticks are turned one by one, but
+                at once if the wheel is empty
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT TimerWheelAdvance(INOUT TimerWheel_S *pstWheel, IN UINT64 ullTicks);
+
+/*******************************************************************************
+    Func Name:  TimerWheelNow
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return the current tick of wheel
+        Input:  IN TimerWheel_S *pstWheel
+       Output:  NONE
+       Return:  UINT64
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT64 TimerWheelNow(IN TimerWheel_S *pstWheel);
+
+/*******************************************************************************
+    Func Name:  TimerWheelPrint
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  print items of all timers in wheel
+        Input:  IN TimerWheel_S *pstWheel
+       Output:  NONE
+       Return:  NONE
+      Caution:  slot by slot, not in order of expire ticks
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID TimerWheelPrint(IN TimerWheel_S *pstWheel);
+
+/*******************************************************************************
+    Func Name:  TimerWheelNumber
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many timers in wheel
+        Input:  IN TimerWheel_S *pstWheel
+       Output:  NONE
+       Return:  UINT
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT TimerWheelNumber(IN TimerWheel_S *pstWheel);
+
+#endif
@@ -0,0 +1,140 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   topk.h
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   Interface of top-k selector.
+      Others:   The k best items of a stream are kept in a heap whose root is
+                the worst of them, a candidate behind the root is rejected
+                by one compare without touching the heap
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+#ifndef _TOPK_H_
+#define _TOPK_H_
+
+#define TOPK_MINI     0       /*keep the k minimal items, as HEAP_MINI*/
+#define TOPK_MAXI     1       /*keep the k max items, as HEAP_MAXI*/
+#define TOPK_UPSPACE  2
+
+typedef struct tagTopK_S
+{
+    Heap_S *pstHeap;          /*HEAP_MINI for TOPK_MAXI, HEAP_MAXI for TOPK_MINI*/
+    UINT uiK;
+    UINT uiType;
+}TopK_S;
+
+/*******************************************************************************
+    Func Name:  TopKCreate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a top-k selector
+        Input:  IN UINT uiK, how many items to keep
+                IN UINT uiType, TOPK_MAXI to keep the k max items, TOPK_MINI
+                                to keep the k minimal items
+                IN PF_COMPARE pfCompare, callback function to compare two items
+                IN PF_PRINT pfPrint, callback function to print item
+                IN PF_FREE pfFree, callback function to free item
+       Output:  NONE
+       Return:  TopK_S*,  the selector struct
+                NULL,     error occured
+      Caution:  uiK should not be 0, pfCompare should not be NULL,
+                pfPrint can be NULL
+                pfFree can be NULL if you don't want your data to be freed when
+                deleting the selector
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+TopK_S* TopKCreate(IN UINT uiK, IN UINT uiType,
+                   IN PF_COMPARE pfCompare,
+                   IN PF_PRINT pfPrint,
+                   IN PF_FREE pfFree);
+
+/*******************************************************************************
+    Func Name:  TopKFree
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To free a given selector
+        Input:  IN TopK_S *pstTopK, the selector to be freed
+       Output:  NONE
+       Return:  NONE
+      Caution:  If you have installed PF_FREE callback function, then all the
+                itmes kept will be freed, otherwise it's the user's
+                responsibility to free the memeries of all items
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID TopKFree(IN TopK_S *pstTopK);
+
+/*******************************************************************************
+    Func Name:  TopKOffer
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Offer a candidate to the selector
+        Input:  IN TopK_S *pstTopK
+                IN VOID *pvItem, the candidate
+       Output:  OUT TopK_S *pstTopK
+       Return:  VOID*, the item dropped, it's pvItem itself if it's rejected,
+                       or the worst item kept before if pvItem takes its place
+                NULL, pvItem is kept and nothing is dropped, or failed
+      Caution:  pvItem should not be NULL. A candidate equal to the worst item
+                kept is rejected. A rejection costs one compare, a take costs
+                O(log k). The memery of the item dropped is left to users to
+                free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* TopKOffer(INOUT TopK_S *pstTopK, IN VOID *pvItem);
+
+/*******************************************************************************
+    Func Name:  TopKDrainSorted
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Take all items kept out, the best first
+        Input:  IN TopK_S *pstTopK
+       Output:  OUT TopK_S *pstTopK, it's empty then
+                OUT VOID **ppvItems, items taken out
+       Return:  UINT, how many items taken out
+      Caution:  ppvItems should hold TopKNumber items at least, the max item
+                comes first for TOPK_MAXI, the minimal one for TOPK_MINI.
+                Costs O(k log k), the memery of items is left to users to free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT TopKDrainSorted(INOUT TopK_S *pstTopK, OUT VOID **ppvItems);
+
+/*******************************************************************************
+    Func Name:  TopKNumber
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many items kept in selector
+        Input:  IN TopK_S *pstTopK
+       Output:  NONE
+       Return:  UINT
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT TopKNumber(IN TopK_S *pstTopK);
+
+#endif
@@ -67,6 +67,7 @@ typedef int             INT;
 typedef unsigned int    UINT;
 typedef long            LONG;
 typedef unsigned long   ULONG;
+typedef unsigned long long UINT64;
 typedef float           FLOAT;
 typedef double          DOUBLE;
 typedef long double     LDOUBLE; 
@@ -128,4 +129,39 @@ typedef VOID (*PF_PRINT)(IN VOID *pvItem);
 *******************************************************************************/
 typedef VOID (*PF_FREE)(IN VOID *pvItem);
 
+/*******************************************************************************
+    Func Name:  PF_HASH
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Callback function that hash data.
+        Input:  IN VOID *pvItem
+       Output:  NONE  
+       Return:  ULONG, the hash value
+      Caution:  Two data equal by PF_COMPARE should have the same hash value
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+typedef ULONG (*PF_HASH)(IN VOID *pvItem);
+
+/*******************************************************************************
+    Func Name:  PF_PREDICATE
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Callback function that tests data.
+        Input:  IN VOID *pvItem
+                IN VOID *pvCtx, the context given with the callback
+       Output:  NONE  
+       Return:  BOOL_T, BOOL_TRUE if the data matches
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+typedef BOOL_T (*PF_PREDICATE)(IN VOID *pvItem, IN VOID *pvCtx);
+
 #endif
\ No newline at end of file
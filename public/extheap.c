@@ -0,0 +1,964 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   extheap.c
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   A realization of external memory priority queue.
+      Others:   The slots of the items in memery are reused through a stack of
+                free ones, and the stack holds the items in order while they
+                are spilled, for it's empty when the memery is full. A run
+                keeps the file offset of its head, so a failed read or merge
+                seeks back and no item is lost
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+/**system headfiles**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <unistd.h>
+/**public headfiles**/
+#include "../include/type.h"
+#include "../include/err.h"
+#include "../include/length.h"
+#include "../include/heap.h"
+#include "../include/extheap.h"
+/**module headfiles**/
+
+/**runs of the same level merged at once**/
+#define EXTHEAP_WAYS    16
+
+/**runs sharing the memery of read ahead buffers**/
+#define EXTHEAP_BUFS    64
+
+/**the most items kept in memery**/
+#define EXTHEAP_MEMMAX  0x7FFFFFFF
+
+/**name of the temporary files**/
+#define EXTHEAP_TMPNAME "/extheapXXXXXX"
+
+/*******************************************************************************
+    Func Name:  extheap_compare
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Compare the heads of two runs
+        Input:  IN VOID *pvFirst, a run
+                IN VOID *pvSecond, the other run
+       Output:  NONE
+       Return:  INT, as the PF_COMPARE of the items
+      Caution:  The heads should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static INT extheap_compare(IN VOID *pvFirst, IN VOID *pvSecond)
+{
+    ExtRun_S *pstFirst = (ExtRun_S *)pvFirst;
+    ExtRun_S *pstSecond = (ExtRun_S *)pvSecond;
+
+    assert(NULL != pstFirst->pvHead && NULL != pstSecond->pvHead);
+
+    return pstFirst->pfCompare(pstFirst->pvHead, pstSecond->pvHead);
+}
+
+/*******************************************************************************
+    Func Name:  extheap_read
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Read the next block of a run into its buffer
+        Input:  IN ExtHeap_S *pstHeap
+                IN ExtRun_S *pstRun
+       Output:  OUT ExtRun_S *pstRun, the head is NULL if the run runs out
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed to read
+      Caution:  params should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static ULONG extheap_read(IN ExtHeap_S *pstHeap, INOUT ExtRun_S *pstRun)
+{
+    FILE *pstFile = (FILE *)pstRun->pvFile;
+
+    assert(NULL != pstHeap && NULL != pstRun);
+
+    pstRun->ulBufOffset = pstRun->ulNextOffset;
+    pstRun->uiHave = (UINT)fread(pstRun->pcBuf, pstHeap->uiItemSize,
+                                 pstHeap->uiBufSize, pstFile);
+    pstRun->ulNextOffset += (ULONG)pstRun->uiHave * pstHeap->uiItemSize;
+    pstRun->uiPos = 0;
+    if (0 == pstRun->uiHave)
+    {
+        pstRun->pvHead = NULL;
+        if (0 != ferror(pstFile))
+        {
+            clearerr(pstFile);
+            return ERROR_FAILED;
+        }
+        return ERROR_SUCCESS;
+    }
+
+    pstRun->pvHead = pstRun->pcBuf;
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  extheap_seek
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Make the item at a file offset the head of a run
+        Input:  IN ExtHeap_S *pstHeap
+                IN ExtRun_S *pstRun
+                IN ULONG ulOffset, file offset of the head
+       Output:  OUT ExtRun_S *pstRun
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed to seek or read
+      Caution:  params should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static ULONG extheap_seek(IN ExtHeap_S *pstHeap, INOUT ExtRun_S *pstRun,
+                          IN ULONG ulOffset)
+{
+    assert(NULL != pstHeap && NULL != pstRun);
+
+    if (0 != fseek((FILE *)pstRun->pvFile, (LONG)ulOffset, SEEK_SET))
+    {
+        return ERROR_FAILED;
+    }
+    pstRun->ulNextOffset = ulOffset;
+
+    return extheap_read(pstHeap, pstRun);
+}
+
+/*******************************************************************************
+    Func Name:  extheap_offset
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return the file offset of the head of a run
+        Input:  IN ExtHeap_S *pstHeap
+                IN ExtRun_S *pstRun
+       Output:  NONE
+       Return:  ULONG
+      Caution:  params should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline ULONG extheap_offset(IN ExtHeap_S *pstHeap, IN ExtRun_S *pstRun)
+{
+    assert(NULL != pstHeap && NULL != pstRun);
+
+    return pstRun->ulBufOffset + (ULONG)pstRun->uiPos * pstHeap->uiItemSize;
+}
+
+/*******************************************************************************
+    Func Name:  extheap_next
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Move the head of a run to the next item
+        Input:  IN ExtHeap_S *pstHeap
+                IN ExtRun_S *pstRun
+       Output:  OUT ExtRun_S *pstRun, the head is NULL if the run runs out
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed to read, the head is not moved
+      Caution:  params should not be NULL, the head should not be NULL. The
+                memery of the old head may be overwritten
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static ULONG extheap_next(IN ExtHeap_S *pstHeap, INOUT ExtRun_S *pstRun)
+{
+    ULONG ulOffset = 0;
+
+    assert(NULL != pstHeap && NULL != pstRun && NULL != pstRun->pvHead);
+
+    ulOffset = extheap_offset(pstHeap, pstRun);
+    pstRun->uiPos++;
+    if (pstRun->uiPos < pstRun->uiHave)
+    {
+        pstRun->pvHead = pstRun->pcBuf +
+                         (ULONG)pstRun->uiPos * pstHeap->uiItemSize;
+        return ERROR_SUCCESS;
+    }
+
+    if (ERROR_SUCCESS != extheap_read(pstHeap, pstRun))
+    {
+        (VOID)extheap_seek(pstHeap, pstRun, ulOffset);
+        return ERROR_FAILED;
+    }
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  extheap_runfree
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Close the file of a run and free it
+        Input:  IN ExtRun_S *pstRun
+       Output:  NONE
+       Return:  NONE
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static VOID extheap_runfree(IN ExtRun_S *pstRun)
+{
+    if (NULL == pstRun)
+    {
+        return;
+    }
+
+    if (NULL != pstRun->pvFile)
+    {
+        (VOID)fclose((FILE *)pstRun->pvFile);
+    }
+    free(pstRun->pcBuf);
+    free(pstRun);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  extheap_runcreate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Create an empty run in a new temporary file
+        Input:  IN ExtHeap_S *pstHeap
+                IN UINT uiLevel
+       Output:  NONE
+       Return:  ExtRun_S*, the run, its head is NULL
+                NULL, error occured
+      Caution:  pstHeap should not be NULL. The file is unlinked at once, it
+                goes when it's closed
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static ExtRun_S* extheap_runcreate(IN ExtHeap_S *pstHeap, IN UINT uiLevel)
+{
+    ExtRun_S *pstRun = NULL;
+    CHAR *pcPath = NULL;
+    INT iFd = -1;
+
+    assert(NULL != pstHeap);
+
+    pstRun = (ExtRun_S *)malloc(sizeof(ExtRun_S));
+    if (NULL == pstRun)
+    {
+        return NULL;
+    }
+    memset(pstRun, 0, sizeof(ExtRun_S));
+    pstRun->pfCompare = pstHeap->pfCompare;
+    pstRun->uiLevel = uiLevel;
+
+    pstRun->pcBuf = (CHAR *)malloc((ULONG)pstHeap->uiBufSize *
+                                   pstHeap->uiItemSize);
+    pcPath = (CHAR *)malloc(strlen(pstHeap->pcTmpDir) +
+                            sizeof(EXTHEAP_TMPNAME));
+    if (NULL == pstRun->pcBuf || NULL == pcPath)
+    {
+        free(pcPath);
+        extheap_runfree(pstRun);
+        return NULL;
+    }
+
+    strcpy(pcPath, pstHeap->pcTmpDir);
+    strcat(pcPath, EXTHEAP_TMPNAME);
+    iFd = mkstemp(pcPath);
+    if (iFd < 0)
+    {
+        free(pcPath);
+        extheap_runfree(pstRun);
+        return NULL;
+    }
+    (VOID)unlink(pcPath);
+    free(pcPath);
+
+    pstRun->pvFile = fdopen(iFd, "w+b");
+    if (NULL == pstRun->pvFile)
+    {
+        (VOID)close(iFd);
+        extheap_runfree(pstRun);
+        return NULL;
+    }
+
+    return pstRun;
+}
+
+/*******************************************************************************
+    Func Name:  extheap_runadd
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Put a run into the queue
+        Input:  IN ExtHeap_S *pstHeap
+                IN ExtRun_S *pstRun, a run with its head read
+       Output:  OUT ExtHeap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed
+      Caution:  params should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static ULONG extheap_runadd(INOUT ExtHeap_S *pstHeap, IN ExtRun_S *pstRun)
+{
+    ExtRun_S **ppstRun = NULL;
+
+    assert(NULL != pstHeap && NULL != pstRun && NULL != pstRun->pvHead);
+
+    if (pstHeap->uiRuns == pstHeap->uiRunSize)
+    {
+        ppstRun = (ExtRun_S **)realloc(pstHeap->ppstRun, sizeof(ExtRun_S *) *
+                                       pstHeap->uiRunSize * 2);
+        if (NULL == ppstRun)
+        {
+            return ERROR_FAILED;
+        }
+        pstHeap->ppstRun = ppstRun;
+        pstHeap->uiRunSize *= 2;
+    }
+
+    if (ERROR_SUCCESS != HeapAdd(pstHeap->pstRun, pstRun))
+    {
+        return ERROR_FAILED;
+    }
+    pstHeap->ppstRun[pstHeap->uiRuns++] = pstRun;
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  extheap_rundel
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Take a run out of the list of runs
+        Input:  IN ExtHeap_S *pstHeap
+                IN ExtRun_S *pstRun
+       Output:  OUT ExtHeap_S *pstHeap
+       Return:  NONE
+      Caution:  params should not be NULL, the run is not taken out of the
+                heap of runs
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static VOID extheap_rundel(INOUT ExtHeap_S *pstHeap, IN ExtRun_S *pstRun)
+{
+    UINT uiCount = 0;
+
+    assert(NULL != pstHeap && NULL != pstRun);
+
+    for (uiCount = 0; uiCount < pstHeap->uiRuns; uiCount++)
+    {
+        if (pstRun == pstHeap->ppstRun[uiCount])
+        {
+            pstHeap->uiRuns--;
+            pstHeap->ppstRun[uiCount] = pstHeap->ppstRun[pstHeap->uiRuns];
+            break;
+        }
+    }
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  extheap_spill
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Write all items in memery to a new run
+        Input:  IN ExtHeap_S *pstHeap
+       Output:  OUT ExtHeap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, the items stay in memery
+      Caution:  pstHeap should not be NULL, and no slot is free. The items are
+                drained into the stack of free slots in order, and all slots
+                are free after the run is written
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static ULONG extheap_spill(INOUT ExtHeap_S *pstHeap)
+{
+    ExtRun_S *pstRun = NULL;
+    FILE *pstFile = NULL;
+    UINT uiNum = 0;
+    UINT uiCount = 0;
+
+    assert(NULL != pstHeap && 0 == pstHeap->uiFree);
+
+    pstRun = extheap_runcreate(pstHeap, 0);
+    if (NULL == pstRun)
+    {
+        return ERROR_FAILED;
+    }
+    pstFile = (FILE *)pstRun->pvFile;
+
+    uiNum = HeapRemoveRootN(pstHeap->pstMem, HeapNumber(pstHeap->pstMem),
+                            pstHeap->ppvFree);
+    for (uiCount = 0; uiCount < uiNum; uiCount++)
+    {
+        if (1 != fwrite(pstHeap->ppvFree[uiCount], pstHeap->uiItemSize, 1,
+                        pstFile))
+        {
+            break;
+        }
+    }
+
+    if (uiCount < uiNum || 0 != fflush(pstFile) ||
+        ERROR_SUCCESS != extheap_seek(pstHeap, pstRun, 0) ||
+        ERROR_SUCCESS != extheap_runadd(pstHeap, pstRun))
+    {
+        extheap_runfree(pstRun);
+        (VOID)HeapAddBatch(pstHeap->pstMem, pstHeap->ppvFree, uiNum);
+        return ERROR_FAILED;
+    }
+
+    pstHeap->uiFree = uiNum;
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  extheap_merge
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Merge EXTHEAP_WAYS runs of a level into a run of the next
+                level
+        Input:  IN ExtHeap_S *pstHeap
+                IN UINT uiLevel
+       Output:  OUT ExtHeap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success, or not enough runs of the level
+                ERROR_FAILED,   failed, the runs are as they were
+      Caution:  pstHeap should not be NULL. The heads of the runs move while
+                merging, so the heap of runs is rebuilt after it
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static ULONG extheap_merge(INOUT ExtHeap_S *pstHeap, IN UINT uiLevel)
+{
+    ExtRun_S *apstIn[EXTHEAP_WAYS];
+    ULONG aulOffset[EXTHEAP_WAYS];
+    ExtRun_S *pstIn = NULL;
+    ExtRun_S *pstOut = NULL;
+    Heap_S *pstMerge = NULL;
+    ULONG ulRet = ERROR_SUCCESS;
+    UINT uiIn = 0;
+    UINT uiCount = 0;
+
+    assert(NULL != pstHeap);
+
+    for (uiCount = 0; uiCount < pstHeap->uiRuns && uiIn < EXTHEAP_WAYS;
+         uiCount++)
+    {
+        pstIn = pstHeap->ppstRun[uiCount];
+        if (uiLevel == pstIn->uiLevel)
+        {
+            apstIn[uiIn] = pstIn;
+            aulOffset[uiIn] = extheap_offset(pstHeap, pstIn);
+            uiIn++;
+        }
+    }
+    if (uiIn < EXTHEAP_WAYS)
+    {
+        return ERROR_SUCCESS;
+    }
+
+    pstOut = extheap_runcreate(pstHeap, uiLevel + 1);
+    if (NULL == pstOut)
+    {
+        return ERROR_FAILED;
+    }
+    pstMerge = HeapCreateFromArray((VOID **)apstIn, uiIn, uiIn, HEAP_MINI,
+                                   extheap_compare, NULL, NULL);
+    if (NULL == pstMerge)
+    {
+        extheap_runfree(pstOut);
+        return ERROR_FAILED;
+    }
+
+    while (0 != HeapNumber(pstMerge))
+    {
+        pstIn = (ExtRun_S *)HeapMin(pstMerge);
+        if (1 != fwrite(pstIn->pvHead, pstHeap->uiItemSize, 1,
+                        (FILE *)pstOut->pvFile) ||
+            ERROR_SUCCESS != extheap_next(pstHeap, pstIn))
+        {
+            ulRet = ERROR_FAILED;
+            break;
+        }
+
+        if (NULL == pstIn->pvHead)
+        {
+            (VOID)HeapRemoveRoot(pstMerge);
+        }
+        else
+        {
+            (VOID)HeapReplace(pstMerge, pstIn);
+        }
+    }
+    HeapFree(pstMerge);
+
+    if (ERROR_SUCCESS == ulRet &&
+        (0 != fflush((FILE *)pstOut->pvFile) ||
+         ERROR_SUCCESS != extheap_seek(pstHeap, pstOut, 0)))
+    {
+        ulRet = ERROR_FAILED;
+    }
+
+    if (ERROR_SUCCESS != ulRet)
+    {
+        extheap_runfree(pstOut);
+        for (uiCount = 0; uiCount < uiIn; uiCount++)
+        {
+            (VOID)extheap_seek(pstHeap, apstIn[uiCount], aulOffset[uiCount]);
+        }
+        return ERROR_FAILED;
+    }
+
+    /**the list has room, for it's shorter than before**/
+    for (uiCount = 0; uiCount < uiIn; uiCount++)
+    {
+        extheap_rundel(pstHeap, apstIn[uiCount]);
+        extheap_runfree(apstIn[uiCount]);
+    }
+    pstHeap->ppstRun[pstHeap->uiRuns++] = pstOut;
+
+    while (0 != HeapNumber(pstHeap->pstRun))
+    {
+        (VOID)HeapRemoveTail(pstHeap->pstRun);
+    }
+    (VOID)HeapAddBatch(pstHeap->pstRun, (VOID **)pstHeap->ppstRun,
+                       pstHeap->uiRuns);
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  extheap_least
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Look for the least item in memery and runs
+        Input:  IN ExtHeap_S *pstHeap
+       Output:  OUT ExtRun_S **ppstRun, the run of the item, NULL if the item
+                                       is in memery
+       Return:  VOID*, the least item
+                NULL, the queue is empty
+      Caution:  params should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static VOID* extheap_least(IN ExtHeap_S *pstHeap, OUT ExtRun_S **ppstRun)
+{
+    VOID *pvItem = NULL;
+    ExtRun_S *pstRun = NULL;
+
+    assert(NULL != pstHeap && NULL != ppstRun);
+
+    *ppstRun = NULL;
+    pvItem = HeapMin(pstHeap->pstMem);
+    pstRun = (ExtRun_S *)HeapMin(pstHeap->pstRun);
+    if (NULL == pstRun)
+    {
+        return pvItem;
+    }
+
+    if (NULL == pvItem || pstHeap->pfCompare(pstRun->pvHead, pvItem) < 0)
+    {
+        *ppstRun = pstRun;
+        return pstRun->pvHead;
+    }
+
+    return pvItem;
+}
+
+/*******************************************************************************
+    Func Name:  ExtHeapCreate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create an external memery priority queue
+        Input:  IN UINT uiItemSize, bytes of an item
+                IN ULONG ulMemory, bytes of memery for the items and buffers
+                IN CHAR *pcTmpDir, directory of the temporary files, NULL for
+                                   /tmp
+                IN PF_COMPARE pfCompare, callback function to compare two items
+       Output:  NONE
+       Return:  ExtHeap_S*,  the queue struct
+                NULL,        error occured
+      Caution:  uiItemSize should not be 0, pfCompare should not be NULL. The
+                least item by pfCompare is the root, reverse pfCompare to get
+                the max one first. 3/4 of ulMemory keeps the items in memery,
+                each costs uiItemSize and 2 pointers, and the rest is shared
+                by the read ahead buffers of 64 runs. The files are removed
+                once created, so none is left behind even if the process dies
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ExtHeap_S* ExtHeapCreate(IN UINT uiItemSize, IN ULONG ulMemory,
+                         IN CHAR *pcTmpDir,
+                         IN PF_COMPARE pfCompare)
+{
+    ExtHeap_S *pstHeap = NULL;
+    ULONG ulBufMemory = 0;
+    ULONG ulSlots = 0;
+    UINT uiCount = 0;
+
+    if (0 == uiItemSize || NULL == pfCompare)
+    {
+        return NULL;
+    }
+
+    if (NULL == pcTmpDir)
+    {
+        pcTmpDir = "/tmp";
+    }
+
+    ulBufMemory = ulMemory / 4;
+    ulSlots = (ulMemory - ulBufMemory) / (uiItemSize + 2 * sizeof(VOID *));
+    if (0 == ulSlots)
+    {
+        return NULL;
+    }
+    if (ulSlots > EXTHEAP_MEMMAX)
+    {
+        ulSlots = EXTHEAP_MEMMAX;
+    }
+
+    pstHeap = (ExtHeap_S *)malloc(sizeof(ExtHeap_S));
+    if (NULL == pstHeap)
+    {
+        return NULL;
+    }
+    memset(pstHeap, 0, sizeof(ExtHeap_S));
+
+    pstHeap->uiItemSize = uiItemSize;
+    pstHeap->uiMemSize = (UINT)ulSlots;
+    pstHeap->uiBufSize = (UINT)(ulBufMemory / EXTHEAP_BUFS / uiItemSize);
+    if (0 == pstHeap->uiBufSize)
+    {
+        pstHeap->uiBufSize = 1;
+    }
+    pstHeap->pfCompare = pfCompare;
+
+    pstHeap->pcTmpDir = (CHAR *)malloc(strlen(pcTmpDir) + 1);
+    pstHeap->pcSlot = (CHAR *)malloc(ulSlots * uiItemSize);
+    pstHeap->ppvFree = (VOID **)malloc(sizeof(VOID *) * ulSlots);
+    pstHeap->ppstRun = (ExtRun_S **)malloc(sizeof(ExtRun_S *) * EXTHEAP_WAYS);
+    pstHeap->pstMem = HeapCreate(pstHeap->uiMemSize, HEAP_MINI, pfCompare,
+                                 NULL, NULL);
+    pstHeap->pstRun = HeapCreate(EXTHEAP_WAYS, HEAP_MINI, extheap_compare,
+                                 NULL, NULL);
+    if (NULL == pstHeap->pcTmpDir || NULL == pstHeap->pcSlot ||
+        NULL == pstHeap->ppvFree || NULL == pstHeap->ppstRun ||
+        NULL == pstHeap->pstMem || NULL == pstHeap->pstRun ||
+        ERROR_SUCCESS != HeapSetGrow(pstHeap->pstRun, 0))
+    {
+        ExtHeapFree(pstHeap);
+        return NULL;
+    }
+    strcpy(pstHeap->pcTmpDir, pcTmpDir);
+    pstHeap->uiRunSize = EXTHEAP_WAYS;
+
+    /**the first slot is on the top of the stack**/
+    for (uiCount = 0; uiCount < pstHeap->uiMemSize; uiCount++)
+    {
+        pstHeap->ppvFree[pstHeap->uiMemSize - 1 - uiCount] =
+            pstHeap->pcSlot + (ULONG)uiCount * uiItemSize;
+    }
+    pstHeap->uiFree = pstHeap->uiMemSize;
+
+    return pstHeap;
+}
+
+/*******************************************************************************
+    Func Name:  ExtHeapFree
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To free a given queue
+        Input:  IN ExtHeap_S *pstHeap, the queue to be freed
+       Output:  NONE
+       Return:  NONE
+      Caution:  The temporary files are closed and gone
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID ExtHeapFree(IN ExtHeap_S *pstHeap)
+{
+    UINT uiCount = 0;
+
+    if (NULL == pstHeap)
+    {
+        return;
+    }
+
+    for (uiCount = 0; uiCount < pstHeap->uiRuns; uiCount++)
+    {
+        extheap_runfree(pstHeap->ppstRun[uiCount]);
+    }
+    HeapFree(pstHeap->pstMem);
+    HeapFree(pstHeap->pstRun);
+    free(pstHeap->ppstRun);
+    free(pstHeap->ppvFree);
+    free(pstHeap->pcSlot);
+    free(pstHeap->pcTmpDir);
+    free(pstHeap);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  ExtHeapAdd
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add an item to queue
+        Input:  IN ExtHeap_S *pstHeap
+                IN VOID *pvItem, the item to be copied in
+       Output:  OUT ExtHeap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, nothing is added
+      Caution:  costs O(log m) for m items in memery, and a spill of all of
+                them when the memery is full. It fails if the run can't be
+                written, then the items stay in memery. A merge that fails
+                leaves its runs as they were and is tried at the next spill
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG ExtHeapAdd(INOUT ExtHeap_S *pstHeap, IN VOID *pvItem)
+{
+    VOID *pvSlot = NULL;
+    UINT uiLevel = 0;
+
+    if (NULL == pstHeap || NULL == pvItem)
+    {
+        return ERROR_FAILED;
+    }
+
+    if (0 == pstHeap->uiFree)
+    {
+        if (ERROR_SUCCESS != extheap_spill(pstHeap))
+        {
+            return ERROR_FAILED;
+        }
+
+        /**a merge makes a run of the next level, which may fill it up**/
+        for (uiLevel = 0; uiLevel < pstHeap->uiRuns; uiLevel++)
+        {
+            if (ERROR_SUCCESS != extheap_merge(pstHeap, uiLevel))
+            {
+                break;
+            }
+        }
+    }
+
+    pvSlot = pstHeap->ppvFree[--pstHeap->uiFree];
+    memcpy(pvSlot, pvItem, pstHeap->uiItemSize);
+    (VOID)HeapAdd(pstHeap->pstMem, pvSlot);
+    pstHeap->ulNum++;
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  ExtHeapGetRoot
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Copy out the least item without removing it
+        Input:  IN ExtHeap_S *pstHeap
+       Output:  OUT VOID *pvItem, uiItemSize bytes
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, or the queue is empty
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG ExtHeapGetRoot(IN ExtHeap_S *pstHeap, OUT VOID *pvItem)
+{
+    ExtRun_S *pstRun = NULL;
+    VOID *pvLeast = NULL;
+
+    if (NULL == pstHeap || NULL == pvItem)
+    {
+        return ERROR_FAILED;
+    }
+
+    pvLeast = extheap_least(pstHeap, &pstRun);
+    if (NULL == pvLeast)
+    {
+        return ERROR_FAILED;
+    }
+    memcpy(pvItem, pvLeast, pstHeap->uiItemSize);
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  ExtHeapRemoveRoot
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Copy out and remove the least item
+        Input:  IN ExtHeap_S *pstHeap
+       Output:  OUT ExtHeap_S *pstHeap
+                OUT VOID *pvItem, uiItemSize bytes
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, or the queue is empty
+      Caution:  costs O(log m + log r) for m items in memery and r runs, and
+                a read of a block when the head of a run goes out of its
+                buffer. The item is not removed if the read fails
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG ExtHeapRemoveRoot(INOUT ExtHeap_S *pstHeap, OUT VOID *pvItem)
+{
+    ExtRun_S *pstRun = NULL;
+    VOID *pvLeast = NULL;
+
+    if (NULL == pstHeap || NULL == pvItem)
+    {
+        return ERROR_FAILED;
+    }
+
+    pvLeast = extheap_least(pstHeap, &pstRun);
+    if (NULL == pvLeast)
+    {
+        return ERROR_FAILED;
+    }
+    memcpy(pvItem, pvLeast, pstHeap->uiItemSize);
+
+    if (NULL == pstRun)
+    {
+        (VOID)HeapRemoveRoot(pstHeap->pstMem);
+        pstHeap->ppvFree[pstHeap->uiFree++] = pvLeast;
+        pstHeap->ulNum--;
+        return ERROR_SUCCESS;
+    }
+
+    if (ERROR_SUCCESS != extheap_next(pstHeap, pstRun))
+    {
+        return ERROR_FAILED;
+    }
+
+    if (NULL == pstRun->pvHead)
+    {
+        (VOID)HeapRemoveRoot(pstHeap->pstRun);
+        extheap_rundel(pstHeap, pstRun);
+        extheap_runfree(pstRun);
+    }
+    else
+    {
+        (VOID)HeapReplace(pstHeap->pstRun, pstRun);
+    }
+    pstHeap->ulNum--;
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  ExtHeapNumber
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many items in queue
+        Input:  IN ExtHeap_S *pstHeap
+       Output:  NONE
+       Return:  ULONG
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG ExtHeapNumber(IN ExtHeap_S *pstHeap)
+{
+    if (NULL == pstHeap)
+    {
+        return 0;
+    }
+
+    return pstHeap->ulNum;
+}
+
+/*******************************************************************************
+    Func Name:  ExtHeapRuns
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many runs in temporary files
+        Input:  IN ExtHeap_S *pstHeap
+       Output:  NONE
+       Return:  UINT
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT ExtHeapRuns(IN ExtHeap_S *pstHeap)
+{
+    if (NULL == pstHeap)
+    {
+        return 0;
+    }
+
+    return pstHeap->uiRuns;
+}
@@ -25,33 +25,352 @@ Copyright(C):   Huazhong University of Science & Technology.
 #include "../include/heap.h"
 /**module headfiles**/
 
+/**all flags that can be or-ed to uiType**/
+#define HEAP_FLAGS  (HEAP_INDEXED | HEAP_ARITYMASK | HEAP_BLOCKED)
+
+/**places moved to the next memery each time a growing heap is changed**/
+#define HEAP_MOVESTEP  4
+
+/**the largest heap**/
+#define HEAP_SIZEMAX   0x7FFFFFFF
+
+/**an empty bucket of the hash index**/
+#define HEAP_NOPLACE   0xFFFFFFFF
+
+/**places of a HEAP_BLOCKED page, 4KB of pointers**/
+#define HEAP_PAGESHIFT 9
+#define HEAP_PAGE      (1UL << HEAP_PAGESHIFT)
+#define HEAP_PAGEMASK  (HEAP_PAGE - 1)
+
+/**alignment of the memery of places**/
+#define HEAP_ALIGN(uiFlag) \
+    (0 != ((uiFlag) & HEAP_BLOCKED) ? sizeof(VOID *) * HEAP_PAGE : CACHE_LINE)
+
+/*******************************************************************************
+    Func Name:  heap_level
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get the level of a place, the root is on level 0
+        Input:  IN ULONG ulPlace
+       Output:  NONE
+       Return:  UINT
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static inline UINT heap_level(IN ULONG ulPlace)
+{
+    return (UINT)(sizeof(ULONG) * 8 - 1) - (UINT)__builtin_clzl(ulPlace + 1);
+}
+
+/*******************************************************************************
+    Func Name:  heap_toplevel
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get how many levels of HEAP_BLOCKED heap are in the first page
+        Input:  IN UINT uiSize, how many items the memery can store
+       Output:  NONE
+       Return:  UINT, 1 to 9
+      Caution:  The levels below the first page are cut into bands of 9 from
+                the bottom, so the bottom band is always full and the pages
+                of a band are all used
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static inline UINT heap_toplevel(IN UINT uiSize)
+{
+    UINT uiLevels = 0;
+
+    assert(uiSize > 0);
+
+    uiLevels = heap_level(uiSize - 1) + 1;
+
+    return uiLevels - HEAP_PAGESHIFT * ((uiLevels - 1) / HEAP_PAGESHIFT);
+}
+
+/*******************************************************************************
+    Func Name:  heap_blockplace
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get where a place of HEAP_BLOCKED heap is in the memery
+        Input:  IN ULONG ulPlace, place in the complete binary tree
+                IN UINT uiTopLevel, see heap_toplevel
+       Output:  NONE
+       Return:  ULONG, place + 1 in the memery
+      Caution:  The tree stays complete, only its places are laid out in
+                pages. Page 0 holds the top levels as a flat heap from 1.
+                Every band of 9 levels below is cut into subtrees of 511
+                places, each has a page in the order of its root, and a node
+                n of it has children at 2n and 2n + 1 of the page. So a
+                path of 9 levels stays in a page, and two children share a
+                cache line
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static inline ULONG heap_blockplace(IN ULONG ulPlace, IN UINT uiTopLevel)
+{
+    ULONG ulNum = 0;
+    ULONG ulPage = 0;
+    ULONG ulBit = 0;
+    UINT uiLevel = 0;
+    UINT uiBand = 0;
+
+    ulNum = ulPlace + 1;
+    uiLevel = heap_level(ulPlace);
+    if (uiLevel < uiTopLevel)
+    {
+        return ulNum;
+    }
+
+    /**the root of the subtree is uiLevel levels above, and is the
+       (ulNum >> uiLevel) - 2^(uiTopLevel + 9 * uiBand) one on its level. The
+       bands above have 2^uiTopLevel * (2^(9 * uiBand) - 1) / 511 pages**/
+    uiLevel -= uiTopLevel;
+    uiBand = uiLevel / HEAP_PAGESHIFT;
+    uiLevel -= uiBand * HEAP_PAGESHIFT;
+    ulBit = 1UL << uiLevel;
+    ulPage = 1UL << (HEAP_PAGESHIFT * uiBand);
+    ulPage = ((ulPage - 1) / HEAP_PAGEMASK - ulPage) << uiTopLevel;
+    ulPage += (ulNum >> uiLevel) + 1;
+
+    return (ulPage << HEAP_PAGESHIFT) | ulBit | (ulNum & (ulBit - 1));
+}
+
+/*******************************************************************************
+    Func Name:  heap_places
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get how many places of memery a heap takes from the root
+        Input:  IN UINT uiFlag
+                IN UINT uiSize, how many items the memery can store
+       Output:  NONE
+       Return:  UINT
+      Caution:  HEAP_BLOCKED heap takes up to twice as many as uiSize, the
+                last page is the one of the last subtree on the top level of
+                the bottom band
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static inline UINT heap_places(IN UINT uiFlag, IN UINT uiSize)
+{
+    UINT uiLevels = 0;
+    ULONG ulLast = 0;
+
+    if (0 == (uiFlag & HEAP_BLOCKED))
+    {
+        return uiSize;
+    }
+
+    uiLevels = heap_level(uiSize - 1) + 1;
+    if (uiLevels <= HEAP_PAGESHIFT)
+    {
+        return uiSize;
+    }
+
+    ulLast = (1UL << (uiLevels - HEAP_PAGESHIFT + 1)) - 2;
+
+    return (UINT)(heap_blockplace(ulLast, heap_toplevel(uiSize)) |
+                  HEAP_PAGEMASK);
+}
+
+/*******************************************************************************
+    Func Name:  heap_at
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get the memery of a place
+        Input:  IN Heap_S *pstHeap
+                IN VOID **ppvItem, place in the complete binary tree
+       Output:  NONE
+       Return:  VOID**, where the item is stored
+      Caution:  pstHeap and ppvItem should not be NULL. A place is its own
+                memery, except in HEAP_BLOCKED heap, see heap_blockplace. The
+                root is at ppvHeap either way
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static inline VOID** heap_at(IN Heap_S *pstHeap, IN VOID **ppvItem)
+{
+    if (0 == (pstHeap->uiFlag & HEAP_BLOCKED))
+    {
+        return ppvItem;
+    }
+
+    return pstHeap->ppvHeap - 1 +
+           heap_blockplace(ppvItem - pstHeap->ppvHeap, pstHeap->uiTopLevel);
+}
+
+/*******************************************************************************
+    Func Name:  heap_moveone
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Copy a place of the heap to the next memery
+        Input:  IN Heap_S *pstHeap
+                IN UINT uiPlace
+       Output:  OUT Heap_S *pstHeap
+       Return:  NONE
+      Caution:  pstHeap should not be NULL, and the heap should be moving.
+                HEAP_BLOCKED heap of another size lays the places out in
+                other pages
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static inline VOID heap_moveone(INOUT Heap_S *pstHeap, IN UINT uiPlace)
+{
+    VOID **ppvNext = NULL;
+
+    assert(NULL != pstHeap && NULL != pstHeap->ppvNext);
+
+    ppvNext = pstHeap->ppvNext + uiPlace;
+    if (0 != (pstHeap->uiFlag & HEAP_BLOCKED))
+    {
+        ppvNext = pstHeap->ppvNext - 1 +
+                  heap_blockplace(uiPlace, pstHeap->uiNextTopLevel);
+    }
+    *ppvNext = *heap_at(pstHeap, pstHeap->ppvHeap + uiPlace);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  heap_mirror
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Copy a changed place to the next memery if it has been moved
+        Input:  IN Heap_S *pstHeap
+                IN UINT uiPlace, the changed place
+       Output:  NONE
+       Return:  NONE
+      Caution:  pstHeap should not be NULL, and the heap should be moving to
+                the next memery
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static inline VOID heap_mirror(IN Heap_S *pstHeap, IN UINT uiPlace)
+{
+    UINT uiHandle = 0;
+
+    assert(NULL != pstHeap && NULL != pstHeap->ppvNext);
+
+    if (uiPlace < pstHeap->uiMoved)
+    {
+        heap_moveone(pstHeap, uiPlace);
+    }
+
+    if (NULL == pstHeap->puiHandle)
+    {
+        return;
+    }
+
+    uiHandle = pstHeap->puiHandle[uiPlace];
+    if (uiPlace < pstHeap->uiHandleMoved)
+    {
+        pstHeap->puiNextHandle[uiPlace] = uiHandle;
+    }
+    if (uiHandle < pstHeap->uiHandleMoved)
+    {
+        pstHeap->puiNextPlace[uiHandle] = uiPlace;
+    }
+
+    return;
+}
+
 /*******************************************************************************
     Func Name:  heap_swap
  Date Created:  2014-9-17
        Author:  Zhulinfeng
   Description:  exchange to items in heap
-        Input:  INOUT VOID **ppvFirst
+        Input:  IN Heap_S *pstHeap
+                INOUT VOID **ppvFirst
                 INOUT VOID **ppvSecond
        Output:  INOUT VOID **ppvFirst
                 INOUT VOID **ppvSecond
        Return:  NONE
-      Caution:  params should not be NULL
+      Caution:  params should not be NULL, the handles of the two items are 
+                exchanged too if the heap is HEAP_INDEXED, so are their
+                buckets if the heap is indexed by HeapSetHash
 v  ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
   ----------------------------------------------------------------------------
   YYYY-MM-DD      
 *******************************************************************************/
-static inline VOID heap_swap(INOUT VOID **ppvFirst, INOUT VOID **ppvSecond)
+static inline VOID heap_swap(IN Heap_S *pstHeap,
+                             INOUT VOID **ppvFirst, INOUT VOID **ppvSecond)
 {
     VOID *pvTmp = NULL;
+    VOID **ppvFirstAt = NULL;
+    VOID **ppvSecondAt = NULL;
+    UINT uiFirst = 0;
+    UINT uiSecond = 0;
+    UINT uiTmp = 0;
 
+    assert(NULL != pstHeap);
     assert(NULL != ppvFirst && NULL != ppvSecond);
-    assert(NULL != *ppvFirst && NULL != *ppvSecond);
 
-    pvTmp = *ppvFirst;
-    *ppvFirst = *ppvSecond;
-    *ppvSecond = pvTmp;
+    ppvFirstAt = heap_at(pstHeap, ppvFirst);
+    ppvSecondAt = heap_at(pstHeap, ppvSecond);
+    assert(NULL != *ppvFirstAt && NULL != *ppvSecondAt);
+
+    pvTmp = *ppvFirstAt;
+    *ppvFirstAt = *ppvSecondAt;
+    *ppvSecondAt = pvTmp;
+
+    if (NULL == pstHeap->puiHandle && NULL == pstHeap->ppvNext &&
+        NULL == pstHeap->puiEntry)
+    {
+        return;
+    }
+
+    uiFirst = ppvFirst - pstHeap->ppvHeap;
+    uiSecond = ppvSecond - pstHeap->ppvHeap;
+
+    /**the buckets of the two items point to their new places**/
+    if (NULL != pstHeap->puiEntry)
+    {
+        uiTmp = pstHeap->puiEntry[uiFirst];
+        pstHeap->puiEntry[uiFirst] = pstHeap->puiEntry[uiSecond];
+        pstHeap->puiEntry[uiSecond] = uiTmp;
+        pstHeap->puiBucket[pstHeap->puiEntry[uiFirst]] = uiFirst;
+        pstHeap->puiBucket[pstHeap->puiEntry[uiSecond]] = uiSecond;
+    }
+
+    /**keep handle to place map up to date**/
+    if (NULL != pstHeap->puiHandle)
+    {
+        uiTmp = pstHeap->puiHandle[uiFirst];
+        pstHeap->puiHandle[uiFirst] = pstHeap->puiHandle[uiSecond];
+        pstHeap->puiHandle[uiSecond] = uiTmp;
+        pstHeap->puiPlace[pstHeap->puiHandle[uiFirst]] = uiFirst;
+        pstHeap->puiPlace[pstHeap->puiHandle[uiSecond]] = uiSecond;
+    }
+
+    /**the places already moved to the next memery should be changed too**/
+    if (NULL != pstHeap->ppvNext)
+    {
+        heap_mirror(pstHeap, uiFirst);
+        heap_mirror(pstHeap, uiSecond);
+    }
 
     return;
 }
@@ -119,327 +438,2378 @@ static inline BOOL_T heap_isempty(IN Heap_S *pstHeap)
 }
 
 /*******************************************************************************
-    Func Name:  heap_parent
- Date Created:  2014-9-17
-       Author:  Zhulinfeng
-  Description:  Get parent item of an item
-        Input:  IN Heap_S *pstHeap
-                IN VOID **ppvItem
-       Output:  NONE  
-       Return:  VOID**, parent item
-                NULL, root
-      Caution:  pstHeap and pvItem should not be NULL
+    Func Name:  heap_buckets
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get how many buckets the hash index of a heap needs
+        Input:  IN UINT uiSize, how many places the index holds
+       Output:  NONE
+       Return:  UINT, a power of 2 not less than twice uiSize
+      Caution:  The index is at most half full, so the probes are short
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
   ----------------------------------------------------------------------------
   YYYY-MM-DD      
 *******************************************************************************/
-static inline VOID** heap_parent(IN Heap_S *pstHeap, IN VOID **ppvItem)
+static inline UINT heap_buckets(IN UINT uiSize)
 {
-    UINT uiIndex = 0;
-    VOID **ppvRet = NULL;
+    UINT uiRet = 2;
 
-    assert(NULL != pstHeap && NULL != ppvItem);
-    assert(ppvItem >= pstHeap->ppvHeap && ppvItem < pstHeap->ppvTail);
-    assert(NULL != *ppvItem);
-
-    uiIndex = ppvItem - pstHeap->ppvHeap + 1;
-    if (1 == uiIndex)
+    while (uiRet < uiSize * 2)
     {
-      return NULL;
+        uiRet *= 2;
     }
 
-    uiIndex >>= 1;
-    ppvRet = pstHeap->ppvHeap + uiIndex - 1;
-
-    return ppvRet;
+    return uiRet;
 }
 
 /*******************************************************************************
-    Func Name:  heap_left
- Date Created:  2014-9-17
-       Author:  Zhulinfeng
-  Description:  Get left child item of a parent
-        Input:  IN Heap_S *pstHeap
-                IN VOID **ppvItem
-       Output:  NONE  
-       Return:  VOID**, left child item
-                NULL, leave
-      Caution:  pstHeap and pvItem should not be NULL
+    Func Name:  heap_hashlink
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Put a place into the hash index
+        Input:  IN UINT *puiBucket
+                IN ULONG *pulBucketHash
+                IN UINT *puiEntry
+                IN UINT uiMask, buckets - 1
+                IN UINT uiPlace
+                IN ULONG ulHash, hash of the item in the place
+       Output:  OUT UINT *puiBucket
+                OUT ULONG *pulBucketHash
+                OUT UINT *puiEntry
+       Return:  NONE
+      Caution:  params should not be NULL, the index should not be full. It
+                takes the arrays instead of the heap, for the index being
+                built when growing is filled the same way
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
   ----------------------------------------------------------------------------
   YYYY-MM-DD      
 *******************************************************************************/
-static inline VOID** heap_left(IN Heap_S *pstHeap, IN VOID **ppvItem)
+static inline VOID heap_hashlink(INOUT UINT *puiBucket,
+                                 INOUT ULONG *pulBucketHash,
+                                 INOUT UINT *puiEntry, IN UINT uiMask,
+                                 IN UINT uiPlace, IN ULONG ulHash)
 {
-    UINT uiIndex = 0;
-    VOID **ppvRet = NULL;
-
-    assert(NULL != pstHeap && NULL != ppvItem);
-    assert(ppvItem >= pstHeap->ppvHeap && ppvItem < pstHeap->ppvTail);
-    assert(NULL != *ppvItem);
+    UINT uiBucket = 0;
 
-    uiIndex = ppvItem - pstHeap->ppvHeap + 1;
+    assert(NULL != puiBucket && NULL != pulBucketHash && NULL != puiEntry);
 
-    uiIndex <<= 1;
-    ppvRet = pstHeap->ppvHeap + uiIndex - 1;
-
-    if (ppvRet >= pstHeap->ppvTail)
+    uiBucket = (UINT)ulHash & uiMask;
+    while (HEAP_NOPLACE != puiBucket[uiBucket])
     {
-        return NULL;
+        uiBucket = (uiBucket + 1) & uiMask;
     }
 
-    return ppvRet;
+    puiBucket[uiBucket] = uiPlace;
+    pulBucketHash[uiBucket] = ulHash;
+    puiEntry[uiPlace] = uiBucket;
+
+    return;
 }
 
 /*******************************************************************************
-    Func Name:  heap_right
- Date Created:  2014-9-17
-       Author:  Zhulinfeng
-  Description:  Get right child item of a parent
+    Func Name:  heap_hashadd
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Index the item in a place of heap
         Input:  IN Heap_S *pstHeap
-                IN VOID **ppvItem
-       Output:  NONE  
-       Return:  VOID**, right child item
-                NULL, leave
-      Caution:  pstHeap and pvItem should not be NULL
+                IN UINT uiPlace
+       Output:  OUT Heap_S *pstHeap
+       Return:  NONE
+      Caution:  pstHeap should not be NULL, nothing is done if the heap is not
+                indexed by HeapSetHash
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
   ----------------------------------------------------------------------------
   YYYY-MM-DD      
 *******************************************************************************/
-static inline VOID** heap_right(IN Heap_S *pstHeap, IN VOID **ppvItem)
+static inline VOID heap_hashadd(INOUT Heap_S *pstHeap, IN UINT uiPlace)
 {
-    UINT uiIndex = 0;
-    VOID **ppvRet = NULL;
-
-    assert(NULL != pstHeap && NULL != ppvItem);
-    assert(ppvItem >= pstHeap->ppvHeap && ppvItem < pstHeap->ppvTail);
-    assert(NULL != *ppvItem);
-
-    uiIndex = ppvItem - pstHeap->ppvHeap + 1;
-
-    uiIndex <<= 1;
-    uiIndex++;
-    ppvRet = pstHeap->ppvHeap + uiIndex - 1;
+    assert(NULL != pstHeap);
 
-    if (ppvRet >= pstHeap->ppvTail)
+    if (NULL == pstHeap->puiEntry)
     {
-        return NULL;
+        return;
     }
 
-    return ppvRet;
+    assert(uiPlace < pstHeap->uiHashSize);
+
+    heap_hashlink(pstHeap->puiBucket, pstHeap->pulBucketHash,
+                  pstHeap->puiEntry, pstHeap->uiBucketMask, uiPlace,
+                  pstHeap->pfHash(*heap_at(pstHeap,
+                                           pstHeap->ppvHeap + uiPlace)));
+
+    return;
 }
 
 /*******************************************************************************
-    Func Name:  heapify_one
- Date Created:  2014-9-17
-       Author:  Zhulinfeng
-  Description:  Keep heap healthy if one item changed
+    Func Name:  heap_hashdel
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Take the item in a place of heap out of the hash index
         Input:  IN Heap_S *pstHeap
-                IN VOID **ppvItem
-       Output:  OUT Heap_S *pstHeap 
+                IN UINT uiPlace
+       Output:  OUT Heap_S *pstHeap
        Return:  NONE
-      Caution:  pstHeap and pvItem should not be NULL
+      Caution:  pstHeap should not be NULL, nothing is done if the heap is not
+                indexed by HeapSetHash. The buckets behind are shifted back
+                to fill the hole, so no probe stops early at it
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
   ----------------------------------------------------------------------------
   YYYY-MM-DD      
 *******************************************************************************/
-static VOID heapify_one(INOUT Heap_S *pstHeap, IN VOID **ppvItem)
-{ 
-    VOID **ppvParent = NULL;
-    INT iCmpRet = 0;
+static inline VOID heap_hashdel(INOUT Heap_S *pstHeap, IN UINT uiPlace)
+{
+    UINT uiHole = 0;
+    UINT uiNext = 0;
+    UINT uiHome = 0;
+    UINT uiMask = 0;
 
-    assert(NULL != pstHeap && NULL != ppvItem);
-    assert(ppvItem >= pstHeap->ppvHeap && ppvItem < pstHeap->ppvTail);
-    assert(NULL != *ppvItem);
+    assert(NULL != pstHeap);
 
-    ppvParent = heap_parent(pstHeap, ppvItem);
-    while (NULL != ppvParent)
+    if (NULL == pstHeap->puiEntry)
     {
-        iCmpRet = pstHeap->pfCompare(*ppvParent, *ppvItem);
-        if (HEAP_MAXI == pstHeap->uiType && iCmpRet >= 0)
-        {
-            break;
-        }
-        else if (HEAP_MINI == pstHeap->uiType && iCmpRet <= 0)
+        return;
+    }
+
+    uiMask = pstHeap->uiBucketMask;
+    uiHole = pstHeap->puiEntry[uiPlace];
+    assert(uiPlace == pstHeap->puiBucket[uiHole]);
+
+    uiNext = (uiHole + 1) & uiMask;
+    while (HEAP_NOPLACE != pstHeap->puiBucket[uiNext])
+    {
+        /**a bucket can fill the hole if its home is not after the hole**/
+        uiHome = (UINT)pstHeap->pulBucketHash[uiNext] & uiMask;
+        if (((uiNext - uiHome) & uiMask) >= ((uiNext - uiHole) & uiMask))
         {
-            break;
+            pstHeap->puiBucket[uiHole] = pstHeap->puiBucket[uiNext];
+            pstHeap->pulBucketHash[uiHole] = pstHeap->pulBucketHash[uiNext];
+            pstHeap->puiEntry[pstHeap->puiBucket[uiHole]] = uiHole;
+            uiHole = uiNext;
         }
-
-        heap_swap(ppvParent, ppvItem);
-        ppvItem = ppvParent;
-        ppvParent = heap_parent(pstHeap, ppvItem);
+        uiNext = (uiNext + 1) & uiMask;
     }
+    pstHeap->puiBucket[uiHole] = HEAP_NOPLACE;
 
     return;
 }
 
 /*******************************************************************************
-    Func Name:  heapify_all
- Date Created:  2014-9-17
-       Author:  Zhulinfeng
-  Description:  Keep heap healthy if all item changed
+    Func Name:  heap_hashfind
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Look for an item equal to the given one by the hash index
         Input:  IN Heap_S *pstHeap
-       Output:  OUT Heap_S *pstHeap 
-       Return:  NONE
-      Caution:  pstHeap should not be NULL
+                IN VOID *pvItem
+       Output:  NONE
+       Return:  VOID**, place of the item found
+                NULL, not found
+      Caution:  pstHeap and pvItem should not be NULL, and the heap should be
+                indexed by HeapSetHash
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
   ----------------------------------------------------------------------------
   YYYY-MM-DD      
 *******************************************************************************/
-static VOID heapify_all(INOUT Heap_S *pstHeap)
-{ 
-    VOID **ppvCursor = NULL;
+static inline VOID** heap_hashfind(IN Heap_S *pstHeap, IN VOID *pvItem)
+{
+    VOID **ppvPlace = NULL;
+    ULONG ulHash = 0;
+    UINT uiBucket = 0;
 
-    assert(NULL != pstHeap);
+    assert(NULL != pstHeap && NULL != pvItem && NULL != pstHeap->puiEntry);
 
-    if (BOOL_TRUE == heap_isempty(pstHeap))
+    ulHash = pstHeap->pfHash(pvItem);
+    uiBucket = (UINT)ulHash & pstHeap->uiBucketMask;
+    while (HEAP_NOPLACE != pstHeap->puiBucket[uiBucket])
+    {
+        ppvPlace = pstHeap->ppvHeap + pstHeap->puiBucket[uiBucket];
+        if (ulHash == pstHeap->pulBucketHash[uiBucket] &&
+            0 == pstHeap->pfCompare(*heap_at(pstHeap, ppvPlace), pvItem))
+        {
+            return ppvPlace;
+        }
+        uiBucket = (uiBucket + 1) & pstHeap->uiBucketMask;
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+    Func Name:  heap_movestart
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get the next memery ready for the heap to grow or shrink into
+        Input:  IN Heap_S *pstHeap
+                IN UINT uiNextSize, how many items the next memery can store
+       Output:  OUT Heap_S *pstHeap 
+       Return:  NONE
+      Caution:  pstHeap should not be NULL, nothing is done if there's no 
+                memery. The next memery is not initialized here, its places
+                are filled a few a time by heap_move
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static VOID heap_movestart(INOUT Heap_S *pstHeap, IN UINT uiNextSize)
+{
+    VOID **ppvNextBase = NULL;
+    UINT uiPad = 0;
+
+    assert(NULL != pstHeap && NULL == pstHeap->ppvNext);
+
+    uiPad = pstHeap->ppvHeap - pstHeap->ppvBase;
+    if (0 != posix_memalign((VOID **)&ppvNextBase,
+                            HEAP_ALIGN(pstHeap->uiFlag),
+                            sizeof(VOID *) *
+                            (heap_places(pstHeap->uiFlag, uiNextSize) + uiPad)))
+    {
+        return;
+    }
+
+    if (NULL != pstHeap->puiHandle)
+    {
+        pstHeap->puiNextHandle = (UINT *)malloc(sizeof(UINT) * uiNextSize);
+        pstHeap->puiNextPlace = (UINT *)malloc(sizeof(UINT) * uiNextSize);
+        if (NULL == pstHeap->puiNextHandle || NULL == pstHeap->puiNextPlace)
+        {
+            free(pstHeap->puiNextHandle);
+            free(pstHeap->puiNextPlace);
+            pstHeap->puiNextHandle = NULL;
+            pstHeap->puiNextPlace = NULL;
+            free(ppvNextBase);
+            return;
+        }
+    }
+
+    /**the index is rebuilt bigger when the heap switches to the next memery,
+       allocate it here for there's no way to fail then**/
+    if (NULL != pstHeap->puiEntry && uiNextSize > pstHeap->uiHashSize)
+    {
+        pstHeap->uiNextBucketMask = heap_buckets(uiNextSize) - 1;
+        pstHeap->puiNextBucket = (UINT *)malloc(sizeof(UINT) *
+                                 (pstHeap->uiNextBucketMask + 1));
+        pstHeap->pulNextBucketHash = (ULONG *)malloc(sizeof(ULONG) *
+                                     (pstHeap->uiNextBucketMask + 1));
+        pstHeap->puiNextEntry = (UINT *)malloc(sizeof(UINT) * uiNextSize);
+        if (NULL == pstHeap->puiNextBucket ||
+            NULL == pstHeap->pulNextBucketHash ||
+            NULL == pstHeap->puiNextEntry)
+        {
+            free(pstHeap->puiNextBucket);
+            free(pstHeap->pulNextBucketHash);
+            free(pstHeap->puiNextEntry);
+            pstHeap->puiNextBucket = NULL;
+            pstHeap->pulNextBucketHash = NULL;
+            pstHeap->puiNextEntry = NULL;
+            free(pstHeap->puiNextHandle);
+            free(pstHeap->puiNextPlace);
+            pstHeap->puiNextHandle = NULL;
+            pstHeap->puiNextPlace = NULL;
+            free(ppvNextBase);
+            return;
+        }
+    }
+
+    pstHeap->uiNextSize = uiNextSize;
+    pstHeap->uiNextTopLevel = heap_toplevel(uiNextSize);
+    pstHeap->ppvNextBase = ppvNextBase;
+    pstHeap->ppvNext = ppvNextBase + uiPad;
+    pstHeap->uiMoved = 0;
+    pstHeap->uiHandleMoved = 0;
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  heap_hashmove
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Switch the hash index of a heap to the bigger one
+        Input:  IN Heap_S *pstHeap
+       Output:  OUT Heap_S *pstHeap
+       Return:  NONE
+      Caution:  pstHeap should not be NULL, and the bigger index should be
+                allocated. Costs O(n), the hashes are taken from the buckets
+                instead of calling PF_HASH
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static VOID heap_hashmove(INOUT Heap_S *pstHeap)
+{
+    UINT uiNum = 0;
+    UINT uiCount = 0;
+
+    assert(NULL != pstHeap && NULL != pstHeap->puiNextEntry);
+
+    for (uiCount = 0; uiCount <= pstHeap->uiNextBucketMask; uiCount++)
+    {
+        pstHeap->puiNextBucket[uiCount] = HEAP_NOPLACE;
+    }
+
+    uiNum = pstHeap->ppvTail - pstHeap->ppvHeap;
+    for (uiCount = 0; uiCount < uiNum; uiCount++)
+    {
+        heap_hashlink(pstHeap->puiNextBucket, pstHeap->pulNextBucketHash,
+                      pstHeap->puiNextEntry, pstHeap->uiNextBucketMask,
+                      uiCount,
+                      pstHeap->pulBucketHash[pstHeap->puiEntry[uiCount]]);
+    }
+
+    free(pstHeap->puiBucket);
+    free(pstHeap->pulBucketHash);
+    free(pstHeap->puiEntry);
+    pstHeap->puiBucket = pstHeap->puiNextBucket;
+    pstHeap->pulBucketHash = pstHeap->pulNextBucketHash;
+    pstHeap->puiEntry = pstHeap->puiNextEntry;
+    pstHeap->uiBucketMask = pstHeap->uiNextBucketMask;
+    pstHeap->uiHashSize = pstHeap->uiSize;
+
+    pstHeap->puiNextBucket = NULL;
+    pstHeap->pulNextBucketHash = NULL;
+    pstHeap->puiNextEntry = NULL;
+    pstHeap->uiNextBucketMask = 0;
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  heap_moveend
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Switch the heap to the next memery after all places moved
+        Input:  IN Heap_S *pstHeap
+       Output:  OUT Heap_S *pstHeap 
+       Return:  NONE
+      Caution:  pstHeap should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static VOID heap_moveend(INOUT Heap_S *pstHeap)
+{
+    UINT uiNum = 0;
+
+    assert(NULL != pstHeap && NULL != pstHeap->ppvNext);
+
+    uiNum = pstHeap->ppvTail - pstHeap->ppvHeap;
+
+    free(pstHeap->ppvBase);
+    pstHeap->ppvBase = pstHeap->ppvNextBase;
+    pstHeap->ppvHeap = pstHeap->ppvNext;
+    pstHeap->ppvTail = pstHeap->ppvNext + uiNum;
+    pstHeap->uiSize = pstHeap->uiNextSize;
+    pstHeap->uiTopLevel = pstHeap->uiNextTopLevel;
+
+    if (NULL != pstHeap->puiHandle)
+    {
+        free(pstHeap->puiHandle);
+        free(pstHeap->puiPlace);
+        pstHeap->puiHandle = pstHeap->puiNextHandle;
+        pstHeap->puiPlace = pstHeap->puiNextPlace;
+    }
+
+    if (NULL != pstHeap->puiNextEntry)
+    {
+        heap_hashmove(pstHeap);
+    }
+
+    pstHeap->ppvNextBase = NULL;
+    pstHeap->ppvNext = NULL;
+    pstHeap->puiNextHandle = NULL;
+    pstHeap->puiNextPlace = NULL;
+    pstHeap->uiNextSize = 0;
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  heap_move
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Move some places of the heap to the next memery, and switch to
+                the next memery if all places are moved
+        Input:  IN Heap_S *pstHeap
+                IN UINT uiSteps, how many places to move at most, 0 for all
+       Output:  OUT Heap_S *pstHeap 
+       Return:  NONE
+      Caution:  pstHeap should not be NULL, the heap should be moving. Only 
+                the places of items are moved, while the handle maps are 
+                moved as a whole, the free handles of a growing heap are set
+                up at the same pace
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static VOID heap_move(INOUT Heap_S *pstHeap, IN UINT uiSteps)
+{
+    UINT uiNum = 0;
+    UINT uiCount = 0;
+    UINT uiIndex = 0;
+
+    assert(NULL != pstHeap && NULL != pstHeap->ppvNext);
+
+    uiNum = pstHeap->ppvTail - pstHeap->ppvHeap;
+    assert(uiNum <= pstHeap->uiNextSize);
+
+    for (uiCount = 0; pstHeap->uiMoved < uiNum; uiCount++)
+    {
+        if (0 != uiSteps && uiCount >= uiSteps)
+        {
+            break;
+        }
+        uiIndex = pstHeap->uiMoved;
+        heap_moveone(pstHeap, uiIndex);
+        pstHeap->uiMoved++;
+    }
+
+    /**the handles are twice as many as the items to move**/
+    for (uiCount = 0; NULL != pstHeap->puiHandle &&
+                      pstHeap->uiHandleMoved < pstHeap->uiNextSize; uiCount++)
+    {
+        if (0 != uiSteps && uiCount >= 2 * uiSteps)
+        {
+            break;
+        }
+        uiIndex = pstHeap->uiHandleMoved;
+        if (uiIndex < pstHeap->uiSize)
+        {
+            pstHeap->puiNextHandle[uiIndex] = pstHeap->puiHandle[uiIndex];
+            pstHeap->puiNextPlace[uiIndex] = pstHeap->puiPlace[uiIndex];
+        }
+        else
+        {
+            pstHeap->puiNextHandle[uiIndex] = uiIndex;
+            pstHeap->puiNextPlace[uiIndex] = uiIndex;
+        }
+        pstHeap->uiHandleMoved++;
+    }
+
+    if (pstHeap->uiMoved < uiNum)
+    {
+        return;
+    }
+    if (NULL != pstHeap->puiHandle &&
+        pstHeap->uiHandleMoved < pstHeap->uiNextSize)
+    {
+        return;
+    }
+
+    heap_moveend(pstHeap);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  heap_adjust
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Grow or shrink a HeapSetGrow heap step by step, called before
+                an item is added and after an item is removed
+        Input:  IN Heap_S *pstHeap
+       Output:  OUT Heap_S *pstHeap 
+       Return:  NONE
+      Caution:  pstHeap should not be NULL. A heap starts growing when it is 
+                3/4 full, and moves HEAP_MOVESTEP places each time, so it 
+                has switched to the double memery before it is full
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static VOID heap_adjust(INOUT Heap_S *pstHeap)
+{
+    UINT uiNum = 0;
+
+    assert(NULL != pstHeap);
+
+    if (BOOL_TRUE != pstHeap->bGrow)
+    {
+        return;
+    }
+
+    uiNum = pstHeap->ppvTail - pstHeap->ppvHeap;
+    if (NULL == pstHeap->ppvNext)
+    {
+        if (uiNum >= pstHeap->uiSize - pstHeap->uiSize / 4 &&
+            pstHeap->uiSize <= HEAP_SIZEMAX / 2)
+        {
+            heap_movestart(pstHeap, pstHeap->uiSize * 2);
+        }
+        else if (0 != pstHeap->uiShrink && NULL == pstHeap->puiHandle &&
+                 uiNum < pstHeap->uiSize / pstHeap->uiShrink &&
+                 pstHeap->uiSize / 2 >= pstHeap->uiMinSize)
+        {
+            heap_movestart(pstHeap, pstHeap->uiSize / 2);
+        }
+
+        if (NULL == pstHeap->ppvNext)
+        {
+            return;
+        }
+    }
+
+    /**places behind the tail are useless, an item added there is new**/
+    if (pstHeap->uiMoved > uiNum)
+    {
+        pstHeap->uiMoved = uiNum;
+    }
+
+    heap_move(pstHeap, HEAP_MOVESTEP);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  heap_grow
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Grow a HeapSetGrow heap at once to store a number of items
+        Input:  IN Heap_S *pstHeap
+                IN UINT uiNum, how many items to store
+       Output:  OUT Heap_S *pstHeap 
+       Return:  NONE
+      Caution:  pstHeap should not be NULL, the heap may still be too small
+                if there's no memery. It costs O(n), only for a batch that
+                can't fit the memery
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static VOID heap_grow(INOUT Heap_S *pstHeap, IN UINT uiNum)
+{
+    UINT uiNextSize = 0;
+
+    assert(NULL != pstHeap && BOOL_TRUE == pstHeap->bGrow);
+
+    if (NULL != pstHeap->ppvNext)
+    {
+        heap_move(pstHeap, 0);
+    }
+
+    uiNextSize = pstHeap->uiSize;
+    while (uiNextSize < uiNum && uiNextSize <= HEAP_SIZEMAX / 2)
+    {
+        uiNextSize *= 2;
+    }
+
+    if (uiNextSize < uiNum)
     {
         return;
     }
 
-    ppvCursor = pstHeap->ppvTail - 1;
-    while (ppvCursor >= pstHeap->ppvHeap)
+    heap_movestart(pstHeap, uiNextSize);
+    if (NULL != pstHeap->ppvNext)
+    {
+        heap_move(pstHeap, 0);
+    }
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  heap_room
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Make room for an item to be added
+        Input:  IN Heap_S *pstHeap
+       Output:  OUT Heap_S *pstHeap 
+       Return:  BOOL_T
+                BOOL_TRUE, there's room for an item
+                BOOL_FALSE, the heap is full
+      Caution:  pstHeap should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static inline BOOL_T heap_room(INOUT Heap_S *pstHeap)
+{
+    assert(NULL != pstHeap);
+
+    heap_adjust(pstHeap);
+
+    /**it hardly happens, unless the heap is too small to move step by step**/
+    if (BOOL_TRUE == heap_isfull(pstHeap) && NULL != pstHeap->ppvNext)
+    {
+        heap_move(pstHeap, 0);
+    }
+
+    if (BOOL_TRUE == heap_isfull(pstHeap))
+    {
+        return BOOL_FALSE;
+    }
+
+    return BOOL_TRUE;
+}
+
+/*******************************************************************************
+    Func Name:  heap_limit
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get how many items a heap can store without growing
+        Input:  IN Heap_S *pstHeap
+       Output:  NONE
+       Return:  UINT
+      Caution:  pstHeap should not be NULL. While the items are being moved to
+                the next memery, all of them must fit both the memeries, the
+                next one is smaller if the heap is shrinking
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static inline UINT heap_limit(IN Heap_S *pstHeap)
+{
+    assert(NULL != pstHeap);
+
+    if (NULL != pstHeap->ppvNext && pstHeap->uiNextSize < pstHeap->uiSize)
+    {
+        return pstHeap->uiNextSize;
+    }
+
+    return pstHeap->uiSize;
+}
+
+/*******************************************************************************
+    Func Name:  heap_log2
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get the floor of log2 of a number
+        Input:  IN UINT uiNum
+       Output:  NONE
+       Return:  UINT
+      Caution:  returns 0 if uiNum is 0
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static inline UINT heap_log2(IN UINT uiNum)
+{
+    UINT uiRet = 0;
+
+    while (uiNum > 1)
+    {
+        uiNum >>= 1;
+        uiRet++;
+    }
+
+    return uiRet;
+}
+
+/*******************************************************************************
+    Func Name:  heap_parent
+ Date Created:  2014-9-17
+       Author:  Zhulinfeng
+  Description:  Get parent item of an item
+        Input:  IN Heap_S *pstHeap
+                IN VOID **ppvItem
+       Output:  NONE  
+       Return:  VOID**, parent item
+                NULL, root
+      Caution:  pstHeap and pvItem should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static inline VOID** heap_parent(IN Heap_S *pstHeap, IN VOID **ppvItem)
+{
+    ULONG ulIndex = 0;
+    VOID **ppvRet = NULL;
+
+    assert(NULL != pstHeap && NULL != ppvItem);
+    assert(ppvItem >= pstHeap->ppvHeap && ppvItem < pstHeap->ppvTail);
+    assert(NULL != *heap_at(pstHeap, ppvItem));
+
+    ulIndex = ppvItem - pstHeap->ppvHeap;
+    if (0 == ulIndex)
+    {
+      return NULL;
+    }
+
+    ulIndex = (ulIndex - 1) >> pstHeap->uiShift;
+    ppvRet = pstHeap->ppvHeap + ulIndex;
+
+    return ppvRet;
+}
+
+/*******************************************************************************
+    Func Name:  heap_left
+ Date Created:  2014-9-17
+       Author:  Zhulinfeng
+  Description:  Get left most child item of a parent
+        Input:  IN Heap_S *pstHeap
+                IN VOID **ppvItem
+       Output:  NONE  
+       Return:  VOID**, left most child item
+                NULL, leave
+      Caution:  pstHeap and pvItem should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static inline VOID** heap_left(IN Heap_S *pstHeap, IN VOID **ppvItem)
+{
+    ULONG ulIndex = 0;
+    VOID **ppvRet = NULL;
+
+    assert(NULL != pstHeap && NULL != ppvItem);
+    assert(ppvItem >= pstHeap->ppvHeap && ppvItem < pstHeap->ppvTail);
+    assert(NULL != *heap_at(pstHeap, ppvItem));
+
+    ulIndex = ppvItem - pstHeap->ppvHeap;
+    ulIndex = (ulIndex << pstHeap->uiShift) + 1;
+    if (ulIndex >= (ULONG)(pstHeap->ppvTail - pstHeap->ppvHeap))
+    {
+        return NULL;
+    }
+
+    ppvRet = pstHeap->ppvHeap + ulIndex;
+
+    return ppvRet;
+}
+
+/**take the candidate if it's prior to the best child by now**/
+#define HEAP_PICK(pstHeap, ppvBest, ppvCandidate) \
+    do \
+    { \
+        INT iPick = (pstHeap)->pfCompare(*heap_at((pstHeap), (ppvCandidate)), \
+                                         *heap_at((pstHeap), (ppvBest))); \
+        if ((HEAP_MAXI == (pstHeap)->uiType && iPick > 0) || \
+            (HEAP_MINI == (pstHeap)->uiType && iPick < 0)) \
+        { \
+            (ppvBest) = (ppvCandidate); \
+        } \
+    } while (0)
+
+/*******************************************************************************
+    Func Name:  heap_best
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get the prior most one of the children of a parent
+        Input:  IN Heap_S *pstHeap
+                IN VOID **ppvLeft, the left most child
+       Output:  NONE  
+       Return:  VOID**, the prior most child
+      Caution:  pstHeap and ppvLeft should not be NULL, the children are in
+                a row, so the scan is unrolled
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static inline VOID** heap_best(IN Heap_S *pstHeap, IN VOID **ppvLeft)
+{
+    VOID **ppvBest = NULL;
+    ULONG ulNum = 0;
+
+    assert(NULL != pstHeap && NULL != ppvLeft);
+    assert(ppvLeft > pstHeap->ppvHeap && ppvLeft < pstHeap->ppvTail);
+
+    ulNum = pstHeap->ppvTail - ppvLeft;
+    if (ulNum > (1UL << pstHeap->uiShift))
+    {
+        ulNum = 1UL << pstHeap->uiShift;
+    }
+
+    ppvBest = ppvLeft;
+    switch (ulNum)
+    {
+        case 8:
+            HEAP_PICK(pstHeap, ppvBest, ppvLeft + 7);
+            /* fall through */
+        case 7:
+            HEAP_PICK(pstHeap, ppvBest, ppvLeft + 6);
+            /* fall through */
+        case 6:
+            HEAP_PICK(pstHeap, ppvBest, ppvLeft + 5);
+            /* fall through */
+        case 5:
+            HEAP_PICK(pstHeap, ppvBest, ppvLeft + 4);
+            /* fall through */
+        case 4:
+            HEAP_PICK(pstHeap, ppvBest, ppvLeft + 3);
+            /* fall through */
+        case 3:
+            HEAP_PICK(pstHeap, ppvBest, ppvLeft + 2);
+            /* fall through */
+        case 2:
+            HEAP_PICK(pstHeap, ppvBest, ppvLeft + 1);
+            /* fall through */
+        default:
+            break;
+    }
+
+    return ppvBest;
+}
+
+/*******************************************************************************
+    Func Name:  minmax_ismin
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Exame whether a place is on a minimal level of HEAP_MINMAX heap
+        Input:  IN Heap_S *pstHeap
+                IN VOID **ppvItem
+       Output:  NONE
+       Return:  BOOL_T
+                BOOL_TRUE, the place is on a minimal level
+                BOOL_FALSE, the place is on a maximum level
+      Caution:  pstHeap and ppvItem should not be NULL, the root is on level 0,
+                the even levels are minimal ones
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static inline BOOL_T minmax_ismin(IN Heap_S *pstHeap, IN VOID **ppvItem)
+{
+    UINT uiLevel = 0;
+
+    assert(NULL != pstHeap && NULL != ppvItem);
+    assert(ppvItem >= pstHeap->ppvHeap && ppvItem < pstHeap->ppvTail);
+
+    uiLevel = heap_log2((UINT)(ppvItem - pstHeap->ppvHeap) + 1);
+    if (0 == (uiLevel & 1))
+    {
+        return BOOL_TRUE;
+    }
+
+    return BOOL_FALSE;
+}
+
+/**whether the first item should be above the second one on a minimal level
+   if bMin is BOOL_TRUE, or on a maximum level if not**/
+#define MINMAX_PRIOR(pstHeap, pvFirst, pvSecond, bMin) \
+    (BOOL_TRUE == (bMin) ? \
+     (pstHeap)->pfCompare((pvFirst), (pvSecond)) < 0 : \
+     (pstHeap)->pfCompare((pvFirst), (pvSecond)) > 0)
+
+/*******************************************************************************
+    Func Name:  minmax_climb
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Push an item of HEAP_MINMAX heap up through the grandparents,
+                which are on the same kind of levels as it
+        Input:  IN Heap_S *pstHeap
+                IN VOID **ppvItem
+                IN BOOL_T bMin, whether the item is on a minimal level
+       Output:  OUT Heap_S *pstHeap 
+       Return:  BOOL_T
+                BOOL_TRUE, the item is moved
+                BOOL_FALSE, the item stays
+      Caution:  pstHeap and ppvItem should not be NULL, the item should not be
+                on the wrong side of its parent
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static BOOL_T minmax_climb(INOUT Heap_S *pstHeap, IN VOID **ppvItem,
+                           IN BOOL_T bMin)
+{
+    VOID **ppvGrand = NULL;
+    BOOL_T bRet = BOOL_FALSE;
+
+    assert(NULL != pstHeap && NULL != ppvItem);
+
+    ppvGrand = heap_parent(pstHeap, ppvItem);
+    if (NULL != ppvGrand)
+    {
+        ppvGrand = heap_parent(pstHeap, ppvGrand);
+    }
+    while (NULL != ppvGrand && MINMAX_PRIOR(pstHeap, *ppvItem, *ppvGrand, bMin))
+    {
+        heap_swap(pstHeap, ppvGrand, ppvItem);
+        ppvItem = ppvGrand;
+        bRet = BOOL_TRUE;
+
+        ppvGrand = heap_parent(pstHeap, ppvItem);
+        if (NULL != ppvGrand)
+        {
+            ppvGrand = heap_parent(pstHeap, ppvGrand);
+        }
+    }
+
+    return bRet;
+}
+
+/*******************************************************************************
+    Func Name:  minmax_down
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Push an item of HEAP_MINMAX heap down until no child or 
+                grandchild is prior to it
+        Input:  IN Heap_S *pstHeap
+                IN VOID **ppvItem
+       Output:  OUT Heap_S *pstHeap 
+       Return:  NONE
+      Caution:  pstHeap and ppvItem should not be NULL, the subtrees of the
+                item should be healthy
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static VOID minmax_down(INOUT Heap_S *pstHeap, IN VOID **ppvItem)
+{
+    VOID **ppvChild = NULL;
+    VOID **ppvGrand = NULL;
+    VOID **ppvBest = NULL;
+    VOID **ppvParent = NULL;
+    UINT uiCount = 0;
+    BOOL_T bMin = BOOL_FALSE;
+
+    assert(NULL != pstHeap && NULL != ppvItem);
+
+    bMin = minmax_ismin(pstHeap, ppvItem);
+    ppvChild = heap_left(pstHeap, ppvItem);
+    while (NULL != ppvChild)
+    {
+        /**the 2 children and then the 4 grandchildren are in a row**/
+        ppvBest = ppvChild;
+        if (ppvChild + 1 < pstHeap->ppvTail &&
+            MINMAX_PRIOR(pstHeap, ppvChild[1], *ppvBest, bMin))
+        {
+            ppvBest = ppvChild + 1;
+        }
+        ppvGrand = heap_left(pstHeap, ppvChild);
+        for (uiCount = 0; NULL != ppvGrand && uiCount < 4; uiCount++)
+        {
+            if (ppvGrand + uiCount >= pstHeap->ppvTail)
+            {
+                break;
+            }
+            if (MINMAX_PRIOR(pstHeap, ppvGrand[uiCount], *ppvBest, bMin))
+            {
+                ppvBest = ppvGrand + uiCount;
+            }
+        }
+
+        if (!MINMAX_PRIOR(pstHeap, *ppvBest, *ppvItem, bMin))
+        {
+            break;
+        }
+        heap_swap(pstHeap, ppvItem, ppvBest);
+
+        /**a child is on the other kind of level, it's a leaf**/
+        if (ppvBest - ppvChild < 2)
+        {
+            break;
+        }
+
+        /**the item may be on the wrong side of its new parent**/
+        ppvParent = heap_parent(pstHeap, ppvBest);
+        if (MINMAX_PRIOR(pstHeap, *ppvParent, *ppvBest, bMin))
+        {
+            heap_swap(pstHeap, ppvParent, ppvBest);
+        }
+
+        ppvItem = ppvBest;
+        ppvChild = heap_left(pstHeap, ppvItem);
+    }
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  minmax_fix
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Keep HEAP_MINMAX heap healthy if one item changed
+        Input:  IN Heap_S *pstHeap
+                IN VOID **ppvItem
+       Output:  OUT Heap_S *pstHeap 
+       Return:  NONE
+      Caution:  pstHeap and ppvItem should not be NULL. If the item is on the
+                wrong side of its parent, they're exchanged, the item climbs 
+                the parent's kind of levels and the parent goes down, else the
+                item climbs its own kind of levels or goes down. Costs O(log n)
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static VOID minmax_fix(INOUT Heap_S *pstHeap, IN VOID **ppvItem)
+{
+    VOID **ppvParent = NULL;
+    BOOL_T bMin = BOOL_FALSE;
+
+    assert(NULL != pstHeap && NULL != ppvItem);
+
+    bMin = minmax_ismin(pstHeap, ppvItem);
+    ppvParent = heap_parent(pstHeap, ppvItem);
+    if (NULL != ppvParent && MINMAX_PRIOR(pstHeap, *ppvParent, *ppvItem, bMin))
+    {
+        heap_swap(pstHeap, ppvParent, ppvItem);
+        (VOID)minmax_climb(pstHeap, ppvParent,
+                           (BOOL_TRUE == bMin) ? BOOL_FALSE : BOOL_TRUE);
+        minmax_down(pstHeap, ppvItem);
+        return;
+    }
+
+    if (BOOL_TRUE != minmax_climb(pstHeap, ppvItem, bMin))
+    {
+        minmax_down(pstHeap, ppvItem);
+    }
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  heapify_one
+ Date Created:  2014-9-17
+       Author:  Zhulinfeng
+  Description:  Keep heap healthy if one item changed
+        Input:  IN Heap_S *pstHeap
+                IN VOID **ppvItem
+       Output:  OUT Heap_S *pstHeap 
+       Return:  NONE
+      Caution:  pstHeap and pvItem should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static VOID heapify_one(INOUT Heap_S *pstHeap, IN VOID **ppvItem)
+{ 
+    VOID **ppvParent = NULL;
+    INT iCmpRet = 0;
+
+    assert(NULL != pstHeap && NULL != ppvItem);
+    assert(ppvItem >= pstHeap->ppvHeap && ppvItem < pstHeap->ppvTail);
+    assert(NULL != *heap_at(pstHeap, ppvItem));
+
+    if (HEAP_MINMAX == pstHeap->uiType)
+    {
+        minmax_fix(pstHeap, ppvItem);
+        return;
+    }
+
+    ppvParent = heap_parent(pstHeap, ppvItem);
+    while (NULL != ppvParent)
+    {
+        iCmpRet = pstHeap->pfCompare(*heap_at(pstHeap, ppvParent),
+                                     *heap_at(pstHeap, ppvItem));
+        if (HEAP_MAXI == pstHeap->uiType && iCmpRet >= 0)
+        {
+            break;
+        }
+        else if (HEAP_MINI == pstHeap->uiType && iCmpRet <= 0)
+        {
+            break;
+        }
+
+        heap_swap(pstHeap, ppvParent, ppvItem);
+        ppvItem = ppvParent;
+        ppvParent = heap_parent(pstHeap, ppvItem);
+    }
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  heapify_down
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Keep heap healthy if one item is put in a place higher than
+                it should be, push it down until no child is prior to it
+        Input:  IN Heap_S *pstHeap
+                IN VOID **ppvItem
+       Output:  OUT Heap_S *pstHeap 
+       Return:  NONE
+      Caution:  pstHeap and pvItem should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static VOID heapify_down(INOUT Heap_S *pstHeap, IN VOID **ppvItem)
+{ 
+    VOID **ppvChild = NULL;
+    INT iCmpRet = 0;
+
+    assert(NULL != pstHeap && NULL != ppvItem);
+    assert(ppvItem >= pstHeap->ppvHeap && ppvItem < pstHeap->ppvTail);
+    assert(NULL != *heap_at(pstHeap, ppvItem));
+
+    if (HEAP_MINMAX == pstHeap->uiType)
+    {
+        minmax_down(pstHeap, ppvItem);
+        return;
+    }
+
+    ppvChild = heap_left(pstHeap, ppvItem);
+    while (NULL != ppvChild)
+    {
+        ppvChild = heap_best(pstHeap, ppvChild);
+
+        iCmpRet = pstHeap->pfCompare(*heap_at(pstHeap, ppvItem),
+                                     *heap_at(pstHeap, ppvChild));
+        if (HEAP_MAXI == pstHeap->uiType && iCmpRet >= 0)
+        {
+            break;
+        }
+        else if (HEAP_MINI == pstHeap->uiType && iCmpRet <= 0)
+        {
+            break;
+        }
+
+        heap_swap(pstHeap, ppvItem, ppvChild);
+        ppvItem = ppvChild;
+        ppvChild = heap_left(pstHeap, ppvItem);
+    }
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  heapify_all
+ Date Created:  2014-9-17
+       Author:  Zhulinfeng
+  Description:  Keep heap healthy if all item changed
+        Input:  IN Heap_S *pstHeap
+       Output:  OUT Heap_S *pstHeap 
+       Return:  NONE
+      Caution:  pstHeap should not be NULL, it's floyd's bottom-up build, 
+                sifts every parent down from the last one to the root, costs
+                O(n)
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static VOID heapify_all(INOUT Heap_S *pstHeap)
+{ 
+    VOID **ppvCursor = NULL;
+
+    assert(NULL != pstHeap);
+
+    if (pstHeap->ppvTail - pstHeap->ppvHeap < 2)
+    {
+        return;
+    }
+
+    ppvCursor = heap_parent(pstHeap, pstHeap->ppvTail - 1);
+    while (ppvCursor >= pstHeap->ppvHeap)
+    {
+        heapify_down(pstHeap, ppvCursor);
+        ppvCursor--;
+    }
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  heap_checkitems
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Exame whether all items of an array can be put into heap
+        Input:  IN VOID **ppvItems
+                IN UINT uiNum
+       Output:  NONE
+       Return:  BOOL_T
+                BOOL_TRUE, all items are valid
+                BOOL_FALSE, there's NULL item
+      Caution:  ppvItems should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static inline BOOL_T heap_checkitems(IN VOID **ppvItems, IN UINT uiNum)
+{
+    UINT uiCount = 0;
+
+    assert(NULL != ppvItems);
+
+    for (uiCount = 0; uiCount < uiNum; uiCount++)
+    {
+        if (NULL == ppvItems[uiCount])
+        {
+            return BOOL_FALSE;
+        }
+    }
+
+    return BOOL_TRUE;
+}
+
+/*******************************************************************************
+    Func Name:  heap_append
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Copy items behind the tail of heap
+        Input:  IN Heap_S *pstHeap
+                IN VOID **ppvItems
+                IN UINT uiNum, how many items in ppvItems
+       Output:  OUT Heap_S *pstHeap
+       Return:  NONE
+      Caution:  params should not be NULL and the items should fit the heap.
+                The items are not sifted or indexed. HEAP_BLOCKED heap puts
+                them one by one into their pages
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static inline VOID heap_append(INOUT Heap_S *pstHeap,
+                               IN VOID **ppvItems, IN UINT uiNum)
+{
+    UINT uiCount = 0;
+
+    assert(NULL != pstHeap && NULL != ppvItems);
+    assert(pstHeap->ppvTail - pstHeap->ppvHeap + uiNum <= pstHeap->uiSize);
+
+    if (0 == (pstHeap->uiFlag & HEAP_BLOCKED))
+    {
+        memcpy(pstHeap->ppvTail, ppvItems, sizeof(VOID *) * uiNum);
+        pstHeap->ppvTail += uiNum;
+        return;
+    }
+
+    for (uiCount = 0; uiCount < uiNum; uiCount++)
+    {
+        *heap_at(pstHeap, pstHeap->ppvTail) = ppvItems[uiCount];
+        pstHeap->ppvTail++;
+    }
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  heap_delete
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Delete the item at a given place, fill the hole with the tail
+                item and sift it up or down to keep heap healthy
+        Input:  IN Heap_S *pstHeap
+                IN VOID **ppvItem, place of the item to be deleted
+       Output:  OUT Heap_S *pstHeap 
+       Return:  VOID*, the item deleted
+      Caution:  pstHeap and pvItem should not be NULL, costs O(log n)
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static VOID* heap_delete(INOUT Heap_S *pstHeap, IN VOID **ppvItem)
+{ 
+    VOID *pvRet = NULL;
+    VOID **ppvParent = NULL;
+    INT iCmpRet = 0;
+
+    assert(NULL != pstHeap && NULL != ppvItem);
+    assert(ppvItem >= pstHeap->ppvHeap && ppvItem < pstHeap->ppvTail);
+
+    pvRet = *heap_at(pstHeap, ppvItem);
+    pstHeap->ppvTail--;
+    heap_swap(pstHeap, ppvItem, pstHeap->ppvTail);
+    heap_hashdel(pstHeap, pstHeap->ppvTail - pstHeap->ppvHeap);
+    *heap_at(pstHeap, pstHeap->ppvTail) = NULL;
+
+    if (ppvItem == pstHeap->ppvTail)
+    {
+        return pvRet;
+    }
+
+    if (HEAP_MINMAX == pstHeap->uiType)
+    {
+        minmax_fix(pstHeap, ppvItem);
+        return pvRet;
+    }
+
+    /**the tail item may be prior to the parent of the hole**/
+    ppvParent = heap_parent(pstHeap, ppvItem);
+    if (NULL != ppvParent)
+    {
+        iCmpRet = pstHeap->pfCompare(*heap_at(pstHeap, ppvParent),
+                                     *heap_at(pstHeap, ppvItem));
+        if ((HEAP_MAXI == pstHeap->uiType && iCmpRet < 0) ||
+            (HEAP_MINI == pstHeap->uiType && iCmpRet > 0))
+        {
+            heapify_one(pstHeap, ppvItem);
+            return pvRet;
+        }
+    }
+
+    heapify_down(pstHeap, ppvItem);
+
+    return pvRet;
+}
+
+/*******************************************************************************
+    Func Name:  HeapCreate
+ Date Created:  2014-9-17
+       Author:  Zhulinfeng
+  Description:  To create a data structure of heap
+        Input:  IN UINT uiSize, how many items the heap can store.
+                IN UINT uiType, HEAP_MINI for minimal heap, HEAP_MAXI for maximum heap,
+                                HEAP_MINMAX for min-max heap, 
+                                or-ed with HEAP_INDEXED to locate items by handle,
+                                HEAP_ARITY4 or HEAP_ARITY8 for 4-ary or 8-ary heap,
+                                HEAP_BLOCKED to lay subtrees in pages
+                IN PF_COMPARE pfCompare, callback function to compare two items
+                IN PF_PRINT pfPrint, callback function to print item
+                IN PF_FREE pfFree, callback function to free item
+       Output:  NONE  
+       Return:  Heap_S*,  the heap struct
+                NULL,     error occured
+      Caution:  pfCompare should not be NULL,
+                pfPrint can be NULL
+                pfFree can be NULL if you don't want your data to be freed when deleting
+                the heap
+                HEAP_MINMAX heap is always binary
+                HEAP_BLOCKED heap is binary and not HEAP_MINMAX, a path of 9
+                levels stays in one 4KB page, so a sift through a heap much
+                larger than memery touches a page every 9 levels instead of
+                every level. The tree is as deep as the flat one, but the
+                memery may be up to twice as large
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+Heap_S* HeapCreate(IN UINT uiSize, IN UINT uiType,
+                   IN PF_COMPARE pfCompare,
+                   IN PF_PRINT pfPrint,
+                   IN PF_FREE pfFree)
+{
+    Heap_S *pstHeap = NULL;
+    VOID **ppvBase = NULL;
+    UINT uiFlag = 0;
+    UINT uiShift = 0;
+    UINT uiPad = 0;
+    UINT uiCount = 0;
+
+    uiFlag = uiType & ~HEAP_TYPEMASK;
+    uiType &= HEAP_TYPEMASK;
+    if (0 == uiSize || uiType >= HEAP_UPSPACE || NULL == pfCompare)
+    {
+        return NULL;
+    }
+
+    if (0 != (uiFlag & ~HEAP_FLAGS))
+    {
+        return NULL;
+    }
+
+    if (HEAP_MINMAX == uiType && 0 != (uiFlag & HEAP_ARITYMASK))
+    {
+        return NULL;
+    }
+
+    if (0 != (uiFlag & HEAP_BLOCKED) &&
+        (HEAP_MINMAX == uiType || 0 != (uiFlag & HEAP_ARITYMASK)))
+    {
+        return NULL;
+    }
+
+    /**a node has 2^uiShift children**/
+    switch (uiFlag & HEAP_ARITYMASK)
+    {
+        case 0:
+            uiShift = 1;
+            break;
+        case HEAP_ARITY4:
+            uiShift = 2;
+            break;
+        case HEAP_ARITY8:
+            uiShift = 3;
+            break;
+        default:
+            return NULL;
+    }
+
+    pstHeap = (Heap_S *)malloc(sizeof(Heap_S));
+    if (NULL == pstHeap)
+    {
+      return NULL;
+    }
+    memset(pstHeap, 0, sizeof(Heap_S));
+
+    /**put the root in the last but d-1 places of a cache line, then all 
+       children of a node sit in one cache line. HEAP_BLOCKED heap puts the
+       root in the second place of a page, see heap_blockplace**/
+    uiPad = (1U << uiShift) - 1;
+    if (0 != posix_memalign((VOID **)&ppvBase, HEAP_ALIGN(uiFlag),
+                            sizeof(VOID *) *
+                            (heap_places(uiFlag, uiSize) + uiPad)))
+    {
+        free(pstHeap);
+        return NULL;
+    }
+    memset(ppvBase, 0,
+           sizeof(VOID *) * (heap_places(uiFlag, uiSize) + uiPad));
+
+    pstHeap->uiSize = uiSize;
+    pstHeap->uiTopLevel = heap_toplevel(uiSize);
+    pstHeap->uiMinSize = uiSize;
+    pstHeap->ppvBase = ppvBase;
+    pstHeap->ppvHeap = ppvBase + uiPad;
+    pstHeap->ppvTail = ppvBase + uiPad;
+    pstHeap->uiType = uiType;
+    pstHeap->uiFlag = uiFlag;
+    pstHeap->uiShift = uiShift;
+    pstHeap->pfCompare = pfCompare;
+    pstHeap->pfPrint = pfPrint;
+    pstHeap->pfFree = pfFree;
+
+    if (0 == (uiFlag & HEAP_INDEXED))
+    {
+        return pstHeap;
+    }
+
+    /**handles of items are in front, the free ones are behind**/
+    pstHeap->puiHandle = (UINT *)malloc(sizeof(UINT) * uiSize);
+    pstHeap->puiPlace = (UINT *)malloc(sizeof(UINT) * uiSize);
+    if (NULL == pstHeap->puiHandle || NULL == pstHeap->puiPlace)
+    {
+        HeapFree(pstHeap);
+        return NULL;
+    }
+    for (uiCount = 0; uiCount < uiSize; uiCount++)
+    {
+        pstHeap->puiHandle[uiCount] = uiCount;
+        pstHeap->puiPlace[uiCount] = uiCount;
+    }
+
+    return pstHeap;
+}
+
+/*******************************************************************************
+    Func Name:  HeapCreateFromArray
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a heap filled with the items of an array
+        Input:  IN VOID **ppvItems, the items to be put into heap
+                IN UINT uiNum, how many items in ppvItems
+                IN UINT uiSize, how many items the heap can store.
+                IN UINT uiType, HEAP_MINI for minimal heap, HEAP_MAXI for maximum heap 
+                IN PF_COMPARE pfCompare, callback function to compare two items
+                IN PF_PRINT pfPrint, callback function to print item
+                IN PF_FREE pfFree, callback function to free item
+       Output:  NONE  
+       Return:  Heap_S*,  the heap struct
+                NULL,     error occured
+      Caution:  uiSize should not be less than uiNum, and no item in ppvItems
+                can be NULL. The items are copied in one go and heapified 
+                bottom-up, costs O(n) instead of O(n log n) of n HeapAdd.
+                In HEAP_INDEXED heap the handle of ppvItems[i] is i
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+Heap_S* HeapCreateFromArray(IN VOID **ppvItems, IN UINT uiNum,
+                            IN UINT uiSize, IN UINT uiType,
+                            IN PF_COMPARE pfCompare,
+                            IN PF_PRINT pfPrint,
+                            IN PF_FREE pfFree)
+{
+    Heap_S *pstHeap = NULL;
+
+    if (NULL == ppvItems || uiSize < uiNum)
+    {
+        return NULL;
+    }
+
+    if (BOOL_TRUE != heap_checkitems(ppvItems, uiNum))
+    {
+        return NULL;
+    }
+
+    pstHeap = HeapCreate(uiSize, uiType, pfCompare, pfPrint, pfFree);
+    if (NULL == pstHeap)
+    {
+        return NULL;
+    }
+
+    heap_append(pstHeap, ppvItems, uiNum);
+    heapify_all(pstHeap);
+
+    return pstHeap;
+}
+
+/*******************************************************************************
+    Func Name:  HeapSetGrow
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Make a heap grow automatically instead of being full
+        Input:  IN Heap_S *pstHeap
+                IN UINT uiShrink, shrink the heap to half if less than 
+                                  1/uiShrink of it is used, 0 for never
+       Output:  OUT Heap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed
+      Caution:  uiShrink should be 0 or not less than 4. The heap doubles when
+                it is 3/4 full, and never shrinks below the size it's created
+                with. The items are copied to the new memery a few a time by
+                every add and remove, so no one of them stalls for copying the
+                whole heap. HEAP_INDEXED heap never shrinks, for the handles 
+                can't be renumbered
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+ULONG HeapSetGrow(INOUT Heap_S *pstHeap, IN UINT uiShrink)
+{
+    if (NULL == pstHeap)
+    {
+        return ERROR_FAILED;
+    }
+
+    if (0 != uiShrink && uiShrink < 4)
+    {
+        return ERROR_FAILED;
+    }
+
+    pstHeap->bGrow = BOOL_TRUE;
+    pstHeap->uiShrink = uiShrink;
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  HeapSetHash
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Index the items of a heap by hash
+        Input:  IN Heap_S *pstHeap
+                IN PF_HASH pfHash, callback function to hash item
+       Output:  OUT Heap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, or the heap is indexed already
+      Caution:  Items equal by pfCompare should have the same hash. Then
+                HeapSearch costs O(1) and HeapRemoveItem costs O(log n), but
+                every add hashes the item once. The items already in heap are
+                indexed at once. The index is rebuilt when the heap grows,
+                costs O(n) but no hash is called
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+ULONG HeapSetHash(INOUT Heap_S *pstHeap, IN PF_HASH pfHash)
+{
+    UINT uiNum = 0;
+    UINT uiCount = 0;
+    UINT uiBuckets = 0;
+
+    if (NULL == pstHeap || NULL == pfHash || NULL != pstHeap->puiEntry)
+    {
+        return ERROR_FAILED;
+    }
+
+    /**the index is as big as the memery the items are in**/
+    if (NULL != pstHeap->ppvNext)
+    {
+        heap_move(pstHeap, 0);
+    }
+
+    uiBuckets = heap_buckets(pstHeap->uiSize);
+    pstHeap->puiBucket = (UINT *)malloc(sizeof(UINT) * uiBuckets);
+    pstHeap->pulBucketHash = (ULONG *)malloc(sizeof(ULONG) * uiBuckets);
+    pstHeap->puiEntry = (UINT *)malloc(sizeof(UINT) * pstHeap->uiSize);
+    if (NULL == pstHeap->puiBucket || NULL == pstHeap->pulBucketHash ||
+        NULL == pstHeap->puiEntry)
+    {
+        free(pstHeap->puiBucket);
+        free(pstHeap->pulBucketHash);
+        free(pstHeap->puiEntry);
+        pstHeap->puiBucket = NULL;
+        pstHeap->pulBucketHash = NULL;
+        pstHeap->puiEntry = NULL;
+        return ERROR_FAILED;
+    }
+
+    for (uiCount = 0; uiCount < uiBuckets; uiCount++)
+    {
+        pstHeap->puiBucket[uiCount] = HEAP_NOPLACE;
+    }
+
+    pstHeap->pfHash = pfHash;
+    pstHeap->uiHashSize = pstHeap->uiSize;
+    pstHeap->uiBucketMask = uiBuckets - 1;
+
+    uiNum = pstHeap->ppvTail - pstHeap->ppvHeap;
+    for (uiCount = 0; uiCount < uiNum; uiCount++)
+    {
+        heap_hashadd(pstHeap, uiCount);
+    }
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  HeapFree
+ Date Created:  2014-9-17
+       Author:  Zhulinfeng
+  Description:  To free a given heap
+        Input:  IN Heap_S *pstHeap, the heap to be freed
+       Output:  NONE
+       Return:  NONE
+      Caution:  If you have installed PF_FREE callback function, then all the itmes
+                in the heap will be freed, otherwise it's the user's responsibility
+                to free the memeries of all items
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+VOID HeapFree(IN Heap_S *pstHeap)
+{
+    VOID **ppvCursor = NULL;
+
+    if (NULL == pstHeap)
+    {
+      return;
+    }
+
+    if (NULL ==pstHeap->ppvHeap)
+    {
+        free(pstHeap);
+        return;
+    }
+
+    if (NULL != pstHeap->pfFree)
+    {
+        ppvCursor = pstHeap->ppvHeap;
+        while (ppvCursor < pstHeap->ppvTail)
+        {
+            pstHeap->pfFree(*heap_at(pstHeap, ppvCursor));
+            ppvCursor++;
+        }
+    }
+
+    free(pstHeap->ppvBase);
+    pstHeap->ppvBase = NULL;
+    pstHeap->ppvHeap = NULL;
+
+    free(pstHeap->puiHandle);
+    free(pstHeap->puiPlace);
+    free(pstHeap->ppvNextBase);
+    free(pstHeap->puiNextHandle);
+    free(pstHeap->puiNextPlace);
+    free(pstHeap->puiBucket);
+    free(pstHeap->pulBucketHash);
+    free(pstHeap->puiEntry);
+    free(pstHeap->puiNextBucket);
+    free(pstHeap->pulNextBucketHash);
+    free(pstHeap->puiNextEntry);
+    free(pstHeap);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  HeapAdd
+ Date Created:  2014-9-17
+       Author:  Zhulinfeng
+  Description:  Add an item to heap
+        Input:  IN Heap_S *pstHeap
+                IN VOID *pvItem, item to be added
+       Output:  OUT Heap_S *pstHeap
+       Return:  LUONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+ULONG HeapAdd(INOUT Heap_S *pstHeap, IN VOID *pvItem)
+{
+    if (NULL == pstHeap || NULL == pvItem)
+    {
+        return ERROR_FAILED;
+    }
+
+    if (BOOL_TRUE != heap_room(pstHeap))
+    {
+        return ERROR_FAILED;
+    }
+
+    *heap_at(pstHeap, pstHeap->ppvTail) = pvItem;
+    heap_hashadd(pstHeap, pstHeap->ppvTail - pstHeap->ppvHeap);
+    (pstHeap->ppvTail)++;
+    heapify_one(pstHeap, pstHeap->ppvTail - 1);
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  HeapAddBatch
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add a batch of items to heap
+        Input:  IN Heap_S *pstHeap
+                IN VOID **ppvItems, items to be added
+                IN UINT uiNum, how many items in ppvItems
+       Output:  OUT Heap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, nothing is added
+      Caution:  No item in ppvItems can be NULL. The items are appended in one
+                go, then a small batch is sifted up item by item, costs 
+                O(k log n), while a large one makes the whole heap rebuilt,
+                costs O(n + k). A HeapSetGrow heap moves to the
+                next memery step by step as HeapAdd does, it's grown at once
+                only if the batch can't fit the memery
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+ULONG HeapAddBatch(INOUT Heap_S *pstHeap, IN VOID **ppvItems, IN UINT uiNum)
+{
+    VOID **ppvCursor = NULL;
+    UINT uiTotal = 0;
+
+    if (NULL == pstHeap || NULL == ppvItems)
+    {
+        return ERROR_FAILED;
+    }
+
+    uiTotal = HeapNumber(pstHeap) + uiNum;
+    if (uiTotal < uiNum)
+    {
+        return ERROR_FAILED;
+    }
+
+    /**grow at once only if the batch can't fit the memery at all**/
+    heap_adjust(pstHeap);
+    if (uiTotal > heap_limit(pstHeap) && BOOL_TRUE == pstHeap->bGrow)
+    {
+        heap_grow(pstHeap, uiTotal);
+    }
+
+    if (uiTotal > heap_limit(pstHeap))
+    {
+        return ERROR_FAILED;
+    }
+
+    if (BOOL_TRUE != heap_checkitems(ppvItems, uiNum))
+    {
+        return ERROR_FAILED;
+    }
+
+    ppvCursor = pstHeap->ppvTail;
+    heap_append(pstHeap, ppvItems, uiNum);
+    for (; NULL != pstHeap->puiEntry && ppvCursor < pstHeap->ppvTail;
+         ppvCursor++)
+    {
+        heap_hashadd(pstHeap, ppvCursor - pstHeap->ppvHeap);
+    }
+
+    /**or else move as many places as adding the items one by one would, 
+       the heap may switch to the next memery here**/
+    heap_adjust(pstHeap);
+    if (NULL != pstHeap->ppvNext)
+    {
+        heap_move(pstHeap, (uiNum < HEAP_SIZEMAX / HEAP_MOVESTEP) ?
+                           uiNum * HEAP_MOVESTEP : 0);
+    }
+    ppvCursor = pstHeap->ppvTail - uiNum;
+
+    /**sifting up costs k*log(n) at worst, rebuilding costs about 2*n**/
+    if ((ULONG)uiNum * heap_log2(uiTotal) > 2 * (ULONG)uiTotal)
+    {
+        heapify_all(pstHeap);
+        return ERROR_SUCCESS;
+    }
+
+    /**place the new items one by one as HeapAdd does, a min-max heap may
+       sift down, and must not reach the items not placed yet**/
+    pstHeap->ppvTail = ppvCursor;
+    for (; uiNum > 0; uiNum--)
+    {
+        (pstHeap->ppvTail)++;
+        heapify_one(pstHeap, pstHeap->ppvTail - 1);
+    }
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  HeapSearch
+ Date Created:  2014-9-17
+       Author:  Zhulinfeng
+  Description:  Search an item in a heap
+        Input:  IN Heap_S *pstHeap
+                 N VOID *pvItem, the item to be searched
+       Output:  NONE
+       Return:  VOID*, the item found
+                NULL,  not found
+      Caution:  costs O(n), or O(1) if the heap is indexed by HeapSetHash
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+VOID* HeapSearch(IN Heap_S *pstHeap, IN VOID *pvItem)
+{ 
+    VOID *pvRet = NULL;
+    VOID **ppvCursor = NULL;
+    INT iCmpRet = 0;
+
+    if (NULL == pstHeap || NULL ==pvItem)
+    {
+        return NULL;
+    }
+
+    if (BOOL_TRUE == heap_isempty(pstHeap))
+    {
+        return NULL;
+    }
+
+    if (NULL != pstHeap->puiEntry)
+    {
+        ppvCursor = heap_hashfind(pstHeap, pvItem);
+        return (NULL == ppvCursor) ? NULL : *heap_at(pstHeap, ppvCursor);
+    }
+
+    ppvCursor = pstHeap->ppvHeap;
+    while (ppvCursor < pstHeap->ppvTail)
+    {
+        iCmpRet = pstHeap->pfCompare(*heap_at(pstHeap, ppvCursor), pvItem);
+        if (0 == iCmpRet)
+        {
+            pvRet = *heap_at(pstHeap, ppvCursor);
+            break;
+        }
+        ppvCursor++;
+    }
+
+    return pvRet;
+}
+
+/*******************************************************************************
+    Func Name:  heap_popdown
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Remove the root from heap bottom up
+        Input:  IN Heap_S *pstHeap
+       Output:  OUT Heap_S *pstHeap
+       Return:  VOID*, the root removed
+      Caution:  pstHeap should not be empty or HEAP_MINMAX. The root is swapped
+                down along the prior children to a leaf, then swapped with the
+                tail and dropped, the tail item climbs from the leaf. Swaps
+                keep the handles and the hash index right
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static VOID* heap_popdown(INOUT Heap_S *pstHeap)
+{
+    VOID *pvRet = NULL;
+    VOID **ppvHole = NULL;
+    VOID **ppvChild = NULL;
+
+    assert(NULL != pstHeap && HEAP_MINMAX != pstHeap->uiType);
+    assert(BOOL_TRUE != heap_isempty(pstHeap));
+
+    pvRet = *heap_at(pstHeap, pstHeap->ppvHeap);
+    pstHeap->ppvTail--;
+
+    /**the tail is out of the heap now, the hole never goes down to it**/
+    ppvHole = pstHeap->ppvHeap;
+    ppvChild = NULL;
+    if (ppvHole < pstHeap->ppvTail)
+    {
+        ppvChild = heap_left(pstHeap, ppvHole);
+    }
+    while (NULL != ppvChild)
+    {
+        ppvChild = heap_best(pstHeap, ppvChild);
+        heap_swap(pstHeap, ppvHole, ppvChild);
+        ppvHole = ppvChild;
+        ppvChild = heap_left(pstHeap, ppvHole);
+    }
+
+    heap_swap(pstHeap, ppvHole, pstHeap->ppvTail);
+    heap_hashdel(pstHeap, pstHeap->ppvTail - pstHeap->ppvHeap);
+    *heap_at(pstHeap, pstHeap->ppvTail) = NULL;
+
+    if (ppvHole != pstHeap->ppvTail)
+    {
+        heapify_one(pstHeap, ppvHole);
+    }
+
+    return pvRet;
+}
+
+/*******************************************************************************
+    Func Name:  HeapRemoveRoot
+ Date Created:  2014-9-17
+       Author:  Zhulinfeng
+  Description:  remove the root item from heap
+        Input:  IN Heap_S *pstHeap
+       Output:  NONE
+       Return:  VOID*, the item removed out
+                NULL, failed, the heap is empty
+      Caution:  The function only removes items from heap, but the memery is 
+                left to users to free. The root is removed bottom up: the hole
+                it leaves goes down to a leaf without comparing with the tail
+                item, which then goes up from there. It saves about half of
+                the compares, for the tail item seldom goes far up. HEAP_MINMAX
+                heap sifts the tail item down from the root instead
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+VOID* HeapRemoveRoot(IN Heap_S *pstHeap)
+{
+    VOID *pvRet = NULL;
+
+    if (NULL == pstHeap)
+    {
+        return NULL;
+    }
+    if (BOOL_TRUE == heap_isempty(pstHeap))
+    {
+        return NULL;
+    }
+
+    if (HEAP_MINMAX == pstHeap->uiType)
+    {
+        pvRet = heap_delete(pstHeap, pstHeap->ppvHeap);
+    }
+    else
+    {
+        pvRet = heap_popdown(pstHeap);
+    }
+    heap_adjust(pstHeap);
+
+    return pvRet;
+}
+
+/*******************************************************************************
+    Func Name:  HeapRemoveTail
+ Date Created:  2014-9-17
+       Author:  Zhulinfeng
+  Description:  remove the tail item from heap
+        Input:  IN Heap_S *pstHeap
+       Output:  NONE
+       Return:  VOID*, the item removed out
+                NULL, failed, the heap is empty
+      Caution:  The function only removes items from heap, but the memery is 
+                left to users to free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+VOID* HeapRemoveTail(IN Heap_S *pstHeap)
+{
+    VOID *pvRet = NULL;
+
+    if (NULL == pstHeap)
+    {
+        return NULL;
+    }
+    if (BOOL_TRUE == heap_isempty(pstHeap))
+    {
+        return NULL;
+    }
+
+    pvRet = *heap_at(pstHeap, pstHeap->ppvTail - 1);
+    heap_hashdel(pstHeap, pstHeap->ppvTail - 1 - pstHeap->ppvHeap);
+    *heap_at(pstHeap, pstHeap->ppvTail - 1) = NULL;
+    pstHeap->ppvTail--;
+    heap_adjust(pstHeap);
+
+    return pvRet;    
+}
+
+/*******************************************************************************
+    Func Name:  HeapRemoveItem
+ Date Created:  2014-9-17
+       Author:  Zhulinfeng
+  Description:  remove the match item from heap
+        Input:  IN Heap_S *pstHeap
+                IN VOID *pvItem, the item to be removed
+       Output:  NONE
+       Return:  VOID*, the item removed out
+                NULL, not found
+      Caution:  The function only removes items from heap, but the memery is 
+                left to users to free. It costs O(n) to find the item, or
+                O(1) if the heap is indexed by HeapSetHash
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+VOID* HeapRemoveItem(IN Heap_S *pstHeap, IN VOID *pvItem)
+{
+    VOID *pvRet = NULL;
+    VOID **ppvCursor = NULL;
+    INT iCmpRet = 0;
+
+    if (NULL == pstHeap || NULL ==pvItem)
+    {
+        return NULL;
+    }
+
+    if (BOOL_TRUE == heap_isempty(pstHeap))
+    {
+        return NULL;
+    }
+
+    if (NULL != pstHeap->puiEntry)
+    {
+        ppvCursor = heap_hashfind(pstHeap, pvItem);
+        pvRet = (NULL == ppvCursor) ? NULL : *heap_at(pstHeap, ppvCursor);
+    }
+    else
+    {
+        ppvCursor = pstHeap->ppvHeap;
+        while (ppvCursor < pstHeap->ppvTail)
+        {
+            iCmpRet = pstHeap->pfCompare(*heap_at(pstHeap, ppvCursor),
+                                         pvItem);
+            if (0 == iCmpRet)
+            {
+                pvRet = *heap_at(pstHeap, ppvCursor);
+                break;
+            }
+            ppvCursor++;
+        }
+    }
+
+    if (NULL == pvRet)
+    {
+        return NULL;
+    }
+
+    pvRet = heap_delete(pstHeap, ppvCursor);
+    heap_adjust(pstHeap);
+
+    return pvRet;    
+}
+
+/*******************************************************************************
+    Func Name:  HeapAddHandle
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add an item to heap and get its handle
+        Input:  IN Heap_S *pstHeap
+                IN VOID *pvItem, item to be added
+       Output:  OUT Heap_S *pstHeap
+                OUT UINT *puiHandle, handle of the item
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed
+      Caution:  The heap should be HEAP_INDEXED, the handle keeps valid until
+                the item is removed, then it may be reused by another item
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+ULONG HeapAddHandle(INOUT Heap_S *pstHeap, IN VOID *pvItem,
+                    OUT UINT *puiHandle)
+{
+    UINT uiHandle = 0;
+
+    if (NULL == pstHeap || NULL == puiHandle || NULL == pstHeap->puiHandle)
+    {
+        return ERROR_FAILED;
+    }
+
+    if (NULL == pvItem || BOOL_TRUE != heap_room(pstHeap))
+    {
+        return ERROR_FAILED;
+    }
+
+    /**the item takes the first free handle**/
+    uiHandle = pstHeap->puiHandle[HeapNumber(pstHeap)];
+    *heap_at(pstHeap, pstHeap->ppvTail) = pvItem;
+    heap_hashadd(pstHeap, pstHeap->ppvTail - pstHeap->ppvHeap);
+    (pstHeap->ppvTail)++;
+    heapify_one(pstHeap, pstHeap->ppvTail - 1);
+
+    *puiHandle = uiHandle;
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  heap_handle
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get the place of item by handle
+        Input:  IN Heap_S *pstHeap
+                IN UINT uiHandle
+       Output:  NONE
+       Return:  VOID**, place of the item
+                NULL, the heap is not HEAP_INDEXED or the handle is not in use
+      Caution:  pstHeap should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static inline VOID** heap_handle(IN Heap_S *pstHeap, IN UINT uiHandle)
+{
+    UINT uiPlace = 0;
+
+    assert(NULL != pstHeap);
+
+    if (NULL == pstHeap->puiPlace || uiHandle >= pstHeap->uiSize)
+    {
+        return NULL;
+    }
+
+    uiPlace = pstHeap->puiPlace[uiHandle];
+    if (uiPlace >= HeapNumber(pstHeap))
     {
-        heapify_one(pstHeap, ppvCursor);
-        ppvCursor--;
+        return NULL;
     }
 
-    return;
+    return pstHeap->ppvHeap + uiPlace;
 }
 
 /*******************************************************************************
-    Func Name:  HeapCreate
- Date Created:  2014-9-17
-       Author:  Zhulinfeng
-  Description:  To create a data structure of heap
-        Input:  IN UINT uiSize, how many items the heap can store.
-                IN UINT uiType, HEAP_MINI for minimal heap, HEAP_MAXI for maximum heap 
-                IN PF_COMPARE pfCompare, callback function to compare two items
-                IN PF_PRINT pfPrint, callback function to print item
-                IN PF_FREE pfFree, callback function to free item
-       Output:  NONE  
-       Return:  Heap_S*,  the heap struct
-                NULL,     error occured
-      Caution:  pfCompare should not be NULL,
-                pfPrint can be NULL
-                pfFree can be NULL if you don't want your data to be freed when deleting
-                the heap
+    Func Name:  HeapUpdate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Keep heap healthy after the key of an item changed
+        Input:  IN Heap_S *pstHeap
+                IN UINT uiHandle, handle of the changed item
+       Output:  OUT Heap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, the handle is not in use
+      Caution:  The heap should be HEAP_INDEXED, costs O(log n). The item is
+                indexed again by its new hash if HeapSetHash is set
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
   ----------------------------------------------------------------------------
   YYYY-MM-DD      
 *******************************************************************************/
-Heap_S* HeapCreate(IN UINT uiSize, IN UINT uiType,
-                   IN PF_COMPARE pfCompare,
-                   IN PF_PRINT pfPrint,
-                   IN PF_FREE pfFree)
+ULONG HeapUpdate(INOUT Heap_S *pstHeap, IN UINT uiHandle)
 {
-    Heap_S *pstHeap = NULL;
-    VOID **ppvHeap = NULL;
+    VOID **ppvItem = NULL;
+    VOID *pvItem = NULL;
 
-    if (0 == uiSize || uiType >= HEAP_UPSPACE || NULL == pfCompare)
+    if (NULL == pstHeap)
     {
-        return NULL;
+        return ERROR_FAILED;
     }
 
-    pstHeap = (Heap_S *)malloc(sizeof(Heap_S));
+    ppvItem = heap_handle(pstHeap, uiHandle);
+    if (NULL == ppvItem)
+    {
+        return ERROR_FAILED;
+    }
+
+    /**the key has changed, and so has the hash of the item**/
+    heap_hashdel(pstHeap, ppvItem - pstHeap->ppvHeap);
+    heap_hashadd(pstHeap, ppvItem - pstHeap->ppvHeap);
+
+    /**go up first, go down if it doesn't move**/
+    pvItem = *heap_at(pstHeap, ppvItem);
+    heapify_one(pstHeap, ppvItem);
+    if (pvItem == *heap_at(pstHeap, ppvItem))
+    {
+        heapify_down(pstHeap, ppvItem);
+    }
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  HeapDecreaseKey
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Keep heap healthy after an item became more prior, that's 
+                the key decreased in HEAP_MINI heap or increased in HEAP_MAXI
+                heap
+        Input:  IN Heap_S *pstHeap
+                IN UINT uiHandle, handle of the changed item
+       Output:  OUT Heap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, the handle is not in use
+      Caution:  The heap should be HEAP_INDEXED, costs O(log n). The item is
+                indexed again by its new hash if HeapSetHash is set
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+ULONG HeapDecreaseKey(INOUT Heap_S *pstHeap, IN UINT uiHandle)
+{
+    VOID **ppvItem = NULL;
+
     if (NULL == pstHeap)
     {
-      return NULL;
+        return ERROR_FAILED;
     }
-    memset(pstHeap, 0, sizeof(Heap_S));
 
-    ppvHeap = (VOID **)malloc(sizeof(VOID *) * uiSize);
-    if (NULL == ppvHeap)
+    ppvItem = heap_handle(pstHeap, uiHandle);
+    if (NULL == ppvItem)
+    {
+        return ERROR_FAILED;
+    }
+
+    /**the key has changed, and so has the hash of the item**/
+    heap_hashdel(pstHeap, ppvItem - pstHeap->ppvHeap);
+    heap_hashadd(pstHeap, ppvItem - pstHeap->ppvHeap);
+
+    heapify_one(pstHeap, ppvItem);
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  HeapRemoveHandle
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  remove the item of a handle from heap
+        Input:  IN Heap_S *pstHeap
+                IN UINT uiHandle, handle of the item to be removed
+       Output:  NONE
+       Return:  VOID*, the item removed out
+                NULL, the handle is not in use
+      Caution:  The heap should be HEAP_INDEXED, costs O(log n). The function 
+                only removes items from heap, but the memery is left to users
+                to free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+VOID* HeapRemoveHandle(IN Heap_S *pstHeap, IN UINT uiHandle)
+{
+    VOID **ppvItem = NULL;
+    VOID *pvRet = NULL;
+
+    if (NULL == pstHeap)
     {
-        free(pstHeap);
         return NULL;
     }
-    memset(ppvHeap, 0, sizeof(VOID *) * uiSize);
 
-    pstHeap->uiSize = uiSize;
-    pstHeap->ppvHeap = ppvHeap;
-    pstHeap->ppvTail = ppvHeap;
-    pstHeap->uiType = uiType;
-    pstHeap->pfCompare = pfCompare;
-    pstHeap->pfPrint = pfPrint;
-    pstHeap->pfFree = pfFree;
+    ppvItem = heap_handle(pstHeap, uiHandle);
+    if (NULL == ppvItem)
+    {
+        return NULL;
+    }
 
-    return pstHeap;
+    pvRet = heap_delete(pstHeap, ppvItem);
+    heap_adjust(pstHeap);
+
+    return pvRet;
 }
 
 /*******************************************************************************
-    Func Name:  HeapFree
+    Func Name:  HeapPrint
  Date Created:  2014-9-17
        Author:  Zhulinfeng
-  Description:  To free a given heap
-        Input:  IN Heap_S *pstHeap, the heap to be freed
+  Description:  print all items in heap
+        Input:  IN Heap_S *pstHeap
        Output:  NONE
        Return:  NONE
-      Caution:  If you have installed PF_FREE callback function, then all the itmes
-                in the heap will be freed, otherwise it's the user's responsibility
-                to free the memeries of all items
+      Caution:  NONE
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
   ----------------------------------------------------------------------------
   YYYY-MM-DD      
 *******************************************************************************/
-VOID HeapFree(IN Heap_S *pstHeap)
+VOID HeapPrint(IN Heap_S *pstHeap)
 {
     VOID **ppvCursor = NULL;
 
-    if (NULL == pstHeap)
+    if (NULL == pstHeap || NULL == pstHeap->pfPrint)
     {
-      return;
+        return;
     }
 
-    if (NULL ==pstHeap->ppvHeap)
+    if (BOOL_TRUE == heap_isempty(pstHeap))
     {
-        free(pstHeap);
         return;
     }
 
-    if (NULL != pstHeap->pfFree)
+    ppvCursor = pstHeap->ppvHeap;
+    while (ppvCursor < pstHeap->ppvTail)
     {
-        ppvCursor = pstHeap->ppvHeap;
-        while (ppvCursor < pstHeap->ppvTail)
-        {
-            pstHeap->pfFree(*ppvCursor);
-            ppvCursor++;
-        }
+        pstHeap->pfPrint(*heap_at(pstHeap, ppvCursor));
+        ppvCursor++;
     }
 
-    free(pstHeap->ppvHeap);
-    pstHeap->ppvHeap = NULL;
-
-    free(pstHeap);
-
     return;
 }
 
 /*******************************************************************************
-    Func Name:  HeapAdd
- Date Created:  2014-9-17
+    Func Name:  HeapNumber
+ Date Created:  2014-9-18
        Author:  Zhulinfeng
-  Description:  Add an item to heap
+  Description:  Return how many items in heap
         Input:  IN Heap_S *pstHeap
-                IN VOID *pvItem, item to be added
-       Output:  OUT Heap_S *pstHeap
-       Return:  LUONG
-                ERROR_SUCCESS,  success
-                ERROR_FAILED,   failed
+       Output:  NONE
+       Return:  UINT
       Caution:  NONE
   ----------------------------------------------------------------------------
   Modification History
@@ -447,49 +2817,107 @@ VOID HeapFree(IN Heap_S *pstHeap)
   ----------------------------------------------------------------------------
   YYYY-MM-DD      
 *******************************************************************************/
-ULONG HeapAdd(INOUT Heap_S *pstHeap, IN VOID *pvItem)
+UINT HeapNumber(IN Heap_S *pstHeap)
 {
-    if (NULL == pstHeap || NULL == pvItem)
+    UINT uiRet = 0;
+
+    if (NULL == pstHeap)
     {
-        return ERROR_FAILED;
+        return 0;
     }
 
-    if (BOOL_TRUE == heap_isfull(pstHeap))
+    uiRet = pstHeap->ppvTail - pstHeap->ppvHeap;
+    return uiRet;
+}
+
+/*******************************************************************************
+    Func Name:  heap_extreme
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get the place of the max or minimal item in heap
+        Input:  IN Heap_S *pstHeap
+                IN BOOL_T bMax, BOOL_TRUE for the max item, BOOL_FALSE for the
+                                minimal one
+       Output:  NONE
+       Return:  VOID**, place of the item
+      Caution:  pstHeap should not be NULL or empty. The root of HEAP_MINMAX
+                heap is the minimal item and one of its children is the max 
+                one, costs O(1). The other end of HEAP_MINI or HEAP_MAXI heap
+                is one of the leaves, costs O(n)
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static VOID** heap_extreme(IN Heap_S *pstHeap, IN BOOL_T bMax)
+{
+    VOID **ppvRet = NULL;
+    VOID **ppvCursor = NULL;
+    VOID **ppvLeft = NULL;
+    INT iCmpRet = 0;
+
+    assert(NULL != pstHeap);
+    assert(BOOL_TRUE != heap_isempty(pstHeap));
+
+    if (1 == HeapNumber(pstHeap) ||
+        (HEAP_MAXI == pstHeap->uiType && BOOL_TRUE == bMax) ||
+        (HEAP_MAXI != pstHeap->uiType && BOOL_TRUE != bMax))
     {
-        return ERROR_FAILED;
+        return pstHeap->ppvHeap;
     }
 
-    *(pstHeap->ppvTail) = pvItem;
-    (pstHeap->ppvTail)++;
-    heapify_one(pstHeap, pstHeap->ppvTail - 1);
+    if (HEAP_MINMAX == pstHeap->uiType)
+    {
+        ppvRet = pstHeap->ppvHeap + 1;
+        if (2 < HeapNumber(pstHeap) &&
+            pstHeap->pfCompare(pstHeap->ppvHeap[2], *ppvRet) > 0)
+        {
+            ppvRet = pstHeap->ppvHeap + 2;
+        }
+        return ppvRet;
+    }
 
-    return ERROR_SUCCESS;
+    ppvCursor = pstHeap->ppvTail - 1;
+    ppvRet = ppvCursor;
+    ppvLeft = heap_left(pstHeap, ppvCursor);
+    while (NULL == ppvLeft)
+    {
+        iCmpRet = pstHeap->pfCompare(*heap_at(pstHeap, ppvCursor),
+                                     *heap_at(pstHeap, ppvRet));
+        if ((BOOL_TRUE == bMax && 0 < iCmpRet) ||
+            (BOOL_TRUE != bMax && 0 > iCmpRet))
+        {
+            ppvRet = ppvCursor;
+        }
+        ppvCursor--;
+        ppvLeft = heap_left(pstHeap, ppvCursor);
+    }
+
+    return ppvRet;
 }
 
 /*******************************************************************************
-    Func Name:  HeapSearch
- Date Created:  2014-9-17
+    Func Name:  HeapMax
+ Date Created:  2014-9-19
        Author:  Zhulinfeng
-  Description:  Search an item in a heap
+  Description:  Return the max item in heap
         Input:  IN Heap_S *pstHeap
-                 N VOID *pvItem, the item to be searched
        Output:  NONE
-       Return:  VOID*, the item found
-                NULL,  not found
-      Caution:  NONE
+       Return:  VOID*, the max item
+                NULL, failed
+      Caution:  costs O(1) in HEAP_MINMAX heap
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
   ----------------------------------------------------------------------------
   YYYY-MM-DD      
 *******************************************************************************/
-VOID* HeapSearch(IN Heap_S *pstHeap, IN VOID *pvItem)
-{ 
+VOID* HeapMax(IN Heap_S *pstHeap)
+{
     VOID *pvRet = NULL;
-    VOID **ppvCursor = NULL;
-    INT iCmpRet = 0;
 
-    if (NULL == pstHeap || NULL ==pvItem)
+    if (NULL == pstHeap)
     {
         return NULL;
     }
@@ -499,41 +2927,66 @@ VOID* HeapSearch(IN Heap_S *pstHeap, IN VOID *pvItem)
         return NULL;
     }
 
-    ppvCursor = pstHeap->ppvHeap;
-    while (ppvCursor < pstHeap->ppvTail)
+    pvRet = *heap_at(pstHeap, heap_extreme(pstHeap, BOOL_TRUE));
+
+    return pvRet;
+}
+
+/*******************************************************************************
+    Func Name:  HeapMin
+ Date Created:  2014-9-19
+       Author:  Zhulinfeng
+  Description:  Return the minimal item in heap
+        Input:  IN Heap_S *pstHeap
+       Output:  NONE
+       Return:  VOID*, the minimal item
+                NULL, failed
+      Caution:  costs O(1) in HEAP_MINMAX heap
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+VOID* HeapMin(IN Heap_S *pstHeap)
+{
+    VOID *pvRet = NULL;
+
+    if (NULL == pstHeap)
     {
-        iCmpRet = pstHeap->pfCompare(*ppvCursor, pvItem);
-        if (0 == iCmpRet)
-        {
-            pvRet = *ppvCursor;
-            break;
-        }
-        ppvCursor++;
+        return NULL;
+    }
+
+    if (BOOL_TRUE == heap_isempty(pstHeap))
+    {
+        return NULL;
     }
 
+    pvRet = *heap_at(pstHeap, heap_extreme(pstHeap, BOOL_FALSE));
+
     return pvRet;
 }
 
 /*******************************************************************************
-    Func Name:  HeapRemoveRoot
- Date Created:  2014-9-17
-       Author:  Zhulinfeng
-  Description:  remove the root item from heap
+    Func Name:  HeapRemoveMin
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  remove the minimal item from heap
         Input:  IN Heap_S *pstHeap
        Output:  NONE
        Return:  VOID*, the item removed out
                 NULL, failed, the heap is empty
-      Caution:  The function only removes items from heap, but the memery is 
-                left to users to free
+      Caution:  costs O(log n) in HEAP_MINMAX heap, O(n) if it's not the root
+                of HEAP_MINI or HEAP_MAXI heap. The function only removes items
+                from heap, but the memery is left to users to free
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
   ----------------------------------------------------------------------------
   YYYY-MM-DD      
 *******************************************************************************/
-VOID* HeapRemoveRoot(IN Heap_S *pstHeap)
+VOID* HeapRemoveMin(IN Heap_S *pstHeap)
 {
-    VOID **ppvCursor = NULL;
     VOID *pvRet = NULL;
 
     if (NULL == pstHeap)
@@ -545,39 +2998,31 @@ VOID* HeapRemoveRoot(IN Heap_S *pstHeap)
         return NULL;
     }
 
-    pvRet = *pstHeap->ppvHeap;
-    ppvCursor = pstHeap->ppvHeap;
-    while (ppvCursor < pstHeap->ppvTail - 1)
-    {
-        *ppvCursor = *(ppvCursor + 1);
-        ppvCursor++;
-    }
-    *ppvCursor = NULL;
-    pstHeap->ppvTail--;
-
-    heapify_all(pstHeap);
+    pvRet = heap_delete(pstHeap, heap_extreme(pstHeap, BOOL_FALSE));
+    heap_adjust(pstHeap);
 
     return pvRet;
 }
 
 /*******************************************************************************
-    Func Name:  HeapRemoveTail
- Date Created:  2014-9-17
-       Author:  Zhulinfeng
-  Description:  remove the tail item from heap
+    Func Name:  HeapRemoveMax
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  remove the max item from heap
         Input:  IN Heap_S *pstHeap
        Output:  NONE
        Return:  VOID*, the item removed out
                 NULL, failed, the heap is empty
-      Caution:  The function only removes items from heap, but the memery is 
-                left to users to free
+      Caution:  costs O(log n) in HEAP_MINMAX heap, O(n) if it's not the root
+                of HEAP_MINI or HEAP_MAXI heap. The function only removes items
+                from heap, but the memery is left to users to free
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
   ----------------------------------------------------------------------------
   YYYY-MM-DD      
 *******************************************************************************/
-VOID* HeapRemoveTail(IN Heap_S *pstHeap)
+VOID* HeapRemoveMax(IN Heap_S *pstHeap)
 {
     VOID *pvRet = NULL;
 
@@ -590,252 +3035,449 @@ VOID* HeapRemoveTail(IN Heap_S *pstHeap)
         return NULL;
     }
 
-    pvRet = *(pstHeap->ppvTail - 1);
-    *(pstHeap->ppvTail - 1) = NULL;
-    pstHeap->ppvTail--;
+    pvRet = heap_delete(pstHeap, heap_extreme(pstHeap, BOOL_TRUE));
+    heap_adjust(pstHeap);
 
-    return pvRet;    
+    return pvRet;
 }
 
 /*******************************************************************************
-    Func Name:  HeapRemoveItem
- Date Created:  2014-9-17
-       Author:  Zhulinfeng
-  Description:  remove the match item from heap
+    Func Name:  heap_replace
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Put an item in place of the root and push it down
         Input:  IN Heap_S *pstHeap
-                IN VOID *pvItem, the item to be removed
-       Output:  NONE
-       Return:  VOID*, the item removed out
-                NULL, not found
-      Caution:  The function only removes items from heap, but the memery is 
-                left to users to free
+                IN VOID *pvItem, item to be put in
+       Output:  OUT Heap_S *pstHeap
+       Return:  VOID*, the root replaced
+      Caution:  pstHeap and pvItem should not be NULL, the heap should not be
+                empty. It sifts once instead of removing and adding, costs
+                O(log n)
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
   ----------------------------------------------------------------------------
-  YYYY-MM-DD      
+  YYYY-MM-DD
 *******************************************************************************/
-VOID* HeapRemoveItem(IN Heap_S *pstHeap, IN VOID *pvItem)
+static VOID* heap_replace(INOUT Heap_S *pstHeap, IN VOID *pvItem)
 {
     VOID *pvRet = NULL;
-    VOID **ppvCursor = NULL;
+
+    assert(NULL != pstHeap && NULL != pvItem);
+    assert(BOOL_TRUE != heap_isempty(pstHeap));
+
+    pvRet = *heap_at(pstHeap, pstHeap->ppvHeap);
+    heap_hashdel(pstHeap, 0);
+    *heap_at(pstHeap, pstHeap->ppvHeap) = pvItem;
+    heap_hashadd(pstHeap, 0);
+    if (NULL != pstHeap->ppvNext)
+    {
+        heap_mirror(pstHeap, 0);
+    }
+
+    heapify_down(pstHeap, pstHeap->ppvHeap);
+    heap_adjust(pstHeap);
+
+    return pvRet;
+}
+
+/*******************************************************************************
+    Func Name:  HeapPushPop
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add an item to heap, then remove the root
+        Input:  IN Heap_S *pstHeap
+                IN VOID *pvItem, item to be added
+       Output:  OUT Heap_S *pstHeap
+       Return:  VOID*, the item removed out, it's pvItem itself if the heap is
+                       empty or pvItem is not behind the root
+                NULL, failed
+      Caution:  pvItem should not be NULL. The heap is not touched if pvItem
+                is returned, otherwise it sifts once, costs O(log n). In
+                HEAP_INDEXED heap the item added takes the handle of the root
+                removed. The memery of the item removed is left to users to
+                free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* HeapPushPop(INOUT Heap_S *pstHeap, IN VOID *pvItem)
+{
     INT iCmpRet = 0;
 
-    if (NULL == pstHeap || NULL ==pvItem)
+    if (NULL == pstHeap || NULL == pvItem)
     {
         return NULL;
     }
 
     if (BOOL_TRUE == heap_isempty(pstHeap))
     {
-        return NULL;
+        return pvItem;
     }
 
-    ppvCursor = pstHeap->ppvHeap;
-    while (ppvCursor < pstHeap->ppvTail)
+    iCmpRet = pstHeap->pfCompare(pvItem, *heap_at(pstHeap, pstHeap->ppvHeap));
+    if ((HEAP_MAXI == pstHeap->uiType && iCmpRet >= 0) ||
+        (HEAP_MAXI != pstHeap->uiType && iCmpRet <= 0))
     {
-        iCmpRet = pstHeap->pfCompare(*ppvCursor, pvItem);
-        if (0 == iCmpRet)
-        {
-            pvRet = *ppvCursor;
-            break;
-        }
-        ppvCursor++;
+        return pvItem;
     }
 
-    if (NULL == pvRet)
+    return heap_replace(pstHeap, pvItem);
+}
+
+/*******************************************************************************
+    Func Name:  HeapReplace
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Remove the root from heap, then add an item
+        Input:  IN Heap_S *pstHeap
+                IN VOID *pvItem, item to be added
+       Output:  OUT Heap_S *pstHeap
+       Return:  VOID*, the item removed out
+                NULL, failed, the heap is empty and pvItem is not added
+      Caution:  pvItem should not be NULL, it's added even if it's prior to
+                the root removed. It sifts once, costs O(log n). In
+                HEAP_INDEXED heap the item added takes the handle of the root
+                removed. The memery of the item removed is left to users to
+                free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* HeapReplace(INOUT Heap_S *pstHeap, IN VOID *pvItem)
+{
+    if (NULL == pstHeap || NULL == pvItem)
     {
         return NULL;
     }
 
-    while (ppvCursor < pstHeap->ppvTail - 1)
+    if (BOOL_TRUE == heap_isempty(pstHeap))
     {
-        *ppvCursor = *(ppvCursor + 1);
-        ppvCursor++;
+        return NULL;
     }
-    *ppvCursor = NULL;
-    pstHeap->ppvTail--;
 
-    heapify_all(pstHeap);   
+    return heap_replace(pstHeap, pvItem);
+}
 
-    return pvRet;    
+/*******************************************************************************
+    Func Name:  HeapRemoveRootN
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Remove at most k roots from heap one after another
+        Input:  IN Heap_S *pstHeap
+                IN UINT uiK, how many roots to remove at most
+       Output:  OUT Heap_S *pstHeap
+                OUT VOID **ppvItems, the items removed, the prior first
+       Return:  UINT, how many items removed, less than uiK if the heap runs
+                      out
+      Caution:  ppvItems should hold uiK items. Each root is removed as
+                HeapRemoveRoot does. The memery of the items is left to users
+                to free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT HeapRemoveRootN(INOUT Heap_S *pstHeap, IN UINT uiK, OUT VOID **ppvItems)
+{
+    UINT uiCount = 0;
+
+    if (NULL == pstHeap || NULL == ppvItems)
+    {
+        return 0;
+    }
+
+    for (uiCount = 0; uiCount < uiK; uiCount++)
+    {
+        ppvItems[uiCount] = HeapRemoveRoot(pstHeap);
+        if (NULL == ppvItems[uiCount])
+        {
+            break;
+        }
+    }
+
+    return uiCount;
 }
 
 /*******************************************************************************
-    Func Name:  HeapPrint
- Date Created:  2014-9-17
-       Author:  Zhulinfeng
-  Description:  print all items in heap
+    Func Name:  HeapRemoveIf
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Remove all items matching a predicate from heap
         Input:  IN Heap_S *pstHeap
-       Output:  NONE
-       Return:  NONE
-      Caution:  NONE
+                IN PF_PREDICATE pfPredicate, callback function to test item
+                IN VOID *pvCtx, given to pfPredicate
+                IN PF_FREE pfOnRemoved, called with each item removed
+       Output:  OUT Heap_S *pstHeap
+       Return:  UINT, how many items removed
+      Caution:  pfPredicate should not be NULL, pfOnRemoved can be NULL. The
+                items kept are packed in front in one pass and the heap is
+                rebuilt once, costs O(n) however many are removed, while a
+                HeapRemoveItem for each costs O(n) for every item. pfOnRemoved
+                is called after the heap is rebuilt, neither callback should
+                change the heap. The handles of the items removed are freed
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
   ----------------------------------------------------------------------------
-  YYYY-MM-DD      
+  YYYY-MM-DD
 *******************************************************************************/
-VOID HeapPrint(IN Heap_S *pstHeap)
+UINT HeapRemoveIf(INOUT Heap_S *pstHeap, IN PF_PREDICATE pfPredicate,
+                  IN VOID *pvCtx, IN PF_FREE pfOnRemoved)
 {
     VOID **ppvCursor = NULL;
+    VOID **ppvKeep = NULL;
+    VOID **ppvTail = NULL;
 
-    if (NULL == pstHeap || NULL == pstHeap->pfPrint)
+    if (NULL == pstHeap || NULL == pfPredicate)
     {
-        return;
+        return 0;
     }
 
-    if (BOOL_TRUE == heap_isempty(pstHeap))
+    /**the items removed are left behind the ones kept, swaps keep the
+       handles, the hash index and the next memery right**/
+    ppvKeep = pstHeap->ppvHeap;
+    for (ppvCursor = pstHeap->ppvHeap; ppvCursor < pstHeap->ppvTail;
+         ppvCursor++)
     {
-        return;
+        if (BOOL_TRUE == pfPredicate(*heap_at(pstHeap, ppvCursor), pvCtx))
+        {
+            continue;
+        }
+        if (ppvKeep != ppvCursor)
+        {
+            heap_swap(pstHeap, ppvKeep, ppvCursor);
+        }
+        ppvKeep++;
     }
 
-    ppvCursor = pstHeap->ppvHeap;
-    while (ppvCursor < pstHeap->ppvTail)
+    ppvTail = pstHeap->ppvTail;
+    if (ppvKeep == ppvTail)
     {
-        pstHeap->pfPrint(*ppvCursor);
-        ppvCursor++;
+        return 0;
     }
 
-    return;
+    /**the handles behind the tail are free ones**/
+    while (pstHeap->ppvTail > ppvKeep)
+    {
+        heap_hashdel(pstHeap, pstHeap->ppvTail - 1 - pstHeap->ppvHeap);
+        pstHeap->ppvTail--;
+    }
+    heapify_all(pstHeap);
+
+    for (ppvCursor = ppvKeep; ppvCursor < ppvTail; ppvCursor++)
+    {
+        if (NULL != pfOnRemoved)
+        {
+            pfOnRemoved(*heap_at(pstHeap, ppvCursor));
+        }
+        *heap_at(pstHeap, ppvCursor) = NULL;
+    }
+    heap_adjust(pstHeap);
+
+    return ppvTail - ppvKeep;
 }
 
 /*******************************************************************************
-    Func Name:  HeapNumber
- Date Created:  2014-9-18
-       Author:  Zhulinfeng
-  Description:  Return how many items in heap
-        Input:  IN Heap_S *pstHeap
-       Output:  NONE
-       Return:  UINT
-      Caution:  NONE
+    Func Name:  heap_local
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Lay a 4-ary HEAP_MAXI heap over an array of users
+        Input:  IN Heap_S *pstHeap, the heap struct, usually on stack
+                IN VOID **ppvItems
+                IN UINT uiNum, how many items in ppvItems
+                IN PF_COMPARE pfCompare
+       Output:  OUT Heap_S *pstHeap
+       Return:  NONE
+      Caution:  params should not be NULL. Nothing is allocated, the heap
+                can't grow and should not be freed by HeapFree
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
   ----------------------------------------------------------------------------
-  YYYY-MM-DD      
+  YYYY-MM-DD
 *******************************************************************************/
-UINT HeapNumber(IN Heap_S *pstHeap)
+static inline VOID heap_local(OUT Heap_S *pstHeap, IN VOID **ppvItems,
+                              IN UINT uiNum, IN PF_COMPARE pfCompare)
 {
-    UINT uiRet = 0;
+    assert(NULL != pstHeap && NULL != ppvItems && NULL != pfCompare);
 
-    if (NULL == pstHeap)
-    {
-        return 0;
-    }
+    memset(pstHeap, 0, sizeof(Heap_S));
+    pstHeap->uiSize = uiNum;
+    pstHeap->ppvHeap = ppvItems;
+    pstHeap->ppvTail = ppvItems + uiNum;
+    pstHeap->uiType = HEAP_MAXI;
+    pstHeap->uiShift = 2;     /*less levels and cache misses than binary*/
+    pstHeap->pfCompare = pfCompare;
 
-    uiRet = pstHeap->ppvTail - pstHeap->ppvHeap;
-    return uiRet;
+    return;
 }
 
 /*******************************************************************************
-    Func Name:  HeapMax
- Date Created:  2014-9-19
-       Author:  Zhulinfeng
-  Description:  Return the max item in heap
+    Func Name:  heap_sortdown
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Move the max item of heap behind the tail one by one, until
+                all items are in ascending order
         Input:  IN Heap_S *pstHeap
-       Output:  NONE
-       Return:  VOID*, the max item
-                NULL, failed
-      Caution:  NONE
+       Output:  OUT Heap_S *pstHeap, it's empty but the root then
+       Return:  NONE
+      Caution:  pstHeap should be a HEAP_MAXI heap laid by heap_local
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
   ----------------------------------------------------------------------------
-  YYYY-MM-DD      
+  YYYY-MM-DD
 *******************************************************************************/
-VOID* HeapMax(IN Heap_S *pstHeap)
+static VOID heap_sortdown(INOUT Heap_S *pstHeap)
 {
-    VOID *pvRet = NULL;
-    VOID **ppvCursor = NULL;
-    VOID **ppvLeft = NULL;
-    INT iCmpRet = 0;
+    VOID **ppvHole = NULL;
+    VOID **ppvChild = NULL;
+    VOID **ppvParent = NULL;
+    VOID *pvItem = NULL;
 
-    if (NULL == pstHeap)
-    {
-        return NULL;
-    }
+    assert(NULL != pstHeap && HEAP_MAXI == pstHeap->uiType);
+    assert(NULL == pstHeap->puiHandle && NULL == pstHeap->ppvNext);
 
-    if (BOOL_TRUE == heap_isempty(pstHeap))
+    while (pstHeap->ppvTail - pstHeap->ppvHeap > 1)
     {
-        return NULL;
+        pstHeap->ppvTail--;
+        pvItem = *(pstHeap->ppvTail);
+        *(pstHeap->ppvTail) = *(pstHeap->ppvHeap);
+
+        /**the tail item is small, it's likely to go back near the leaves, so
+           move the hole down to a leaf without comparing with the item, then
+           go up to find its place, saves about half of the compares**/
+        ppvHole = pstHeap->ppvHeap;
+        ppvChild = heap_left(pstHeap, ppvHole);
+        while (NULL != ppvChild)
+        {
+            ppvChild = heap_best(pstHeap, ppvChild);
+            *ppvHole = *ppvChild;
+            ppvHole = ppvChild;
+            ppvChild = heap_left(pstHeap, ppvHole);
+        }
+
+        ppvParent = heap_parent(pstHeap, ppvHole);
+        while (NULL != ppvParent && pstHeap->pfCompare(*ppvParent, pvItem) < 0)
+        {
+            *ppvHole = *ppvParent;
+            ppvHole = ppvParent;
+            ppvParent = heap_parent(pstHeap, ppvHole);
+        }
+        *ppvHole = pvItem;
     }
 
-    if (HEAP_MAXI == pstHeap->uiType || 1 == HeapNumber(pstHeap))
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  HeapSort
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Sort an array of items in ascending order
+        Input:  IN VOID **ppvItems, items to be sorted
+                IN UINT uiNum, how many items in ppvItems
+                IN PF_COMPARE pfCompare, callback function to compare two items
+       Output:  OUT VOID **ppvItems, items sorted
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, nothing is changed
+      Caution:  No item in ppvItems can be NULL. It's heapsort in place, costs
+                O(n log n) at worst and allocates nothing, but it's not stable
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG HeapSort(INOUT VOID **ppvItems, IN UINT uiNum, IN PF_COMPARE pfCompare)
+{
+    Heap_S stHeap;
+
+    if (NULL == ppvItems || NULL == pfCompare)
     {
-        pvRet = *pstHeap->ppvHeap;
-        return pvRet;
+        return ERROR_FAILED;
     }
 
-    ppvCursor = pstHeap->ppvTail - 1;
-    pvRet = *ppvCursor;
-    ppvLeft = heap_left(pstHeap, ppvCursor);
-    while (NULL == ppvLeft)
+    if (BOOL_TRUE != heap_checkitems(ppvItems, uiNum))
     {
-        iCmpRet = pstHeap->pfCompare(*ppvCursor, pvRet);
-        if (0 < iCmpRet)
-        {
-            pvRet = *ppvCursor;
-        }
-        ppvCursor--;
-        ppvLeft = heap_left(pstHeap, ppvCursor);
+        return ERROR_FAILED;
     }
 
-    return pvRet;
+    heap_local(&stHeap, ppvItems, uiNum, pfCompare);
+    heapify_all(&stHeap);
+    heap_sortdown(&stHeap);
+
+    return ERROR_SUCCESS;
 }
 
 /*******************************************************************************
-    Func Name:  HeapMin
- Date Created:  2014-9-19
-       Author:  Zhulinfeng
-  Description:  Return the minimal item in heap
-        Input:  IN Heap_S *pstHeap
-       Output:  NONE
-       Return:  VOID*, the minimal item
-                NULL, failed
-      Caution:  NONE
+    Func Name:  HeapPartialSort
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Put the k minimal items of an array in its front in ascending
+                order
+        Input:  IN VOID **ppvItems, items to be sorted
+                IN UINT uiNum, how many items in ppvItems
+                IN UINT uiK, how many items to be sorted
+                IN PF_COMPARE pfCompare, callback function to compare two items
+       Output:  OUT VOID **ppvItems, the first k items are sorted, the others
+                                     are behind them in no order
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, nothing is changed
+      Caution:  No item in ppvItems can be NULL, the whole array is sorted if
+                uiK is not less than uiNum. The front k items make a HEAP_MAXI
+                heap, each item behind that is less than the root replaces
+                it. Costs O(n log k), allocates nothing
   ----------------------------------------------------------------------------
   Modification History
   Date    Author    Modification
   ----------------------------------------------------------------------------
-  YYYY-MM-DD      
+  YYYY-MM-DD
 *******************************************************************************/
-VOID* HeapMin(IN Heap_S *pstHeap)
+ULONG HeapPartialSort(INOUT VOID **ppvItems, IN UINT uiNum, IN UINT uiK,
+                      IN PF_COMPARE pfCompare)
 {
-    VOID *pvRet = NULL;
-    VOID **ppvCursor = NULL;
-    VOID **ppvLeft = NULL;
-    INT iCmpRet = 0;
+    Heap_S stHeap;
+    UINT uiCount = 0;
 
-    if (NULL == pstHeap)
+    if (uiK >= uiNum)
     {
-        return NULL;
+        return HeapSort(ppvItems, uiNum, pfCompare);
     }
 
-    if (BOOL_TRUE == heap_isempty(pstHeap))
+    if (NULL == ppvItems || NULL == pfCompare)
     {
-        return NULL;
+        return ERROR_FAILED;
     }
 
-    if (HEAP_MINI == pstHeap->uiType || 1 == HeapNumber(pstHeap))
+    if (BOOL_TRUE != heap_checkitems(ppvItems, uiNum))
     {
-        pvRet = *pstHeap->ppvHeap;
-        return pvRet;
+        return ERROR_FAILED;
     }
 
-    ppvCursor = pstHeap->ppvTail - 1;
-    pvRet = *ppvCursor;
-    ppvLeft = heap_left(pstHeap, ppvCursor);
-    while (NULL == ppvLeft)
+    if (0 == uiK)
+    {
+        return ERROR_SUCCESS;
+    }
+
+    heap_local(&stHeap, ppvItems, uiK, pfCompare);
+    heapify_all(&stHeap);
+    for (uiCount = uiK; uiCount < uiNum; uiCount++)
     {
-        iCmpRet = pstHeap->pfCompare(*ppvCursor, pvRet);
-        if (0 > iCmpRet)
+        if (pfCompare(ppvItems[uiCount], *(stHeap.ppvHeap)) < 0)
         {
-            pvRet = *ppvCursor;
+            ppvItems[uiCount] = heap_replace(&stHeap, ppvItems[uiCount]);
         }
-        ppvCursor--;
-        ppvLeft = heap_left(pstHeap, ppvCursor);
     }
+    heap_sortdown(&stHeap);
 
-    return pvRet;
+    return ERROR_SUCCESS;
 }
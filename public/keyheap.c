@@ -0,0 +1,418 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   keyheap.c
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   A realization of heap with inline 64-bit keys.
+      Others:
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+/**system headfiles**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+/**public headfiles**/
+#include "../include/type.h"
+#include "../include/err.h"
+#include "../include/length.h"
+#include "../include/keyheap.h"
+/**module headfiles**/
+
+/*******************************************************************************
+    Func Name:  keyheap_up
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Put an item in a hole and push it up until its parent is
+                prior to it
+        Input:  IN KeyHeap_S *pstHeap
+                IN UINT uiPlace, the hole
+                IN UINT64 ullKey, the stored key of the item
+                IN VOID *pvItem
+       Output:  OUT KeyHeap_S *pstHeap
+       Return:  NONE
+      Caution:  pstHeap should not be NULL. The parents are moved down into
+                the hole one by one, the item is written only once at last
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline VOID keyheap_up(INOUT KeyHeap_S *pstHeap, IN UINT uiPlace,
+                              IN UINT64 ullKey, IN VOID *pvItem)
+{
+    UINT64 *pullKey = NULL;
+    VOID **ppvItem = NULL;
+    UINT uiParent = 0;
+
+    assert(NULL != pstHeap);
+    assert(uiPlace < pstHeap->uiNum);
+
+    pullKey = pstHeap->pullKey;
+    ppvItem = pstHeap->ppvItem;
+    while (uiPlace > 0)
+    {
+        uiParent = (uiPlace - 1) >> 1;
+        if (pullKey[uiParent] <= ullKey)
+        {
+            break;
+        }
+        pullKey[uiPlace] = pullKey[uiParent];
+        ppvItem[uiPlace] = ppvItem[uiParent];
+        uiPlace = uiParent;
+    }
+
+    pullKey[uiPlace] = ullKey;
+    ppvItem[uiPlace] = pvItem;
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  keyheap_down
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Put an item in a hole and push it down until no child is
+                prior to it
+        Input:  IN KeyHeap_S *pstHeap
+                IN UINT uiPlace, the hole
+                IN UINT64 ullKey, the stored key of the item
+                IN VOID *pvItem
+       Output:  OUT KeyHeap_S *pstHeap
+       Return:  NONE
+      Caution:  pstHeap should not be NULL. Only the keys are compared, the
+                items are moved along but never read
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline VOID keyheap_down(INOUT KeyHeap_S *pstHeap, IN UINT uiPlace,
+                                IN UINT64 ullKey, IN VOID *pvItem)
+{
+    UINT64 *pullKey = NULL;
+    VOID **ppvItem = NULL;
+    UINT uiChild = 0;
+    UINT uiNum = 0;
+
+    assert(NULL != pstHeap);
+    assert(uiPlace < pstHeap->uiNum);
+
+    pullKey = pstHeap->pullKey;
+    ppvItem = pstHeap->ppvItem;
+    uiNum = pstHeap->uiNum;
+    for (;;)
+    {
+        uiChild = (uiPlace << 1) + 1;
+        if (uiChild >= uiNum)
+        {
+            break;
+        }
+        if (uiChild + 1 < uiNum && pullKey[uiChild + 1] < pullKey[uiChild])
+        {
+            uiChild++;
+        }
+        if (ullKey <= pullKey[uiChild])
+        {
+            break;
+        }
+        pullKey[uiPlace] = pullKey[uiChild];
+        ppvItem[uiPlace] = ppvItem[uiChild];
+        uiPlace = uiChild;
+    }
+
+    pullKey[uiPlace] = ullKey;
+    ppvItem[uiPlace] = pvItem;
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  KeyHeapCreate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a heap of items with 64-bit keys
+        Input:  IN UINT uiSize, how many items the heap can store.
+                IN UINT uiType, KEYHEAP_MINI for minimal heap, KEYHEAP_MAXI
+                                for maximum heap
+                IN PF_PRINT pfPrint, callback function to print item
+                IN PF_FREE pfFree, callback function to free item
+       Output:  NONE
+       Return:  KeyHeap_S*,  the heap struct
+                NULL,        error occured
+      Caution:  pfPrint can be NULL
+                pfFree can be NULL if you don't want your data to be freed when
+                deleting the heap
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+KeyHeap_S* KeyHeapCreate(IN UINT uiSize, IN UINT uiType,
+                         IN PF_PRINT pfPrint,
+                         IN PF_FREE pfFree)
+{
+    KeyHeap_S *pstHeap = NULL;
+
+    if (0 == uiSize || uiType >= KEYHEAP_UPSPACE)
+    {
+        return NULL;
+    }
+
+    pstHeap = (KeyHeap_S *)malloc(sizeof(KeyHeap_S));
+    if (NULL == pstHeap)
+    {
+        return NULL;
+    }
+    memset(pstHeap, 0, sizeof(KeyHeap_S));
+
+    /**put the root in the last place of a cache line, then the two children
+       of a node sit in one cache line**/
+    if (0 != posix_memalign((VOID **)&pstHeap->pullBase, CACHE_LINE,
+                            sizeof(UINT64) * (uiSize + 1)))
+    {
+        free(pstHeap);
+        return NULL;
+    }
+
+    pstHeap->ppvItem = (VOID **)malloc(sizeof(VOID *) * uiSize);
+    if (NULL == pstHeap->ppvItem)
+    {
+        free(pstHeap->pullBase);
+        free(pstHeap);
+        return NULL;
+    }
+    memset(pstHeap->ppvItem, 0, sizeof(VOID *) * uiSize);
+
+    /**a max heap keeps the complements of keys, then both are minimal**/
+    pstHeap->ullMask = (KEYHEAP_MAXI == uiType) ? ~(UINT64)0 : 0;
+    pstHeap->pullKey = pstHeap->pullBase + 1;
+    pstHeap->uiSize = uiSize;
+    pstHeap->uiType = uiType;
+    pstHeap->pfPrint = pfPrint;
+    pstHeap->pfFree = pfFree;
+
+    return pstHeap;
+}
+
+/*******************************************************************************
+    Func Name:  KeyHeapFree
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To free a given heap
+        Input:  IN KeyHeap_S *pstHeap, the heap to be freed
+       Output:  NONE
+       Return:  NONE
+      Caution:  If you have installed PF_FREE callback function, then all the
+                itmes in the heap will be freed, otherwise it's the user's
+                responsibility to free the memeries of all items
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID KeyHeapFree(IN KeyHeap_S *pstHeap)
+{
+    UINT uiCount = 0;
+
+    if (NULL == pstHeap)
+    {
+        return;
+    }
+
+    if (NULL != pstHeap->pfFree)
+    {
+        for (uiCount = 0; uiCount < pstHeap->uiNum; uiCount++)
+        {
+            pstHeap->pfFree(pstHeap->ppvItem[uiCount]);
+        }
+    }
+
+    free(pstHeap->pullBase);
+    free(pstHeap->ppvItem);
+    free(pstHeap);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  KeyHeapAdd
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add an item with its key to heap
+        Input:  IN KeyHeap_S *pstHeap
+                IN UINT64 ullKey, key of the item
+                IN VOID *pvItem, item to be added
+       Output:  OUT KeyHeap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed
+      Caution:  pvItem should not be NULL, costs O(log n)
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG KeyHeapAdd(INOUT KeyHeap_S *pstHeap, IN UINT64 ullKey, IN VOID *pvItem)
+{
+    if (NULL == pstHeap || NULL == pvItem)
+    {
+        return ERROR_FAILED;
+    }
+
+    if (pstHeap->uiNum >= pstHeap->uiSize)
+    {
+        return ERROR_FAILED;
+    }
+
+    pstHeap->uiNum++;
+    keyheap_up(pstHeap, pstHeap->uiNum - 1, ullKey ^ pstHeap->ullMask, pvItem);
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  KeyHeapGetRoot
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  look for the root item of heap
+        Input:  IN KeyHeap_S *pstHeap
+       Output:  OUT UINT64 *pullKey, key of the root item
+       Return:  VOID*, the root item
+                NULL, the heap is empty
+      Caution:  pullKey can be NULL if the key is not wanted
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* KeyHeapGetRoot(IN KeyHeap_S *pstHeap, OUT UINT64 *pullKey)
+{
+    if (NULL == pstHeap || 0 == pstHeap->uiNum)
+    {
+        return NULL;
+    }
+
+    if (NULL != pullKey)
+    {
+        *pullKey = pstHeap->pullKey[0] ^ pstHeap->ullMask;
+    }
+
+    return pstHeap->ppvItem[0];
+}
+
+/*******************************************************************************
+    Func Name:  KeyHeapRemoveRoot
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  remove the root item from heap
+        Input:  IN KeyHeap_S *pstHeap
+       Output:  OUT UINT64 *pullKey, key of the root item
+       Return:  VOID*, the item removed out
+                NULL, failed, the heap is empty
+      Caution:  pullKey can be NULL if the key is not wanted, costs O(log n).
+                The function only removes items from heap, but the memery is
+                left to users to free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* KeyHeapRemoveRoot(INOUT KeyHeap_S *pstHeap, OUT UINT64 *pullKey)
+{
+    VOID *pvRet = NULL;
+    UINT uiTail = 0;
+
+    if (NULL == pstHeap || 0 == pstHeap->uiNum)
+    {
+        return NULL;
+    }
+
+    pvRet = pstHeap->ppvItem[0];
+    if (NULL != pullKey)
+    {
+        *pullKey = pstHeap->pullKey[0] ^ pstHeap->ullMask;
+    }
+
+    /**the tail item fills the hole of the root**/
+    pstHeap->uiNum--;
+    uiTail = pstHeap->uiNum;
+    if (0 != uiTail)
+    {
+        keyheap_down(pstHeap, 0, pstHeap->pullKey[uiTail],
+                     pstHeap->ppvItem[uiTail]);
+    }
+    pstHeap->ppvItem[uiTail] = NULL;
+
+    return pvRet;
+}
+
+/*******************************************************************************
+    Func Name:  KeyHeapPrint
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  print all items in heap
+        Input:  IN KeyHeap_S *pstHeap
+       Output:  NONE
+       Return:  NONE
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID KeyHeapPrint(IN KeyHeap_S *pstHeap)
+{
+    UINT uiCount = 0;
+
+    if (NULL == pstHeap || NULL == pstHeap->pfPrint)
+    {
+        return;
+    }
+
+    for (uiCount = 0; uiCount < pstHeap->uiNum; uiCount++)
+    {
+        pstHeap->pfPrint(pstHeap->ppvItem[uiCount]);
+    }
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  KeyHeapNumber
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many items in heap
+        Input:  IN KeyHeap_S *pstHeap
+       Output:  NONE
+       Return:  UINT
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT KeyHeapNumber(IN KeyHeap_S *pstHeap)
+{
+    if (NULL == pstHeap)
+    {
+        return 0;
+    }
+
+    return pstHeap->uiNum;
+}
@@ -0,0 +1,674 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   lfstack.c
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   A realization of lock-free stack.
+      Others:   The heads are changed by gcc atomic builtins. A node is owned
+                by the thread which has taken it off a list, until it's put
+                onto a list again, so only the links and the heads are shared
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+/**system headfiles**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+/**public headfiles**/
+#include "../include/type.h"
+#include "../include/err.h"
+#include "../include/length.h"
+#include "../include/lfstack.h"
+/**module headfiles**/
+
+/**the head word of a tag and a place + 1**/
+#define LFSTACK_HEAD(ullTag, uiPlace) (((ullTag) << 32) | (UINT64)(uiPlace))
+#define LFSTACK_TAG(ullHead)          ((ullHead) >> 32)
+#define LFSTACK_PLACE(ullHead)        ((UINT)(ullHead))
+
+/**returned by a single try of lfstack_take which loses the CAS**/
+#define LFSTACK_BUSY   0xFFFFFFFF
+/**loads of its slot a push waits for a pop to take its item**/
+#define LFSTACK_SPINS  256
+
+/**random seed of each thread, 0 if not seeded yet**/
+static __thread UINT64 g_ullLFStackSeed = 0;
+
+/*******************************************************************************
+    Func Name:  lfstack_random
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get a random number of the thread
+        Input:  IN UINT uiRange
+       Output:  NONE
+       Return:  UINT, a random number less than uiRange
+      Caution:  uiRange should not be 0. It's xorshift64 seeded by the address
+                of the thread's own seed, the same as multiqueue_random
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline UINT lfstack_random(IN UINT uiRange)
+{
+    UINT64 ullSeed = g_ullLFStackSeed;
+
+    assert(0 != uiRange);
+
+    if (0 == ullSeed)
+    {
+        ullSeed = ((UINT64)(ULONG)&g_ullLFStackSeed | 1) *
+                  0x9E3779B97F4A7C15ULL;
+    }
+
+    ullSeed ^= ullSeed << 13;
+    ullSeed ^= ullSeed >> 7;
+    ullSeed ^= ullSeed << 17;
+    g_ullLFStackSeed = ullSeed;
+
+    return (UINT)(((ullSeed >> 32) * uiRange) >> 32);
+}
+
+/*******************************************************************************
+    Func Name:  lfstack_take
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Take the top node off a list
+        Input:  IN LFStack_S *pstStack
+                IN UINT64 *pullHead, head of the list
+                IN BOOL_T bOnce, whether to try the CAS only once
+       Output:  OUT UINT64 *pullHead
+       Return:  UINT, place + 1 of the node taken
+                0, the list is empty
+                LFSTACK_BUSY, the CAS is lost in the only try
+      Caution:  params should not be NULL. The link read may be stale if the
+                node has been taken by another thread meanwhile, then the tag
+                has changed and the CAS fails, so the stale link is never
+                written to the head
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline UINT lfstack_take(IN LFStack_S *pstStack,
+                                INOUT UINT64 *pullHead,
+                                IN BOOL_T bOnce)
+{
+    UINT64 ullOld = 0;
+    UINT64 ullNew = 0;
+    UINT uiPlace = 0;
+    UINT uiNext = 0;
+
+    assert(NULL != pstStack && NULL != pullHead);
+
+    ullOld = __atomic_load_n(pullHead, __ATOMIC_ACQUIRE);
+    do
+    {
+        uiPlace = LFSTACK_PLACE(ullOld);
+        if (0 == uiPlace)
+        {
+            return 0;
+        }
+        uiNext = __atomic_load_n(&pstStack->pstNode[uiPlace - 1].uiNext,
+                                 __ATOMIC_RELAXED);
+        ullNew = LFSTACK_HEAD(LFSTACK_TAG(ullOld) + 1, uiNext);
+        if (__atomic_compare_exchange_n(pullHead, &ullOld, ullNew, 1,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE))
+        {
+            return uiPlace;
+        }
+    } while (BOOL_TRUE != bOnce);
+
+    return LFSTACK_BUSY;
+}
+
+/*******************************************************************************
+    Func Name:  lfstack_put
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Put a node onto a list
+        Input:  IN LFStack_S *pstStack
+                IN UINT64 *pullHead, head of the list
+                IN UINT uiPlace, place + 1 of the node
+                IN BOOL_T bOnce, whether to try the CAS only once
+       Output:  OUT UINT64 *pullHead
+       Return:  BOOL_T
+                BOOL_TRUE, the node is put
+                BOOL_FALSE, the CAS is lost in the only try
+      Caution:  params should not be NULL, the node should be owned by the
+                caller. The CAS releases the item and the link written before
+                it to the thread which takes the node next
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline BOOL_T lfstack_put(IN LFStack_S *pstStack,
+                                 INOUT UINT64 *pullHead,
+                                 IN UINT uiPlace,
+                                 IN BOOL_T bOnce)
+{
+    UINT64 ullOld = 0;
+    UINT64 ullNew = 0;
+
+    assert(NULL != pstStack && NULL != pullHead);
+    assert(0 != uiPlace && uiPlace <= pstStack->uiSize);
+
+    ullOld = __atomic_load_n(pullHead, __ATOMIC_RELAXED);
+    do
+    {
+        __atomic_store_n(&pstStack->pstNode[uiPlace - 1].uiNext,
+                         LFSTACK_PLACE(ullOld), __ATOMIC_RELAXED);
+        ullNew = LFSTACK_HEAD(LFSTACK_TAG(ullOld) + 1, uiPlace);
+        if (__atomic_compare_exchange_n(pullHead, &ullOld, ullNew, 1,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        {
+            return BOOL_TRUE;
+        }
+    } while (BOOL_TRUE != bOnce);
+
+    return BOOL_FALSE;
+}
+
+/*******************************************************************************
+    Func Name:  lfstack_offer
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Offer a node to a pop in a random slot of the elimination
+                array, and wait a moment for a pop to take it
+        Input:  IN LFStack_S *pstStack
+                IN UINT uiPlace, place + 1 of the node
+       Output:  OUT LFStack_S *pstStack
+       Return:  BOOL_T
+                BOOL_TRUE, a pop has taken the node
+                BOOL_FALSE, no pop came, or the slot is taken by another push,
+                            the node is still owned by the caller
+      Caution:  params should not be NULL, the node should be owned by the
+                caller and keep the item. The offer is withdrawn by a CAS
+                too, so either the pop or the push wins the node
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline BOOL_T lfstack_offer(INOUT LFStack_S *pstStack, IN UINT uiPlace)
+{
+    LFStackSlot_S *pstSlot = NULL;
+    UINT64 ullOld = 0;
+    UINT64 ullNew = 0;
+    UINT uiSpin = 0;
+
+    assert(NULL != pstStack && NULL != pstStack->pstSlot);
+    assert(0 != uiPlace && uiPlace <= pstStack->uiSize);
+
+    pstSlot = &pstStack->pstSlot[lfstack_random(pstStack->uiSlots)];
+    ullOld = __atomic_load_n(&pstSlot->ullOffer, __ATOMIC_RELAXED);
+    if (0 != LFSTACK_PLACE(ullOld))
+    {
+        return BOOL_FALSE;
+    }
+
+    ullNew = LFSTACK_HEAD(LFSTACK_TAG(ullOld) + 1, uiPlace);
+    if (!__atomic_compare_exchange_n(&pstSlot->ullOffer, &ullOld, ullNew, 0,
+                                     __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+    {
+        return BOOL_FALSE;
+    }
+
+    for (uiSpin = 0; uiSpin < LFSTACK_SPINS; uiSpin++)
+    {
+        if (ullNew != __atomic_load_n(&pstSlot->ullOffer, __ATOMIC_RELAXED))
+        {
+            break;
+        }
+    }
+
+    ullOld = ullNew;
+    ullNew = LFSTACK_HEAD(LFSTACK_TAG(ullOld) + 1, 0);
+    if (__atomic_compare_exchange_n(&pstSlot->ullOffer, &ullOld, ullNew, 0,
+                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+        return BOOL_FALSE;
+    }
+
+    return BOOL_TRUE;
+}
+
+/*******************************************************************************
+    Func Name:  lfstack_grab
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Take the node offered by a push in a random slot of the
+                elimination array
+        Input:  IN LFStack_S *pstStack
+       Output:  OUT LFStack_S *pstStack
+       Return:  UINT, place + 1 of the node taken
+                0, no node is offered in the slot, or another pop has taken it
+      Caution:  pstStack should not be NULL. A pop never waits in a slot
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline UINT lfstack_grab(INOUT LFStack_S *pstStack)
+{
+    LFStackSlot_S *pstSlot = NULL;
+    UINT64 ullOld = 0;
+    UINT64 ullNew = 0;
+
+    assert(NULL != pstStack && NULL != pstStack->pstSlot);
+
+    pstSlot = &pstStack->pstSlot[lfstack_random(pstStack->uiSlots)];
+    ullOld = __atomic_load_n(&pstSlot->ullOffer, __ATOMIC_RELAXED);
+    if (0 == LFSTACK_PLACE(ullOld))
+    {
+        return 0;
+    }
+
+    ullNew = LFSTACK_HEAD(LFSTACK_TAG(ullOld) + 1, 0);
+    if (!__atomic_compare_exchange_n(&pstSlot->ullOffer, &ullOld, ullNew, 0,
+                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        return 0;
+    }
+
+    return LFSTACK_PLACE(ullOld);
+}
+
+/*******************************************************************************
+    Func Name:  LFStackCreate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a lock-free stack
+        Input:  IN UINT uiSize, how many items the stack can store
+                IN PF_PRINT pfPrint, callback function to print item
+                IN PF_FREE pfFree, callback function to free item
+       Output:  NONE
+       Return:  LFStack_S*,  the stack struct
+                NULL,        error occured
+      Caution:  uiSize should not be 0. The stack never grows, all its nodes
+                are allocated here. pfPrint and pfFree can be NULL. Create
+                and free the stack when no other thread is using it
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+LFStack_S* LFStackCreate(IN UINT uiSize, IN PF_PRINT pfPrint,
+                         IN PF_FREE pfFree)
+{
+    LFStack_S *pstStack = NULL;
+    UINT uiCount = 0;
+
+    if (0 == uiSize || uiSize > 0x7FFFFFFF)
+    {
+        return NULL;
+    }
+
+    /**every head sits in a cache line of its own**/
+    if (0 != posix_memalign((VOID **)&pstStack, CACHE_LINE,
+                            sizeof(LFStack_S)))
+    {
+        return NULL;
+    }
+    memset(pstStack, 0, sizeof(LFStack_S));
+
+    pstStack->pstNode = (LFStackNode_S *)malloc(sizeof(LFStackNode_S) *
+                                                uiSize);
+    if (NULL == pstStack->pstNode)
+    {
+        free(pstStack);
+        return NULL;
+    }
+
+    /**node n links to node n - 1, so the first push takes the last node**/
+    for (uiCount = 0; uiCount < uiSize; uiCount++)
+    {
+        pstStack->pstNode[uiCount].pvItem = NULL;
+        pstStack->pstNode[uiCount].uiNext = uiCount;
+    }
+    pstStack->ullFree = LFSTACK_HEAD((UINT64)0, uiSize);
+    pstStack->uiSize = uiSize;
+    pstStack->pfPrint = pfPrint;
+    pstStack->pfFree = pfFree;
+
+    return pstStack;
+}
+
+/*******************************************************************************
+    Func Name:  LFStackSetEliminate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Set the elimination array of a given stack
+        Input:  IN LFStack_S *pstStack
+                IN UINT uiSlots, slots of the array, 0 for no elimination
+       Output:  OUT LFStack_S *pstStack
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, the stack is left as it was
+      Caution:  Call it when no other thread is using the stack. About half
+                the threads is a good choice of uiSlots, less slots make a
+                push and a pop meet more likely, more slots make them fight
+                less for a slot. It only pays under contention, a push that
+                wins the CAS never waits in a slot
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG LFStackSetEliminate(INOUT LFStack_S *pstStack, IN UINT uiSlots)
+{
+    LFStackSlot_S *pstSlot = NULL;
+
+    if (NULL == pstStack)
+    {
+        return ERROR_FAILED;
+    }
+
+    /**every slot sits in a cache line of its own**/
+    if (0 != uiSlots)
+    {
+        if (0 != posix_memalign((VOID **)&pstSlot, CACHE_LINE,
+                                sizeof(LFStackSlot_S) * uiSlots))
+        {
+            return ERROR_FAILED;
+        }
+        memset(pstSlot, 0, sizeof(LFStackSlot_S) * uiSlots);
+    }
+
+    free(pstStack->pstSlot);
+    pstStack->pstSlot = pstSlot;
+    pstStack->uiSlots = uiSlots;
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  LFStackFree
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To free a given stack
+        Input:  IN LFStack_S *pstStack, the stack to be freed
+       Output:  NONE
+       Return:  NONE
+      Caution:  If you have installed PF_FREE callback function, then all the
+                itmes in the stack will be freed, otherwise it's the user's
+                responsibility to free the memeries of all items
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID LFStackFree(IN LFStack_S *pstStack)
+{
+    UINT uiPlace = 0;
+
+    if (NULL == pstStack)
+    {
+        return;
+    }
+
+    if (NULL != pstStack->pfFree)
+    {
+        uiPlace = LFSTACK_PLACE(pstStack->ullTop);
+        while (0 != uiPlace)
+        {
+            pstStack->pfFree(pstStack->pstNode[uiPlace - 1].pvItem);
+            uiPlace = pstStack->pstNode[uiPlace - 1].uiNext;
+        }
+    }
+
+    free(pstStack->pstSlot);
+    free(pstStack->pstNode);
+    free(pstStack);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  LFStackPush
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Push an item onto stack
+        Input:  IN LFStack_S *pstStack
+                IN VOID *pvItem, the item to be pushed
+       Output:  OUT LFStack_S *pstStack
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, or the stack is full
+      Caution:  Thread safe. pvItem should not be NULL. A CAS is retried only
+                when another thread has changed the same head meanwhile. With
+                elimination set, a push may end by a pop taking its item in
+                the elimination array, it's never on the top then
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG LFStackPush(INOUT LFStack_S *pstStack, IN VOID *pvItem)
+{
+    UINT uiPlace = 0;
+
+    if (NULL == pstStack || NULL == pvItem)
+    {
+        return ERROR_FAILED;
+    }
+
+    uiPlace = lfstack_take(pstStack, &pstStack->ullFree, BOOL_FALSE);
+    if (0 == uiPlace)
+    {
+        return ERROR_FAILED;
+    }
+
+    /**counted before it's seen, so a pop never takes the count below 0**/
+    __atomic_store_n(&pstStack->pstNode[uiPlace - 1].pvItem, pvItem,
+                     __ATOMIC_RELAXED);
+    (VOID)__atomic_fetch_add(&pstStack->uiNum, 1, __ATOMIC_RELAXED);
+    if (NULL == pstStack->pstSlot)
+    {
+        (VOID)lfstack_put(pstStack, &pstStack->ullTop, uiPlace, BOOL_FALSE);
+        return ERROR_SUCCESS;
+    }
+
+    /**a lost CAS backs off to the elimination array before trying again**/
+    while (BOOL_TRUE != lfstack_put(pstStack, &pstStack->ullTop, uiPlace,
+                                    BOOL_TRUE))
+    {
+        if (BOOL_TRUE == lfstack_offer(pstStack, uiPlace))
+        {
+            break;
+        }
+    }
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  LFStackPop
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Pop the top item of stack
+        Input:  IN LFStack_S *pstStack
+       Output:  OUT LFStack_S *pstStack
+       Return:  VOID*, the item popped
+                NULL, the stack is empty
+      Caution:  Thread safe. With elimination set, the item may be taken from
+                a push in the elimination array instead of the top
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* LFStackPop(INOUT LFStack_S *pstStack)
+{
+    VOID *pvItem = NULL;
+    UINT uiPlace = 0;
+
+    if (NULL == pstStack)
+    {
+        return NULL;
+    }
+
+    if (NULL == pstStack->pstSlot)
+    {
+        uiPlace = lfstack_take(pstStack, &pstStack->ullTop, BOOL_FALSE);
+    }
+    else
+    {
+        /**a lost CAS looks for a push in the elimination array, and so does
+           a pop finding the stack empty, before giving up**/
+        uiPlace = lfstack_take(pstStack, &pstStack->ullTop, BOOL_TRUE);
+        while (LFSTACK_BUSY == uiPlace)
+        {
+            uiPlace = lfstack_grab(pstStack);
+            if (0 == uiPlace)
+            {
+                uiPlace = lfstack_take(pstStack, &pstStack->ullTop, BOOL_TRUE);
+            }
+        }
+        if (0 == uiPlace)
+        {
+            uiPlace = lfstack_grab(pstStack);
+        }
+    }
+    if (0 == uiPlace)
+    {
+        return NULL;
+    }
+
+    pvItem = __atomic_load_n(&pstStack->pstNode[uiPlace - 1].pvItem,
+                             __ATOMIC_RELAXED);
+    (VOID)__atomic_fetch_sub(&pstStack->uiNum, 1, __ATOMIC_RELAXED);
+    (VOID)lfstack_put(pstStack, &pstStack->ullFree, uiPlace, BOOL_FALSE);
+
+    return pvItem;
+}
+
+/*******************************************************************************
+    Func Name:  LFStackPeek
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Look for the top item of stack without popping it
+        Input:  IN LFStack_S *pstStack
+       Output:  NONE
+       Return:  VOID*, the top item
+                NULL, the stack is empty
+      Caution:  Thread safe. The item was on the top at some moment during the
+                call, another thread may have popped it when it's returned
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* LFStackPeek(IN LFStack_S *pstStack)
+{
+    VOID *pvItem = NULL;
+    UINT64 ullHead = 0;
+    UINT64 ullNow = 0;
+    UINT uiPlace = 0;
+
+    if (NULL == pstStack)
+    {
+        return NULL;
+    }
+
+    /**the item is read again if the top has changed while reading it**/
+    ullHead = __atomic_load_n(&pstStack->ullTop, __ATOMIC_ACQUIRE);
+    for (;;)
+    {
+        uiPlace = LFSTACK_PLACE(ullHead);
+        if (0 == uiPlace)
+        {
+            return NULL;
+        }
+        pvItem = __atomic_load_n(&pstStack->pstNode[uiPlace - 1].pvItem,
+                                 __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        ullNow = __atomic_load_n(&pstStack->ullTop, __ATOMIC_ACQUIRE);
+        if (ullNow == ullHead)
+        {
+            break;
+        }
+        ullHead = ullNow;
+    }
+
+    return pvItem;
+}
+
+/*******************************************************************************
+    Func Name:  LFStackPrint
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Print all items in stack from top to bottom
+        Input:  IN LFStack_S *pstStack
+       Output:  NONE
+       Return:  NONE
+      Caution:  Not thread safe, call it when no other thread is changing the
+                stack
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID LFStackPrint(IN LFStack_S *pstStack)
+{
+    UINT uiPlace = 0;
+
+    if (NULL == pstStack || NULL == pstStack->pfPrint)
+    {
+        return;
+    }
+
+    uiPlace = LFSTACK_PLACE(pstStack->ullTop);
+    while (0 != uiPlace)
+    {
+        pstStack->pfPrint(pstStack->pstNode[uiPlace - 1].pvItem);
+        uiPlace = pstStack->pstNode[uiPlace - 1].uiNext;
+    }
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  LFStackNumber
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many items in stack
+        Input:  IN LFStack_S *pstStack
+       Output:  NONE
+       Return:  UINT
+      Caution:  Thread safe, but the count may be behind a push or a pop still
+                going on in another thread
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT LFStackNumber(IN LFStack_S *pstStack)
+{
+    if (NULL == pstStack)
+    {
+        return 0;
+    }
+
+    return __atomic_load_n(&pstStack->uiNum, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,378 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   losertree.c
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   A realization of k-way merge by loser tree.
+      Others:   The k leaves are numbered k to 2k - 1 and the inner nodes 1 to
+                k - 1, the parent of node n is n / 2, so any k is fine without
+                padding to a power of 2. A stream run out loses every match,
+                no compare is called for it
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+/**system headfiles**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+/**public headfiles**/
+#include "../include/type.h"
+#include "../include/err.h"
+#include "../include/length.h"
+#include "../include/losertree.h"
+/**module headfiles**/
+
+/*******************************************************************************
+    Func Name:  losertree_beats
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Exame whether a player wins the match against another one
+        Input:  IN LoserTree_S *pstTree
+                IN LoserNode_S *pstFirst, a player
+                IN LoserNode_S *pstSecond, the other player
+       Output:  NONE
+       Return:  BOOL_T
+                BOOL_TRUE, the item of pstFirst comes out before the other
+                BOOL_FALSE, the item of pstSecond comes out first
+      Caution:  params should not be NULL. A stream run out always loses, the
+                stream in front wins if the items are equal
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline BOOL_T losertree_beats(IN LoserTree_S *pstTree,
+                                     IN LoserNode_S *pstFirst,
+                                     IN LoserNode_S *pstSecond)
+{
+    INT iCmpRet = 0;
+
+    assert(NULL != pstTree && NULL != pstFirst && NULL != pstSecond);
+
+    if (NULL == pstFirst->pvItem)
+    {
+        return BOOL_FALSE;
+    }
+    if (NULL == pstSecond->pvItem)
+    {
+        return BOOL_TRUE;
+    }
+
+    iCmpRet = pstTree->pfCompare(pstFirst->pvItem, pstSecond->pvItem);
+    if (iCmpRet < 0 || (0 == iCmpRet && pstFirst->uiWay < pstSecond->uiWay))
+    {
+        return BOOL_TRUE;
+    }
+
+    return BOOL_FALSE;
+}
+
+/*******************************************************************************
+    Func Name:  losertree_pull
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Pull out the winner, read the next item of its stream and
+                replay the matches on its path up to the top
+        Input:  IN LoserTree_S *pstTree
+       Output:  OUT LoserTree_S *pstTree
+       Return:  VOID*, the item pulled out
+                NULL, all streams run out
+      Caution:  pstTree should not be NULL. Only the winner of each match goes
+                up, the loser stays in the node. The nodes keep the items, so
+                a match loads one node instead of a stream and its head
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline VOID* losertree_pull(INOUT LoserTree_S *pstTree)
+{
+    VOID *pvRet = NULL;
+    LoserNode_S stWinner;
+    LoserNode_S stLoser;
+    UINT uiNode = 0;
+
+    assert(NULL != pstTree);
+
+    stWinner = pstTree->pstNode[0];
+    pvRet = stWinner.pvItem;
+    if (NULL == pvRet)
+    {
+        return NULL;
+    }
+
+    stWinner.pvItem = pstTree->pfNext(pstTree->ppvStream[stWinner.uiWay]);
+    if (NULL == stWinner.pvItem)
+    {
+        pstTree->uiLive--;
+    }
+
+    uiNode = (stWinner.uiWay + pstTree->uiWays) >> 1;
+    while (uiNode > 0)
+    {
+        stLoser = pstTree->pstNode[uiNode];
+        if (BOOL_TRUE == losertree_beats(pstTree, &stLoser, &stWinner))
+        {
+            pstTree->pstNode[uiNode] = stWinner;
+            stWinner = stLoser;
+        }
+        uiNode >>= 1;
+    }
+    pstTree->pstNode[0] = stWinner;
+
+    return pvRet;
+}
+
+/*******************************************************************************
+    Func Name:  LoserTreeCreate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a loser tree merging some sorted streams
+        Input:  IN VOID **ppvStreams, the streams to be merged
+                IN UINT uiWays, how many streams in ppvStreams
+                IN PF_NEXT pfNext, callback function to read a stream
+                IN PF_COMPARE pfCompare, callback function to compare two items
+       Output:  NONE
+       Return:  LoserTree_S*, the loser tree struct
+                NULL,         error occured
+      Caution:  uiWays should not be 0, pfNext and pfCompare should not be
+                NULL. The first item of every stream is read here, costs
+                O(k). The streams are not freed with the tree
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+LoserTree_S* LoserTreeCreate(IN VOID **ppvStreams, IN UINT uiWays,
+                             IN PF_NEXT pfNext,
+                             IN PF_COMPARE pfCompare)
+{
+    LoserTree_S *pstTree = NULL;
+    LoserNode_S *pstWinner = NULL;
+    LoserNode_S *pstLeft = NULL;
+    LoserNode_S *pstRight = NULL;
+    UINT uiCount = 0;
+
+    if (NULL == ppvStreams || 0 == uiWays || uiWays > 0x7FFFFFFF)
+    {
+        return NULL;
+    }
+    if (NULL == pfNext || NULL == pfCompare)
+    {
+        return NULL;
+    }
+
+    pstTree = (LoserTree_S *)malloc(sizeof(LoserTree_S));
+    if (NULL == pstTree)
+    {
+        return NULL;
+    }
+    memset(pstTree, 0, sizeof(LoserTree_S));
+
+    /**the winner of each node is needed only while building**/
+    pstTree->pstNode = (LoserNode_S *)malloc(sizeof(LoserNode_S) * uiWays);
+    pstTree->ppvStream = (VOID **)malloc(sizeof(VOID *) * uiWays);
+    pstWinner = (LoserNode_S *)malloc(sizeof(LoserNode_S) * uiWays * 2);
+    if (NULL == pstTree->pstNode || NULL == pstTree->ppvStream ||
+        NULL == pstWinner)
+    {
+        free(pstWinner);
+        LoserTreeFree(pstTree);
+        return NULL;
+    }
+
+    pstTree->uiWays = uiWays;
+    pstTree->pfNext = pfNext;
+    pstTree->pfCompare = pfCompare;
+    memcpy(pstTree->ppvStream, ppvStreams, sizeof(VOID *) * uiWays);
+
+    for (uiCount = 0; uiCount < uiWays; uiCount++)
+    {
+        pstWinner[uiWays + uiCount].pvItem = pfNext(ppvStreams[uiCount]);
+        pstWinner[uiWays + uiCount].uiWay = uiCount;
+        if (NULL != pstWinner[uiWays + uiCount].pvItem)
+        {
+            pstTree->uiLive++;
+        }
+    }
+
+    for (uiCount = uiWays - 1; uiCount > 0; uiCount--)
+    {
+        pstLeft = &pstWinner[uiCount * 2];
+        pstRight = &pstWinner[uiCount * 2 + 1];
+        if (BOOL_TRUE == losertree_beats(pstTree, pstLeft, pstRight))
+        {
+            pstWinner[uiCount] = *pstLeft;
+            pstTree->pstNode[uiCount] = *pstRight;
+        }
+        else
+        {
+            pstWinner[uiCount] = *pstRight;
+            pstTree->pstNode[uiCount] = *pstLeft;
+        }
+    }
+
+    /**a single stream is leaf 1, the winner of itself**/
+    pstTree->pstNode[0] = pstWinner[1];
+    free(pstWinner);
+
+    return pstTree;
+}
+
+/*******************************************************************************
+    Func Name:  LoserTreeFree
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To free a given loser tree
+        Input:  IN LoserTree_S *pstTree, the loser tree to be freed
+       Output:  NONE
+       Return:  NONE
+      Caution:  The items not pulled out yet are left in their streams, except
+                the head item read from each stream
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID LoserTreeFree(IN LoserTree_S *pstTree)
+{
+    if (NULL == pstTree)
+    {
+        return;
+    }
+
+    free(pstTree->pstNode);
+    free(pstTree->ppvStream);
+    free(pstTree);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  LoserTreeNext
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Pull out the least item of all streams
+        Input:  IN LoserTree_S *pstTree
+       Output:  OUT LoserTree_S *pstTree
+       Return:  VOID*, the item pulled out
+                NULL, all streams run out
+      Caution:  costs log2(k) compares and one PF_NEXT call. Equal items come
+                out in the order of their streams, so the merge is stable
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* LoserTreeNext(INOUT LoserTree_S *pstTree)
+{
+    if (NULL == pstTree)
+    {
+        return NULL;
+    }
+
+    return losertree_pull(pstTree);
+}
+
+/*******************************************************************************
+    Func Name:  LoserTreeNextN
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Pull out at most n least items of all streams
+        Input:  IN LoserTree_S *pstTree
+                IN UINT uiNum, how many items to pull out at most
+       Output:  OUT LoserTree_S *pstTree
+                OUT VOID **ppvItems, items pulled out, in ascending order
+       Return:  UINT, how many items pulled out, less than uiNum if all
+                      streams run out
+      Caution:  ppvItems should hold uiNum items. It's the same as uiNum
+                LoserTreeNext calls, but without a call for each item
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT LoserTreeNextN(INOUT LoserTree_S *pstTree, IN UINT uiNum,
+                    OUT VOID **ppvItems)
+{
+    UINT uiCount = 0;
+
+    if (NULL == pstTree || NULL == ppvItems)
+    {
+        return 0;
+    }
+
+    for (uiCount = 0; uiCount < uiNum; uiCount++)
+    {
+        ppvItems[uiCount] = losertree_pull(pstTree);
+        if (NULL == ppvItems[uiCount])
+        {
+            break;
+        }
+    }
+
+    return uiCount;
+}
+
+/*******************************************************************************
+    Func Name:  LoserTreePeek
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Look for the least item of all streams without pulling it out
+        Input:  IN LoserTree_S *pstTree
+       Output:  NONE
+       Return:  VOID*, the least item
+                NULL, all streams run out
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* LoserTreePeek(IN LoserTree_S *pstTree)
+{
+    if (NULL == pstTree)
+    {
+        return NULL;
+    }
+
+    return pstTree->pstNode[0].pvItem;
+}
+
+/*******************************************************************************
+    Func Name:  LoserTreeLive
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many streams have not run out
+        Input:  IN LoserTree_S *pstTree
+       Output:  NONE
+       Return:  UINT
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT LoserTreeLive(IN LoserTree_S *pstTree)
+{
+    if (NULL == pstTree)
+    {
+        return 0;
+    }
+
+    return pstTree->uiLive;
+}
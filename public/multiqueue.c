@@ -0,0 +1,478 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   multiqueue.c
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   A realization of multiqueue.
+      Others:   The locks are taken by gcc atomic builtins
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+/**system headfiles**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+/**public headfiles**/
+#include "../include/type.h"
+#include "../include/err.h"
+#include "../include/length.h"
+#include "../include/heap.h"
+#include "../include/multiqueue.h"
+/**module headfiles**/
+
+/**random picks of two heaps that are both empty before looking through all**/
+#define MULTIQUEUE_TRIES  4
+
+/**random seed of each thread, 0 if not seeded yet**/
+static __thread UINT64 g_ullMultiQueueSeed = 0;
+
+/*******************************************************************************
+    Func Name:  multiqueue_random
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get a random number of the thread
+        Input:  IN UINT uiRange
+       Output:  NONE
+       Return:  UINT, a random number less than uiRange
+      Caution:  uiRange should not be 0. It's xorshift64 seeded by the address
+                of the thread's own seed, no lock is needed as rand() does
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline UINT multiqueue_random(IN UINT uiRange)
+{
+    UINT64 ullSeed = g_ullMultiQueueSeed;
+
+    assert(0 != uiRange);
+
+    if (0 == ullSeed)
+    {
+        ullSeed = ((UINT64)(ULONG)&g_ullMultiQueueSeed | 1) *
+                  0x9E3779B97F4A7C15ULL;
+    }
+
+    ullSeed ^= ullSeed << 13;
+    ullSeed ^= ullSeed >> 7;
+    ullSeed ^= ullSeed << 17;
+    g_ullMultiQueueSeed = ullSeed;
+
+    return (UINT)(((ullSeed >> 32) * uiRange) >> 32);
+}
+
+/*******************************************************************************
+    Func Name:  multiqueue_trylock
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Try to take the lock of a heap
+        Input:  IN MultiQueueSlot_S *pstSlot
+       Output:  OUT MultiQueueSlot_S *pstSlot
+       Return:  BOOL_T
+                BOOL_TRUE, the lock is taken
+                BOOL_FALSE, the lock is taken by another thread
+      Caution:  pstSlot should not be NULL. The lock is read before written,
+                so a taken lock costs no cache line exchange
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline BOOL_T multiqueue_trylock(INOUT MultiQueueSlot_S *pstSlot)
+{
+    assert(NULL != pstSlot);
+
+    if (0 != __atomic_load_n(&pstSlot->uiLock, __ATOMIC_RELAXED))
+    {
+        return BOOL_FALSE;
+    }
+
+    if (0 != __atomic_exchange_n(&pstSlot->uiLock, 1, __ATOMIC_ACQUIRE))
+    {
+        return BOOL_FALSE;
+    }
+
+    return BOOL_TRUE;
+}
+
+/*******************************************************************************
+    Func Name:  multiqueue_lock
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Take the lock of a heap, wait if it's taken
+        Input:  IN MultiQueueSlot_S *pstSlot
+       Output:  OUT MultiQueueSlot_S *pstSlot
+       Return:  NONE
+      Caution:  pstSlot should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline VOID multiqueue_lock(INOUT MultiQueueSlot_S *pstSlot)
+{
+    assert(NULL != pstSlot);
+
+    while (BOOL_TRUE != multiqueue_trylock(pstSlot))
+    {
+    }
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  multiqueue_unlock
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Release the lock of a heap
+        Input:  IN MultiQueueSlot_S *pstSlot
+       Output:  OUT MultiQueueSlot_S *pstSlot
+       Return:  NONE
+      Caution:  pstSlot should not be NULL, and its lock should be taken
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline VOID multiqueue_unlock(INOUT MultiQueueSlot_S *pstSlot)
+{
+    assert(NULL != pstSlot);
+    assert(0 != __atomic_load_n(&pstSlot->uiLock, __ATOMIC_RELAXED));
+
+    __atomic_store_n(&pstSlot->uiLock, 0, __ATOMIC_RELEASE);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  multiqueue_best
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get the heap of the prior root of two heaps
+        Input:  IN MultiQueue_S *pstQueue
+                IN MultiQueueSlot_S *pstFirst
+                IN MultiQueueSlot_S *pstSecond
+       Output:  NONE
+       Return:  MultiQueueSlot_S*, the heap of the prior root
+                NULL, both heaps are empty
+      Caution:  params should not be NULL, and both heaps should be locked
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline MultiQueueSlot_S* multiqueue_best(IN MultiQueue_S *pstQueue,
+                                                IN MultiQueueSlot_S *pstFirst,
+                                                IN MultiQueueSlot_S *pstSecond)
+{
+    Heap_S *pstHeap = NULL;
+    INT iCmpRet = 0;
+
+    assert(NULL != pstQueue && NULL != pstFirst && NULL != pstSecond);
+
+    if (0 == HeapNumber(pstFirst->pstHeap))
+    {
+        return (0 == HeapNumber(pstSecond->pstHeap)) ? NULL : pstSecond;
+    }
+    if (0 == HeapNumber(pstSecond->pstHeap))
+    {
+        return pstFirst;
+    }
+
+    pstHeap = pstFirst->pstHeap;
+    iCmpRet = pstHeap->pfCompare(*pstSecond->pstHeap->ppvHeap,
+                                 *pstHeap->ppvHeap);
+    if ((HEAP_MINI == pstQueue->uiType && iCmpRet < 0) ||
+        (HEAP_MAXI == pstQueue->uiType && iCmpRet > 0))
+    {
+        return pstSecond;
+    }
+
+    return pstFirst;
+}
+
+/*******************************************************************************
+    Func Name:  MultiQueueCreate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a multiqueue
+        Input:  IN UINT uiHeaps, how many heaps the items are spread over
+                IN UINT uiSize, how many items a heap can store at first
+                IN UINT uiType, HEAP_MINI for minimal heap, HEAP_MAXI for
+                                maximum heap
+                IN PF_COMPARE pfCompare, callback function to compare two items
+                IN PF_PRINT pfPrint, callback function to print item
+                IN PF_FREE pfFree, callback function to free item
+       Output:  NONE
+       Return:  MultiQueue_S*,  the multiqueue struct
+                NULL,           error occured
+      Caution:  uiHeaps should not be less than 2. The heaps grow when they are
+                full, see HeapSetGrow. pfCompare should not be NULL, pfPrint
+                and pfFree can be NULL. Create and free the multiqueue when no
+                other thread is using it
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+MultiQueue_S* MultiQueueCreate(IN UINT uiHeaps, IN UINT uiSize, IN UINT uiType,
+                               IN PF_COMPARE pfCompare,
+                               IN PF_PRINT pfPrint,
+                               IN PF_FREE pfFree)
+{
+    MultiQueue_S *pstQueue = NULL;
+    MultiQueueSlot_S *pstSlot = NULL;
+    UINT uiCount = 0;
+
+    if (uiHeaps < 2 || (HEAP_MINI != uiType && HEAP_MAXI != uiType))
+    {
+        return NULL;
+    }
+
+    pstQueue = (MultiQueue_S *)malloc(sizeof(MultiQueue_S));
+    if (NULL == pstQueue)
+    {
+        return NULL;
+    }
+    memset(pstQueue, 0, sizeof(MultiQueue_S));
+
+    /**every lock sits in a cache line of its own**/
+    if (0 != posix_memalign((VOID **)&pstSlot, CACHE_LINE,
+                            sizeof(MultiQueueSlot_S) * uiHeaps))
+    {
+        free(pstQueue);
+        return NULL;
+    }
+    memset(pstSlot, 0, sizeof(MultiQueueSlot_S) * uiHeaps);
+    pstQueue->pstSlot = pstSlot;
+    pstQueue->uiHeaps = uiHeaps;
+    pstQueue->uiType = uiType;
+
+    for (uiCount = 0; uiCount < uiHeaps; uiCount++)
+    {
+        pstSlot[uiCount].pstHeap = HeapCreate(uiSize, uiType, pfCompare,
+                                              pfPrint, pfFree);
+        if (NULL == pstSlot[uiCount].pstHeap)
+        {
+            MultiQueueFree(pstQueue);
+            return NULL;
+        }
+        (VOID)HeapSetGrow(pstSlot[uiCount].pstHeap, 0);
+    }
+
+    return pstQueue;
+}
+
+/*******************************************************************************
+    Func Name:  MultiQueueFree
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To free a given multiqueue
+        Input:  IN MultiQueue_S *pstQueue, the multiqueue to be freed
+       Output:  NONE
+       Return:  NONE
+      Caution:  If you have installed PF_FREE callback function, then all the
+                itmes in the multiqueue will be freed, otherwise it's the
+                user's responsibility to free the memeries of all items
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID MultiQueueFree(IN MultiQueue_S *pstQueue)
+{
+    UINT uiCount = 0;
+
+    if (NULL == pstQueue)
+    {
+        return;
+    }
+
+    for (uiCount = 0; uiCount < pstQueue->uiHeaps; uiCount++)
+    {
+        HeapFree(pstQueue->pstSlot[uiCount].pstHeap);
+    }
+
+    free(pstQueue->pstSlot);
+    free(pstQueue);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  MultiQueueAdd
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add an item to a random heap of multiqueue
+        Input:  IN MultiQueue_S *pstQueue
+                IN VOID *pvItem, item to be added
+       Output:  OUT MultiQueue_S *pstQueue
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed
+      Caution:  pvItem should not be NULL. It's thread safe, a heap taken by
+                another thread is skipped instead of waited for
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG MultiQueueAdd(INOUT MultiQueue_S *pstQueue, IN VOID *pvItem)
+{
+    MultiQueueSlot_S *pstSlot = NULL;
+    ULONG ulRet = ERROR_SUCCESS;
+
+    if (NULL == pstQueue || NULL == pvItem)
+    {
+        return ERROR_FAILED;
+    }
+
+    do
+    {
+        pstSlot = &pstQueue->pstSlot[multiqueue_random(pstQueue->uiHeaps)];
+    } while (BOOL_TRUE != multiqueue_trylock(pstSlot));
+
+    ulRet = HeapAdd(pstSlot->pstHeap, pvItem);
+    multiqueue_unlock(pstSlot);
+
+    return ulRet;
+}
+
+/*******************************************************************************
+    Func Name:  MultiQueueRemoveRoot
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Remove the prior root of two random heaps of multiqueue
+        Input:  IN MultiQueue_S *pstQueue
+       Output:  OUT MultiQueue_S *pstQueue
+       Return:  VOID*, the item removed out
+                NULL, the multiqueue is empty
+      Caution:  It's thread safe. The two heaps are both locked to compare
+                their roots, for a root read without lock may be removed and
+                freed by another thread. If random picks keep finding empty
+                heaps, all heaps are looked through before NULL is returned.
+                The memery of the item is left to users to free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* MultiQueueRemoveRoot(INOUT MultiQueue_S *pstQueue)
+{
+    MultiQueueSlot_S *pstFirst = NULL;
+    MultiQueueSlot_S *pstSecond = NULL;
+    MultiQueueSlot_S *pstBest = NULL;
+    VOID *pvRet = NULL;
+    UINT uiFirst = 0;
+    UINT uiSecond = 0;
+    UINT uiTry = 0;
+
+    if (NULL == pstQueue)
+    {
+        return NULL;
+    }
+
+    while (uiTry < MULTIQUEUE_TRIES)
+    {
+        uiFirst = multiqueue_random(pstQueue->uiHeaps);
+        uiSecond = multiqueue_random(pstQueue->uiHeaps - 1);
+        if (uiSecond >= uiFirst)
+        {
+            uiSecond++;
+        }
+        pstFirst = &pstQueue->pstSlot[uiFirst];
+        pstSecond = &pstQueue->pstSlot[uiSecond];
+
+        /**try-locks never wait, so two of them can't deadlock**/
+        if (BOOL_TRUE != multiqueue_trylock(pstFirst))
+        {
+            continue;
+        }
+        if (BOOL_TRUE != multiqueue_trylock(pstSecond))
+        {
+            multiqueue_unlock(pstFirst);
+            continue;
+        }
+
+        pstBest = multiqueue_best(pstQueue, pstFirst, pstSecond);
+        if (NULL != pstBest)
+        {
+            pvRet = HeapRemoveRoot(pstBest->pstHeap);
+        }
+        multiqueue_unlock(pstSecond);
+        multiqueue_unlock(pstFirst);
+
+        if (NULL != pvRet)
+        {
+            return pvRet;
+        }
+        uiTry++;
+    }
+
+    for (uiFirst = 0; uiFirst < pstQueue->uiHeaps; uiFirst++)
+    {
+        pstFirst = &pstQueue->pstSlot[uiFirst];
+        multiqueue_lock(pstFirst);
+        pvRet = HeapRemoveRoot(pstFirst->pstHeap);
+        multiqueue_unlock(pstFirst);
+        if (NULL != pvRet)
+        {
+            return pvRet;
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+    Func Name:  MultiQueueNumber
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many items in multiqueue
+        Input:  IN MultiQueue_S *pstQueue
+       Output:  NONE
+       Return:  UINT
+      Caution:  Each heap is counted under its lock, the total is not exact if
+                other threads are changing the multiqueue
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT MultiQueueNumber(IN MultiQueue_S *pstQueue)
+{
+    MultiQueueSlot_S *pstSlot = NULL;
+    UINT uiRet = 0;
+    UINT uiCount = 0;
+
+    if (NULL == pstQueue)
+    {
+        return 0;
+    }
+
+    for (uiCount = 0; uiCount < pstQueue->uiHeaps; uiCount++)
+    {
+        pstSlot = &pstQueue->pstSlot[uiCount];
+        multiqueue_lock(pstSlot);
+        uiRet += HeapNumber(pstSlot->pstHeap);
+        multiqueue_unlock(pstSlot);
+    }
+
+    return uiRet;
+}
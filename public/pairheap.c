@@ -0,0 +1,481 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   pairheap.c
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   A realization of pairing heap.
+      Others:
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+/**system headfiles**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+/**public headfiles**/
+#include "../include/type.h"
+#include "../include/err.h"
+#include "../include/pairheap.h"
+/**module headfiles**/
+
+/*******************************************************************************
+    Func Name:  pairheap_meld
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Meld two trees, the root of the prior one takes the other one
+                as its first child
+        Input:  IN PairHeap_S *pstHeap
+                IN PairNode_S *pstFirst
+                IN PairNode_S *pstSecond
+       Output:  NONE
+       Return:  PairNode_S*, root of the tree melded
+      Caution:  params should not be NULL, the two roots should have no
+                sibling. pstFirst keeps the root if they are equal
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline PairNode_S* pairheap_meld(IN PairHeap_S *pstHeap,
+                                        IN PairNode_S *pstFirst,
+                                        IN PairNode_S *pstSecond)
+{
+    PairNode_S *pstTmp = NULL;
+    INT iCmpRet = 0;
+
+    assert(NULL != pstHeap && NULL != pstFirst && NULL != pstSecond);
+    assert(NULL == pstFirst->pstSibling && NULL == pstSecond->pstSibling);
+
+    iCmpRet = pstHeap->pfCompare(pstSecond->pvItem, pstFirst->pvItem);
+    if ((PAIRHEAP_MINI == pstHeap->uiType && iCmpRet < 0) ||
+        (PAIRHEAP_MAXI == pstHeap->uiType && iCmpRet > 0))
+    {
+        pstTmp = pstFirst;
+        pstFirst = pstSecond;
+        pstSecond = pstTmp;
+    }
+
+    pstSecond->pstSibling = pstFirst->pstChild;
+    pstFirst->pstChild = pstSecond;
+
+    return pstFirst;
+}
+
+/*******************************************************************************
+    Func Name:  pairheap_combine
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Meld a list of siblings into one tree by two passes, meld them
+                in pairs from left to right, then meld the pairs from right to
+                left
+        Input:  IN PairHeap_S *pstHeap
+                IN PairNode_S *pstList, the first sibling
+       Output:  NONE
+       Return:  PairNode_S*, root of the tree melded
+                NULL, the list is empty
+      Caution:  pstHeap should not be NULL, the pairs are kept in a stack
+                linked by pstSibling, so no recursion goes deep
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static PairNode_S* pairheap_combine(IN PairHeap_S *pstHeap,
+                                    IN PairNode_S *pstList)
+{
+    PairNode_S *pstFirst = NULL;
+    PairNode_S *pstSecond = NULL;
+    PairNode_S *pstPaired = NULL;
+    PairNode_S *pstRet = NULL;
+
+    assert(NULL != pstHeap);
+
+    while (NULL != pstList)
+    {
+        pstFirst = pstList;
+        pstSecond = pstFirst->pstSibling;
+        if (NULL == pstSecond)
+        {
+            pstList = NULL;
+        }
+        else
+        {
+            pstList = pstSecond->pstSibling;
+            pstFirst->pstSibling = NULL;
+            pstSecond->pstSibling = NULL;
+            pstFirst = pairheap_meld(pstHeap, pstFirst, pstSecond);
+        }
+        pstFirst->pstSibling = pstPaired;
+        pstPaired = pstFirst;
+    }
+
+    while (NULL != pstPaired)
+    {
+        pstFirst = pstPaired;
+        pstPaired = pstPaired->pstSibling;
+        pstFirst->pstSibling = NULL;
+        pstRet = (NULL == pstRet) ? pstFirst :
+                 pairheap_meld(pstHeap, pstRet, pstFirst);
+    }
+
+    return pstRet;
+}
+
+/*******************************************************************************
+    Func Name:  PairHeapCreate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a pairing heap
+        Input:  IN UINT uiType, PAIRHEAP_MINI for minimal heap, PAIRHEAP_MAXI
+                                for maximum heap
+                IN PF_COMPARE pfCompare, callback function to compare two items
+                IN PF_PRINT pfPrint, callback function to print item
+                IN PF_FREE pfFree, callback function to free item
+       Output:  NONE
+       Return:  PairHeap_S*,  the heap struct
+                NULL,         error occured
+      Caution:  pfCompare should not be NULL,
+                pfPrint can be NULL
+                pfFree can be NULL if you don't want your data to be freed when
+                deleting the heap
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+PairHeap_S* PairHeapCreate(IN UINT uiType,
+                           IN PF_COMPARE pfCompare,
+                           IN PF_PRINT pfPrint,
+                           IN PF_FREE pfFree)
+{
+    PairHeap_S *pstHeap = NULL;
+
+    if (uiType >= PAIRHEAP_UPSPACE || NULL == pfCompare)
+    {
+        return NULL;
+    }
+
+    pstHeap = (PairHeap_S *)malloc(sizeof(PairHeap_S));
+    if (NULL == pstHeap)
+    {
+        return NULL;
+    }
+    memset(pstHeap, 0, sizeof(PairHeap_S));
+
+    pstHeap->uiType = uiType;
+    pstHeap->pfCompare = pfCompare;
+    pstHeap->pfPrint = pfPrint;
+    pstHeap->pfFree = pfFree;
+
+    return pstHeap;
+}
+
+/*******************************************************************************
+    Func Name:  PairHeapFree
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To free a given heap
+        Input:  IN PairHeap_S *pstHeap, the heap to be freed
+       Output:  NONE
+       Return:  NONE
+      Caution:  If you have installed PF_FREE callback function, then all the
+                itmes in the heap will be freed, otherwise it's the user's
+                responsibility to free the memeries of all items
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID PairHeapFree(IN PairHeap_S *pstHeap)
+{
+    PairNode_S *pstCursor = NULL;
+    PairNode_S *pstChild = NULL;
+
+    if (NULL == pstHeap)
+    {
+        return;
+    }
+
+    /**rotate the first child up in front of its parent until the cursor has
+       no child, then it can be freed and its sibling is the next one**/
+    pstCursor = pstHeap->pstRoot;
+    while (NULL != pstCursor)
+    {
+        pstChild = pstCursor->pstChild;
+        if (NULL != pstChild)
+        {
+            pstCursor->pstChild = pstChild->pstSibling;
+            pstChild->pstSibling = pstCursor;
+            pstCursor = pstChild;
+            continue;
+        }
+
+        pstChild = pstCursor->pstSibling;
+        if (NULL != pstHeap->pfFree)
+        {
+            pstHeap->pfFree(pstCursor->pvItem);
+        }
+        free(pstCursor);
+        pstCursor = pstChild;
+    }
+
+    free(pstHeap);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  PairHeapAdd
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add an item to heap
+        Input:  IN PairHeap_S *pstHeap
+                IN VOID *pvItem, item to be added
+       Output:  OUT PairHeap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed
+      Caution:  pvItem should not be NULL, costs O(1)
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG PairHeapAdd(INOUT PairHeap_S *pstHeap, IN VOID *pvItem)
+{
+    PairNode_S *pstNode = NULL;
+
+    if (NULL == pstHeap || NULL == pvItem)
+    {
+        return ERROR_FAILED;
+    }
+
+    pstNode = (PairNode_S *)malloc(sizeof(PairNode_S));
+    if (NULL == pstNode)
+    {
+        return ERROR_FAILED;
+    }
+    pstNode->pstChild = NULL;
+    pstNode->pstSibling = NULL;
+    pstNode->pvItem = pvItem;
+
+    if (NULL == pstHeap->pstRoot)
+    {
+        pstHeap->pstRoot = pstNode;
+    }
+    else
+    {
+        pstHeap->pstRoot = pairheap_meld(pstHeap, pstHeap->pstRoot, pstNode);
+    }
+    pstHeap->uiNum++;
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  PairHeapMerge
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Move all items of a heap into another one
+        Input:  IN PairHeap_S *pstHeap, the heap to merge into
+                IN PairHeap_S *pstOther, the heap to be merged
+       Output:  OUT PairHeap_S *pstHeap
+                OUT PairHeap_S *pstOther, it's empty then
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed, the heaps are of different types or
+                                compare functions
+      Caution:  costs O(1), no item is compared but the two roots. pstOther is
+                left empty but not freed
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG PairHeapMerge(INOUT PairHeap_S *pstHeap, INOUT PairHeap_S *pstOther)
+{
+    if (NULL == pstHeap || NULL == pstOther || pstHeap == pstOther)
+    {
+        return ERROR_FAILED;
+    }
+
+    if (pstHeap->uiType != pstOther->uiType ||
+        pstHeap->pfCompare != pstOther->pfCompare)
+    {
+        return ERROR_FAILED;
+    }
+
+    if (NULL == pstOther->pstRoot)
+    {
+        return ERROR_SUCCESS;
+    }
+
+    if (NULL == pstHeap->pstRoot)
+    {
+        pstHeap->pstRoot = pstOther->pstRoot;
+    }
+    else
+    {
+        pstHeap->pstRoot = pairheap_meld(pstHeap, pstHeap->pstRoot,
+                                         pstOther->pstRoot);
+    }
+    pstHeap->uiNum += pstOther->uiNum;
+
+    pstOther->pstRoot = NULL;
+    pstOther->uiNum = 0;
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  PairHeapGetRoot
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  look for the root item of heap
+        Input:  IN PairHeap_S *pstHeap
+       Output:  NONE
+       Return:  VOID*, the root item
+                NULL, the heap is empty
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* PairHeapGetRoot(IN PairHeap_S *pstHeap)
+{
+    if (NULL == pstHeap || NULL == pstHeap->pstRoot)
+    {
+        return NULL;
+    }
+
+    return pstHeap->pstRoot->pvItem;
+}
+
+/*******************************************************************************
+    Func Name:  PairHeapRemoveRoot
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  remove the root item from heap
+        Input:  IN PairHeap_S *pstHeap
+       Output:  NONE
+       Return:  VOID*, the item removed out
+                NULL, failed, the heap is empty
+      Caution:  amortized costs O(log n). The function only removes items from
+                heap, but the memery is left to users to free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* PairHeapRemoveRoot(INOUT PairHeap_S *pstHeap)
+{
+    PairNode_S *pstRoot = NULL;
+    VOID *pvRet = NULL;
+
+    if (NULL == pstHeap || NULL == pstHeap->pstRoot)
+    {
+        return NULL;
+    }
+
+    pstRoot = pstHeap->pstRoot;
+    pvRet = pstRoot->pvItem;
+    pstHeap->pstRoot = pairheap_combine(pstHeap, pstRoot->pstChild);
+    pstHeap->uiNum--;
+    free(pstRoot);
+
+    return pvRet;
+}
+
+/*******************************************************************************
+    Func Name:  PairHeapPrint
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  print all items in heap
+        Input:  IN PairHeap_S *pstHeap
+       Output:  NONE
+       Return:  NONE
+      Caution:  the root first, then each item before its children and its
+                younger siblings
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID PairHeapPrint(IN PairHeap_S *pstHeap)
+{
+    PairNode_S **ppstStack = NULL;
+    PairNode_S *pstCursor = NULL;
+    UINT uiTop = 0;
+
+    if (NULL == pstHeap || NULL == pstHeap->pfPrint || 0 == pstHeap->uiNum)
+    {
+        return;
+    }
+
+    /**a node is pushed only once, the tree may be too deep to recurse**/
+    ppstStack = (PairNode_S **)malloc(sizeof(PairNode_S *) * pstHeap->uiNum);
+    if (NULL == ppstStack)
+    {
+        return;
+    }
+
+    ppstStack[uiTop++] = pstHeap->pstRoot;
+    while (0 != uiTop)
+    {
+        pstCursor = ppstStack[--uiTop];
+        pstHeap->pfPrint(pstCursor->pvItem);
+        if (NULL != pstCursor->pstSibling)
+        {
+            ppstStack[uiTop++] = pstCursor->pstSibling;
+        }
+        if (NULL != pstCursor->pstChild)
+        {
+            ppstStack[uiTop++] = pstCursor->pstChild;
+        }
+    }
+
+    free(ppstStack);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  PairHeapNumber
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many items in heap
+        Input:  IN PairHeap_S *pstHeap
+       Output:  NONE
+       Return:  UINT
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT PairHeapNumber(IN PairHeap_S *pstHeap)
+{
+    if (NULL == pstHeap)
+    {
+        return 0;
+    }
+
+    return pstHeap->uiNum;
+}
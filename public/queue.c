@@ -25,6 +25,42 @@ Copyright(C):   Huazhong University of Science & Technology.
 #include "../include/queue.h"
 /**module headfiles**/
 
+/**items moved to the next memery each time a growing queue is changed**/
+#define QUEUE_MOVESTEP  4
+
+/**the largest queue**/
+#define QUEUE_SIZEMAX   0x7FFFFFFE
+
+/*******************************************************************************
+    Func Name:  queue_value
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get the slot of a record in value queue
+        Input:  IN Queue_S *pstQueue
+                IN UINT uiPlace, place of the record from the first one
+       Output:  NONE
+       Return:  VOID*, the slot
+      Caution:  pstQueue should not be NULL, and should be a value queue. The
+                place wraps to the start of the ring
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline VOID* queue_value(IN Queue_S *pstQueue, IN UINT uiPlace)
+{
+    assert(NULL != pstQueue && NULL != pstQueue->pcValue);
+
+    uiPlace += pstQueue->uiValueHead;
+    if (uiPlace >= pstQueue->uiSize)
+    {
+        uiPlace -= pstQueue->uiSize;
+    }
+
+    return pstQueue->pcValue + (ULONG)uiPlace * pstQueue->uiElemSize;
+}
+
 /*******************************************************************************
     Func Name:  queue_isfull
  Date Created:  2014-9-19
@@ -48,7 +84,14 @@ static inline BOOL_T queue_isfull(IN Queue_S *pstQueue)
 
     assert(NULL != pstQueue);
 
-    if (pstQueue->ppvTail > pstQueue->ppvHead)
+    if (NULL != pstQueue->pcValue)
+    {
+        if (pstQueue->uiValues >= pstQueue->uiSize)
+        {
+            bRet = BOOL_TRUE;
+        }
+    }
+    else if (pstQueue->ppvTail > pstQueue->ppvHead)
     {
         if (1 == pstQueue->ppvHead + pstQueue->uiSize - pstQueue->ppvTail)
         {
@@ -89,7 +132,7 @@ static inline BOOL_T queue_isempty(IN Queue_S *pstQueue)
 
     assert(NULL != pstQueue);
 
-    if (pstQueue->ppvHead == pstQueue->ppvTail)
+    if (pstQueue->ppvHead == pstQueue->ppvTail && 0 == pstQueue->uiValues)
     {
         bRet = BOOL_TRUE;
     }
@@ -97,6 +140,297 @@ static inline BOOL_T queue_isempty(IN Queue_S *pstQueue)
     return bRet;
 }
 
+/*******************************************************************************
+    Func Name:  queue_move
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Move some items of the queue to the next memery, and switch to
+                the next memery if all items are moved
+        Input:  IN Queue_S *pstQueue
+                IN UINT uiSteps, how many items to move at most, 0 for all
+       Output:  OUT Queue_S *pstQueue
+       Return:  NONE
+      Caution:  pstQueue should not be NULL, the queue should be moving. The 
+                items are put in the next memery from the first place in the
+                order they're in queue, so the queue doesn't wrap there
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static VOID queue_move(INOUT Queue_S *pstQueue, IN UINT uiSteps)
+{
+    UINT uiNum = 0;
+    UINT uiCount = 0;
+
+    assert(NULL != pstQueue && NULL != pstQueue->ppvNext);
+
+    uiNum = QueueNumber(pstQueue);
+
+    /**items removed before being moved needn't be moved**/
+    if (pstQueue->uiMoved < pstQueue->uiNextHead)
+    {
+        pstQueue->uiMoved = pstQueue->uiNextHead;
+        pstQueue->ppvMove = pstQueue->ppvHead;
+    }
+
+    for (uiCount = 0; pstQueue->uiMoved < pstQueue->uiNextHead + uiNum; uiCount++)
+    {
+        if (0 != uiSteps && uiCount >= uiSteps)
+        {
+            return;
+        }
+        assert(pstQueue->uiMoved < pstQueue->uiNextSize);
+        pstQueue->ppvNext[pstQueue->uiMoved] = *pstQueue->ppvMove;
+        pstQueue->uiMoved++;
+        pstQueue->ppvMove++;
+        if (pstQueue->ppvMove - pstQueue->ppvQueue >= pstQueue->uiSize)
+        {
+            pstQueue->ppvMove = pstQueue->ppvQueue;
+        }
+    }
+
+    free(pstQueue->ppvQueue);
+    pstQueue->ppvQueue = pstQueue->ppvNext;
+    pstQueue->ppvHead = pstQueue->ppvNext + pstQueue->uiNextHead;
+    pstQueue->ppvTail = pstQueue->ppvNext + pstQueue->uiMoved;
+    pstQueue->uiSize = pstQueue->uiNextSize;
+    if (pstQueue->ppvHead - pstQueue->ppvQueue >= pstQueue->uiSize)
+    {
+        pstQueue->ppvHead = pstQueue->ppvQueue;
+    }
+    if (pstQueue->ppvTail - pstQueue->ppvQueue >= pstQueue->uiSize)
+    {
+        pstQueue->ppvTail = pstQueue->ppvQueue;
+    }
+
+    pstQueue->ppvNext = NULL;
+    pstQueue->ppvMove = NULL;
+    pstQueue->uiNextSize = 0;
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  queue_adjust
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Grow or shrink a QueueSetGrow queue step by step, called before
+                an item is added and after an item is removed
+        Input:  IN Queue_S *pstQueue
+       Output:  OUT Queue_S *pstQueue
+       Return:  NONE
+      Caution:  pstQueue should not be NULL. A queue starts growing when it is
+                3/4 full, and moves QUEUE_MOVESTEP items each time, so it has
+                switched to the double memery before it is full
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static VOID queue_adjust(INOUT Queue_S *pstQueue)
+{
+    UINT uiNum = 0;
+    UINT uiCap = 0;
+    UINT uiNextCap = 0;
+
+    assert(NULL != pstQueue);
+
+    if (BOOL_TRUE != pstQueue->bGrow)
+    {
+        return;
+    }
+
+    if (NULL == pstQueue->ppvNext)
+    {
+        uiNum = QueueNumber(pstQueue);
+        uiCap = pstQueue->uiSize - 1;
+        if (uiNum >= uiCap - uiCap / 4 && uiCap <= QUEUE_SIZEMAX / 2)
+        {
+            uiNextCap = uiCap * 2;
+        }
+        else if (0 != pstQueue->uiShrink &&
+                 uiNum < uiCap / pstQueue->uiShrink &&
+                 uiCap / 2 >= pstQueue->uiMinSize)
+        {
+            uiNextCap = uiCap / 2;
+        }
+        else
+        {
+            return;
+        }
+
+        /**the next memery is filled a few a time, no need to initialize**/
+        pstQueue->ppvNext = (VOID **)malloc(sizeof(VOID *) * (uiNextCap + 1));
+        if (NULL == pstQueue->ppvNext)
+        {
+            return;
+        }
+        pstQueue->uiNextSize = uiNextCap + 1;
+        pstQueue->ppvMove = pstQueue->ppvHead;
+        pstQueue->uiMoved = 0;
+        pstQueue->uiNextHead = 0;
+    }
+
+    queue_move(pstQueue, QUEUE_MOVESTEP);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  queue_room
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Make room for an item to be added
+        Input:  IN Queue_S *pstQueue
+       Output:  OUT Queue_S *pstQueue
+       Return:  BOOL_T
+                BOOL_TRUE, there's room for an item
+                BOOL_FALSE, the queue is full
+      Caution:  pstQueue should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static inline BOOL_T queue_room(INOUT Queue_S *pstQueue)
+{
+    assert(NULL != pstQueue);
+
+    queue_adjust(pstQueue);
+
+    /**it hardly happens, unless the queue is too small to move step by step**/
+    if (BOOL_TRUE == queue_isfull(pstQueue) && NULL != pstQueue->ppvNext)
+    {
+        queue_move(pstQueue, 0);
+    }
+
+    if (BOOL_TRUE == queue_isfull(pstQueue))
+    {
+        return BOOL_FALSE;
+    }
+
+    return BOOL_TRUE;
+}
+
+/*******************************************************************************
+    Func Name:  queue_reserve
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Make room for some items to be added at once
+        Input:  IN Queue_S *pstQueue
+                IN UINT uiNum, how many items to be added
+       Output:  OUT Queue_S *pstQueue
+       Return:  NONE
+      Caution:  pstQueue should not be NULL. If the items fit, the moving to
+                the next memery goes on step by step, see queue_steps. Or
+                else the moving is finished, and a growing queue doubles at
+                once till the items fit in 3/4 of it, so the next add doesn't
+                start growing again. It may still have less room than uiNum
+                if it's not growing or there's no memery
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static VOID queue_reserve(INOUT Queue_S *pstQueue, IN UINT uiNum)
+{
+    UINT uiNeed = 0;
+    UINT uiLimit = 0;
+    UINT uiCap = 0;
+    UINT uiNextCap = 0;
+
+    assert(NULL != pstQueue);
+
+    queue_adjust(pstQueue);
+
+    uiNeed = QueueNumber(pstQueue);
+    uiNeed += (uiNum < QUEUE_SIZEMAX - uiNeed) ? uiNum : QUEUE_SIZEMAX - uiNeed;
+
+    /**while moving, the items must fit the next memery too, where they're
+       laid from the head without wrapping**/
+    uiLimit = pstQueue->uiSize - 1;
+    if (NULL != pstQueue->ppvNext &&
+        pstQueue->uiNextSize - 1 - pstQueue->uiNextHead < uiLimit)
+    {
+        uiLimit = pstQueue->uiNextSize - 1 - pstQueue->uiNextHead;
+    }
+    if (uiNeed <= uiLimit)
+    {
+        return;
+    }
+
+    if (NULL != pstQueue->ppvNext)
+    {
+        queue_move(pstQueue, 0);
+    }
+    if (BOOL_TRUE != pstQueue->bGrow)
+    {
+        return;
+    }
+
+    uiCap = pstQueue->uiSize - 1;
+    uiNextCap = uiCap;
+    while (uiNeed >= uiNextCap - uiNextCap / 4 &&
+           uiNextCap <= QUEUE_SIZEMAX / 2)
+    {
+        uiNextCap *= 2;
+    }
+    if (uiNextCap == uiCap)
+    {
+        return;
+    }
+
+    pstQueue->ppvNext = (VOID **)malloc(sizeof(VOID *) * (uiNextCap + 1));
+    if (NULL == pstQueue->ppvNext)
+    {
+        return;
+    }
+    pstQueue->uiNextSize = uiNextCap + 1;
+    pstQueue->ppvMove = pstQueue->ppvHead;
+    pstQueue->uiMoved = 0;
+    pstQueue->uiNextHead = 0;
+    queue_move(pstQueue, 0);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  queue_steps
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Move a growing or shrinking queue on after some items added
+        Input:  IN Queue_S *pstQueue
+                IN UINT uiNum, how many items added
+       Output:  OUT Queue_S *pstQueue
+       Return:  NONE
+      Caution:  pstQueue should not be NULL. It moves QUEUE_MOVESTEP items for
+                each item added, as that many QueueAdd would, so a batch costs
+                O(k) for moving
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static VOID queue_steps(INOUT Queue_S *pstQueue, IN UINT uiNum)
+{
+    assert(NULL != pstQueue);
+
+    queue_adjust(pstQueue);
+    if (NULL != pstQueue->ppvNext)
+    {
+        queue_move(pstQueue, (uiNum < QUEUE_SIZEMAX / QUEUE_MOVESTEP) ?
+                             uiNum * QUEUE_MOVESTEP : 0);
+    }
+
+    return;
+}
+
 /*******************************************************************************
     Func Name:  QueueCreate
  Date Created:  2014-9-19
@@ -143,6 +477,7 @@ Queue_S* QueueCreate(IN UINT uiSize, PF_PRINT pfPrint, IN PF_FREE pfFree)
     memset(ppvQueue, 0, sizeof(VOID *) * (uiSize + 1));
 
     pstQueue->uiSize = uiSize + 1;
+    pstQueue->uiMinSize = uiSize;
     pstQueue->ppvQueue = ppvQueue;
     pstQueue->ppvHead = ppvQueue;
     pstQueue->ppvTail = ppvQueue;
@@ -152,6 +487,111 @@ Queue_S* QueueCreate(IN UINT uiSize, PF_PRINT pfPrint, IN PF_FREE pfFree)
     return pstQueue;
 }
 
+/*******************************************************************************
+    Func Name:  QueueCreateValue
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a queue storing records by value
+        Input:  IN UINT uiSize, how many records the queue can store.
+                IN UINT uiElemSize, bytes of a record
+                IN PF_PRINT pfPrint, callback function to print record
+                IN PF_FREE pfFree, callback function to free what a record
+                                   refers to
+       Output:  NONE
+       Return:  Queue_S*,  the queue struct
+                NULL,     error occured
+      Caution:  QueueAdd copies uiElemSize bytes from the item into the slot at
+                the tail, so no memery is allocated for a record.
+                QueueGetFirst returns the slot, and QueueRemoveFirst the slot
+                it leaves, which keeps the record till the next add. The
+                callbacks get the slot, pfFree should not free it. The queue
+                never grows, QueueSetGrow fails on it, and so do QueueAddN and
+                QueueRemoveN
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+Queue_S* QueueCreateValue(IN UINT uiSize, IN UINT uiElemSize,
+                          IN PF_PRINT pfPrint, IN PF_FREE pfFree)
+{
+    Queue_S *pstQueue = NULL;
+
+    if (0 == uiSize || 0 == uiElemSize || uiSize > QUEUE_SIZEMAX)
+    {
+        return NULL;
+    }
+
+    pstQueue = (Queue_S *)malloc(sizeof(Queue_S));
+    if (NULL == pstQueue)
+    {
+        return NULL;
+    }
+    memset(pstQueue, 0, sizeof(Queue_S));
+
+    pstQueue->pcValue = (CHAR *)malloc((ULONG)uiSize * uiElemSize);
+    if (NULL == pstQueue->pcValue)
+    {
+        free(pstQueue);
+        return NULL;
+    }
+
+    pstQueue->uiSize = uiSize;
+    pstQueue->uiMinSize = uiSize;
+    pstQueue->uiElemSize = uiElemSize;
+    pstQueue->pfPrint = pfPrint;
+    pstQueue->pfFree = pfFree;
+
+    return pstQueue;
+}
+
+/*******************************************************************************
+    Func Name:  QueueSetGrow
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Make a queue grow automatically instead of being full
+        Input:  IN Queue_S *pstQueue
+                IN UINT uiShrink, shrink the queue to half if less than 
+                                  1/uiShrink of it is used, 0 for never
+       Output:  OUT Queue_S *pstQueue
+       Return:  ULONG
+                ERROR_SUCCESS, success
+                ERROR_FAILED, failed
+      Caution:  uiShrink should be 0 or not less than 4. The queue doubles when
+                it is 3/4 full, and never shrinks below the size it's created 
+                with. The items are copied to the new memery a few a time by
+                every add and remove, so no one of them stalls for copying the
+                whole queue. It fails on value queue
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+ULONG QueueSetGrow(INOUT Queue_S *pstQueue, IN UINT uiShrink)
+{
+    if (NULL == pstQueue)
+    {
+        return ERROR_FAILED;
+    }
+
+    if (0 != uiShrink && uiShrink < 4)
+    {
+        return ERROR_FAILED;
+    }
+
+    if (NULL != pstQueue->pcValue)
+    {
+        return ERROR_FAILED;
+    }
+
+    pstQueue->bGrow = BOOL_TRUE;
+    pstQueue->uiShrink = uiShrink;
+
+    return ERROR_SUCCESS;
+}
+
 /*******************************************************************************
     Func Name:  QueueFree
  Date Created:  2014-9-19
@@ -178,6 +618,18 @@ VOID QueueFree(IN Queue_S *pstQueue)
       return;
     }
 
+    if (NULL != pstQueue->pcValue)
+    {
+        while (NULL != pstQueue->pfFree && 0 != pstQueue->uiValues)
+        {
+            pstQueue->uiValues--;
+            pstQueue->pfFree(queue_value(pstQueue, pstQueue->uiValues));
+        }
+        free(pstQueue->pcValue);
+        free(pstQueue);
+        return;
+    }
+
     if (NULL == pstQueue->ppvQueue)
     {
         free(pstQueue);
@@ -200,6 +652,7 @@ VOID QueueFree(IN Queue_S *pstQueue)
 
     free(pstQueue->ppvQueue);
     pstQueue->ppvQueue = NULL;
+    free(pstQueue->ppvNext);
 
     free(pstQueue);
 
@@ -231,11 +684,19 @@ ULONG QueueAdd(IN Queue_S *pstQueue, IN VOID *pvItem)
         return ERROR_FAILED;
     }
 
-    if (BOOL_TRUE == queue_isfull(pstQueue))
+    if (BOOL_TRUE != queue_room(pstQueue))
     {
         return ERROR_FAILED;
     }
 
+    if (NULL != pstQueue->pcValue)
+    {
+        memcpy(queue_value(pstQueue, pstQueue->uiValues), pvItem,
+               pstQueue->uiElemSize);
+        pstQueue->uiValues++;
+        return ERROR_SUCCESS;
+    }
+
     *pstQueue->ppvTail = pvItem;
     pstQueue->ppvTail++;
     if (pstQueue->ppvTail - pstQueue->ppvQueue >= pstQueue->uiSize)
@@ -246,6 +707,71 @@ ULONG QueueAdd(IN Queue_S *pstQueue, IN VOID *pvItem)
     return ERROR_SUCCESS;
 }
 
+/*******************************************************************************
+    Func Name:  QueueAddN
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add some items into queue at once
+        Input:  IN Queue_S *pstQueue
+                IN VOID **ppvItems, items to be added, the first one first
+                IN UINT uiNum, how many items in ppvItems
+       Output:  OUT Queue_S *pstQueue
+       Return:  UINT, how many items added, less than uiNum if the
+                      queue is full
+      Caution:  Items in ppvItems should not be NULL, they're not checked one by
+                one. The room is checked once and the items are copied by two
+                memcpy at most, one to the end of memery and one from its
+                start. A growing queue moves on as many steps as adding the
+                items one by one would. Only if they can't fit, it finishes
+                moving and doubles at once till they fit in 3/4 of it. It
+                fails on value queue
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT QueueAddN(INOUT Queue_S *pstQueue, IN VOID **ppvItems, IN UINT uiNum)
+{
+    UINT uiTail = 0;
+    UINT uiRoom = 0;
+    UINT uiFirst = 0;
+
+    if (NULL == pstQueue || NULL == ppvItems || NULL != pstQueue->pcValue)
+    {
+        return 0;
+    }
+
+    queue_reserve(pstQueue, uiNum);
+
+    uiRoom = pstQueue->uiSize - 1 - QueueNumber(pstQueue);
+    if (uiNum > uiRoom)
+    {
+        uiNum = uiRoom;
+    }
+
+    /**the items wrap to the start of memery if they pass its end**/
+    uiTail = pstQueue->ppvTail - pstQueue->ppvQueue;
+    uiFirst = pstQueue->uiSize - uiTail;
+    if (uiFirst > uiNum)
+    {
+        uiFirst = uiNum;
+    }
+    memcpy(pstQueue->ppvTail, ppvItems, sizeof(VOID *) * uiFirst);
+    memcpy(pstQueue->ppvQueue, ppvItems + uiFirst,
+           sizeof(VOID *) * (uiNum - uiFirst));
+
+    uiTail += uiNum;
+    if (uiTail >= pstQueue->uiSize)
+    {
+        uiTail -= pstQueue->uiSize;
+    }
+    pstQueue->ppvTail = pstQueue->ppvQueue + uiTail;
+    queue_steps(pstQueue, uiNum);
+
+    return uiNum;
+}
+
 /*******************************************************************************
     Func Name:  QueueRemoveFirst
  Date Created:  2014-9-19
@@ -276,6 +802,18 @@ VOID* QueueRemoveFirst(IN Queue_S *pstQueue)
         return NULL;
     }
 
+    if (NULL != pstQueue->pcValue)
+    {
+        pvRet = queue_value(pstQueue, 0);
+        pstQueue->uiValueHead++;
+        if (pstQueue->uiValueHead >= pstQueue->uiSize)
+        {
+            pstQueue->uiValueHead = 0;
+        }
+        pstQueue->uiValues--;
+        return pvRet;
+    }
+
     pvRet = *pstQueue->ppvHead;
     *pstQueue->ppvHead = NULL;
     pstQueue->ppvHead++;
@@ -284,9 +822,78 @@ VOID* QueueRemoveFirst(IN Queue_S *pstQueue)
         pstQueue->ppvHead = pstQueue->ppvQueue;
     }   
 
+    if (NULL != pstQueue->ppvNext)
+    {
+        pstQueue->uiNextHead++;
+    }
+    queue_adjust(pstQueue);
+
     return pvRet;
 }
 
+/*******************************************************************************
+    Func Name:  QueueRemoveN
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Remove some first items in queue at once
+        Input:  IN Queue_S *pstQueue
+                IN UINT uiNum, how many items to remove at most
+       Output:  OUT Queue_S *pstQueue
+                OUT VOID **ppvItems, items removed, the first one first
+       Return:  UINT, how many items removed, less than uiNum if the
+                      queue runs out
+      Caution:  ppvItems should hold uiNum items. The items are copied by two
+                memcpy at most, the memery of items is left to users to free.
+                It fails on value queue
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT QueueRemoveN(INOUT Queue_S *pstQueue, IN UINT uiNum,
+                  OUT VOID **ppvItems)
+{
+    UINT uiHead = 0;
+    UINT uiFirst = 0;
+
+    if (NULL == pstQueue || NULL == ppvItems || NULL != pstQueue->pcValue)
+    {
+        return 0;
+    }
+
+    if (uiNum > QueueNumber(pstQueue))
+    {
+        uiNum = QueueNumber(pstQueue);
+    }
+
+    uiHead = pstQueue->ppvHead - pstQueue->ppvQueue;
+    uiFirst = pstQueue->uiSize - uiHead;
+    if (uiFirst > uiNum)
+    {
+        uiFirst = uiNum;
+    }
+    memcpy(ppvItems, pstQueue->ppvHead, sizeof(VOID *) * uiFirst);
+    memcpy(ppvItems + uiFirst, pstQueue->ppvQueue,
+           sizeof(VOID *) * (uiNum - uiFirst));
+
+    uiHead += uiNum;
+    if (uiHead >= pstQueue->uiSize)
+    {
+        uiHead -= pstQueue->uiSize;
+    }
+    pstQueue->ppvHead = pstQueue->ppvQueue + uiHead;
+
+    /**a moving queue needn't move the items removed**/
+    if (NULL != pstQueue->ppvNext)
+    {
+        pstQueue->uiNextHead += uiNum;
+    }
+    queue_adjust(pstQueue);
+
+    return uiNum;
+}
+
 /*******************************************************************************
     Func Name:  QueueGetFirst
  Date Created:  2014-9-19
@@ -316,6 +923,11 @@ VOID* QueueGetFirst(IN Queue_S *pstQueue)
         return NULL;
     }
 
+    if (NULL != pstQueue->pcValue)
+    {
+        return queue_value(pstQueue, 0);
+    }
+
     pvRet = *pstQueue->ppvHead;
 
     return pvRet;    
@@ -339,6 +951,7 @@ VOID* QueueGetFirst(IN Queue_S *pstQueue)
 VOID QueuePrint(IN Queue_S *pstQueue)
 {
     VOID **ppvCursor = NULL;
+    UINT uiCount = 0;
 
     if (NULL == pstQueue || NULL == pstQueue->pfPrint)
     {
@@ -349,6 +962,15 @@ VOID QueuePrint(IN Queue_S *pstQueue)
         return;
     }
 
+    if (NULL != pstQueue->pcValue)
+    {
+        for (uiCount = 0; uiCount < pstQueue->uiValues; uiCount++)
+        {
+            pstQueue->pfPrint(queue_value(pstQueue, uiCount));
+        }
+        return;
+    }
+
     ppvCursor = pstQueue->ppvHead;
     while (ppvCursor != pstQueue->ppvTail)
     {
@@ -387,6 +1009,11 @@ UINT QueueNumber(IN Queue_S *pstQueue)
         return 0;
     }
 
+    if (NULL != pstQueue->pcValue)
+    {
+        return pstQueue->uiValues;
+    }
+
     if (pstQueue->ppvHead < pstQueue->ppvTail)
     {
         uiRet = pstQueue->ppvTail - pstQueue->ppvHead;
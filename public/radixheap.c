@@ -0,0 +1,503 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   radixheap.c
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   A realization of monotone radix heap.
+      Others:
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+/**system headfiles**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+/**public headfiles**/
+#include "../include/type.h"
+#include "../include/err.h"
+#include "../include/radixheap.h"
+/**module headfiles**/
+
+/**no node**/
+#define RADIXHEAP_NIL  0xFFFFFFFF
+
+/*******************************************************************************
+    Func Name:  radixheap_bucket
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get the bucket of a key
+        Input:  IN UINT64 ullKey
+                IN UINT64 ullLast, the last removed key
+       Output:  NONE
+       Return:  UINT, 0 if the key equals the last one, else 1 + the highest
+                bit where they differ
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline UINT radixheap_bucket(IN UINT64 ullKey, IN UINT64 ullLast)
+{
+    UINT64 ullDiff = ullKey ^ ullLast;
+    UINT uiRet = 0;
+
+    if (0 == ullDiff)
+    {
+        return 0;
+    }
+
+#ifdef __GNUC__
+    uiRet = 64 - (UINT)__builtin_clzll(ullDiff);
+#else
+    while (0 != ullDiff)
+    {
+        ullDiff >>= 1;
+        uiRet++;
+    }
+#endif
+
+    return uiRet;
+}
+
+/*******************************************************************************
+    Func Name:  radixheap_first
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get the first bucket that is not empty but bucket 0
+        Input:  IN RadixHeap_S *pstHeap
+       Output:  NONE
+       Return:  UINT, the bucket
+      Caution:  pstHeap should not be NULL, and some bucket but bucket 0
+                should not be empty
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline UINT radixheap_first(IN RadixHeap_S *pstHeap)
+{
+    UINT64 ullUsed = 0;
+    UINT uiRet = 1;
+
+    assert(NULL != pstHeap && 0 != pstHeap->ullUsed);
+
+    ullUsed = pstHeap->ullUsed;
+#ifdef __GNUC__
+    uiRet += (UINT)__builtin_ctzll(ullUsed);
+#else
+    while (0 == (ullUsed & 1))
+    {
+        ullUsed >>= 1;
+        uiRet++;
+    }
+#endif
+
+    return uiRet;
+}
+
+/*******************************************************************************
+    Func Name:  radixheap_link
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Put a node into the bucket of its key
+        Input:  IN RadixHeap_S *pstHeap
+                IN UINT uiNode
+       Output:  OUT RadixHeap_S *pstHeap
+       Return:  NONE
+      Caution:  pstHeap should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline VOID radixheap_link(INOUT RadixHeap_S *pstHeap, IN UINT uiNode)
+{
+    UINT uiBucket = 0;
+
+    assert(NULL != pstHeap && uiNode < pstHeap->uiSize);
+
+    uiBucket = radixheap_bucket(pstHeap->pullKey[uiNode], pstHeap->ullLast);
+    pstHeap->puiNext[uiNode] = pstHeap->auiBucket[uiBucket];
+    pstHeap->auiBucket[uiBucket] = uiNode;
+    if (0 != uiBucket)
+    {
+        pstHeap->ullUsed |= (UINT64)1 << (uiBucket - 1);
+    }
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  radixheap_pull
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Fill bucket 0 if it is empty, by taking the least key of the
+                first bucket as the last key and redistributing that bucket
+        Input:  IN RadixHeap_S *pstHeap
+       Output:  OUT RadixHeap_S *pstHeap
+       Return:  NONE
+      Caution:  pstHeap should not be NULL or empty. Every node of the bucket
+                goes to a lower one, so a node is moved at most 64 times
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static VOID radixheap_pull(INOUT RadixHeap_S *pstHeap)
+{
+    UINT uiBucket = 0;
+    UINT uiNode = 0;
+    UINT uiNext = 0;
+    UINT64 ullMin = 0;
+
+    assert(NULL != pstHeap && 0 != pstHeap->uiNum);
+
+    if (RADIXHEAP_NIL != pstHeap->auiBucket[0])
+    {
+        return;
+    }
+
+    uiBucket = radixheap_first(pstHeap);
+    uiNode = pstHeap->auiBucket[uiBucket];
+    ullMin = pstHeap->pullKey[uiNode];
+    for (uiNode = pstHeap->puiNext[uiNode]; RADIXHEAP_NIL != uiNode;
+         uiNode = pstHeap->puiNext[uiNode])
+    {
+        if (pstHeap->pullKey[uiNode] < ullMin)
+        {
+            ullMin = pstHeap->pullKey[uiNode];
+        }
+    }
+
+    uiNode = pstHeap->auiBucket[uiBucket];
+    pstHeap->auiBucket[uiBucket] = RADIXHEAP_NIL;
+    pstHeap->ullUsed &= ~((UINT64)1 << (uiBucket - 1));
+    pstHeap->ullLast = ullMin;
+    while (RADIXHEAP_NIL != uiNode)
+    {
+        uiNext = pstHeap->puiNext[uiNode];
+        radixheap_link(pstHeap, uiNode);
+        uiNode = uiNext;
+    }
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  RadixHeapCreate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a monotone radix heap
+        Input:  IN UINT uiSize, how many items the heap can store.
+                IN PF_PRINT pfPrint, callback function to print item
+                IN PF_FREE pfFree, callback function to free item
+       Output:  NONE
+       Return:  RadixHeap_S*,  the heap struct
+                NULL,          error occured
+      Caution:  pfPrint can be NULL
+                pfFree can be NULL if you don't want your data to be freed when
+                deleting the heap
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+RadixHeap_S* RadixHeapCreate(IN UINT uiSize,
+                             IN PF_PRINT pfPrint,
+                             IN PF_FREE pfFree)
+{
+    RadixHeap_S *pstHeap = NULL;
+    UINT uiCount = 0;
+
+    if (0 == uiSize || uiSize >= RADIXHEAP_NIL)
+    {
+        return NULL;
+    }
+
+    pstHeap = (RadixHeap_S *)malloc(sizeof(RadixHeap_S));
+    if (NULL == pstHeap)
+    {
+        return NULL;
+    }
+    memset(pstHeap, 0, sizeof(RadixHeap_S));
+
+    pstHeap->pullKey = (UINT64 *)malloc(sizeof(UINT64) * uiSize);
+    pstHeap->ppvItem = (VOID **)malloc(sizeof(VOID *) * uiSize);
+    pstHeap->puiNext = (UINT *)malloc(sizeof(UINT) * uiSize);
+    if (NULL == pstHeap->pullKey || NULL == pstHeap->ppvItem ||
+        NULL == pstHeap->puiNext)
+    {
+        RadixHeapFree(pstHeap);
+        return NULL;
+    }
+
+    /**all nodes are free at first**/
+    for (uiCount = 0; uiCount < uiSize; uiCount++)
+    {
+        pstHeap->puiNext[uiCount] = uiCount + 1;
+    }
+    pstHeap->puiNext[uiSize - 1] = RADIXHEAP_NIL;
+    for (uiCount = 0; uiCount < RADIXHEAP_BUCKETS; uiCount++)
+    {
+        pstHeap->auiBucket[uiCount] = RADIXHEAP_NIL;
+    }
+
+    pstHeap->uiSize = uiSize;
+    pstHeap->uiFree = 0;
+    pstHeap->pfPrint = pfPrint;
+    pstHeap->pfFree = pfFree;
+
+    return pstHeap;
+}
+
+/*******************************************************************************
+    Func Name:  RadixHeapFree
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To free a given heap
+        Input:  IN RadixHeap_S *pstHeap, the heap to be freed
+       Output:  NONE
+       Return:  NONE
+      Caution:  If you have installed PF_FREE callback function, then all the
+                itmes in the heap will be freed, otherwise it's the user's
+                responsibility to free the memeries of all items
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID RadixHeapFree(IN RadixHeap_S *pstHeap)
+{
+    UINT uiBucket = 0;
+    UINT uiNode = 0;
+
+    if (NULL == pstHeap)
+    {
+        return;
+    }
+
+    if (NULL != pstHeap->pfFree && 0 != pstHeap->uiNum)
+    {
+        for (uiBucket = 0; uiBucket < RADIXHEAP_BUCKETS; uiBucket++)
+        {
+            uiNode = pstHeap->auiBucket[uiBucket];
+            while (RADIXHEAP_NIL != uiNode)
+            {
+                pstHeap->pfFree(pstHeap->ppvItem[uiNode]);
+                uiNode = pstHeap->puiNext[uiNode];
+            }
+        }
+    }
+
+    free(pstHeap->pullKey);
+    free(pstHeap->ppvItem);
+    free(pstHeap->puiNext);
+    free(pstHeap);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  RadixHeapAdd
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add an item with its key to heap
+        Input:  IN RadixHeap_S *pstHeap
+                IN UINT64 ullKey, key of the item
+                IN VOID *pvItem, item to be added
+       Output:  OUT RadixHeap_S *pstHeap
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed
+      Caution:  pvItem should not be NULL, and ullKey should not be less than
+                the last removed key. Costs O(1)
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG RadixHeapAdd(INOUT RadixHeap_S *pstHeap, IN UINT64 ullKey,
+                   IN VOID *pvItem)
+{
+    UINT uiNode = 0;
+
+    if (NULL == pstHeap || NULL == pvItem)
+    {
+        return ERROR_FAILED;
+    }
+
+    if (ullKey < pstHeap->ullLast || RADIXHEAP_NIL == pstHeap->uiFree)
+    {
+        return ERROR_FAILED;
+    }
+
+    uiNode = pstHeap->uiFree;
+    pstHeap->uiFree = pstHeap->puiNext[uiNode];
+    pstHeap->pullKey[uiNode] = ullKey;
+    pstHeap->ppvItem[uiNode] = pvItem;
+    radixheap_link(pstHeap, uiNode);
+    pstHeap->uiNum++;
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  RadixHeapGetRoot
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  look for the item of the minimal key in heap
+        Input:  IN RadixHeap_S *pstHeap
+       Output:  OUT UINT64 *pullKey, key of the item
+       Return:  VOID*, the item
+                NULL, the heap is empty
+      Caution:  pullKey can be NULL if the key is not wanted. The buckets may
+                be redistributed, and the key becomes the last removed one, so
+                no less key can be added after it
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* RadixHeapGetRoot(INOUT RadixHeap_S *pstHeap, OUT UINT64 *pullKey)
+{
+    UINT uiNode = 0;
+
+    if (NULL == pstHeap || 0 == pstHeap->uiNum)
+    {
+        return NULL;
+    }
+
+    radixheap_pull(pstHeap);
+    uiNode = pstHeap->auiBucket[0];
+    if (NULL != pullKey)
+    {
+        *pullKey = pstHeap->pullKey[uiNode];
+    }
+
+    return pstHeap->ppvItem[uiNode];
+}
+
+/*******************************************************************************
+    Func Name:  RadixHeapRemoveRoot
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  remove the item of the minimal key from heap
+        Input:  IN RadixHeap_S *pstHeap
+       Output:  OUT UINT64 *pullKey, key of the item
+       Return:  VOID*, the item removed out
+                NULL, failed, the heap is empty
+      Caution:  pullKey can be NULL if the key is not wanted. Amortized costs
+                O(log C), C is the max difference between keys. The function
+                only removes items from heap, but the memery is left to users
+                to free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* RadixHeapRemoveRoot(INOUT RadixHeap_S *pstHeap, OUT UINT64 *pullKey)
+{
+    VOID *pvRet = NULL;
+    UINT uiNode = 0;
+
+    if (NULL == pstHeap || 0 == pstHeap->uiNum)
+    {
+        return NULL;
+    }
+
+    radixheap_pull(pstHeap);
+    uiNode = pstHeap->auiBucket[0];
+    pstHeap->auiBucket[0] = pstHeap->puiNext[uiNode];
+    if (NULL != pullKey)
+    {
+        *pullKey = pstHeap->pullKey[uiNode];
+    }
+    pvRet = pstHeap->ppvItem[uiNode];
+
+    pstHeap->ppvItem[uiNode] = NULL;
+    pstHeap->puiNext[uiNode] = pstHeap->uiFree;
+    pstHeap->uiFree = uiNode;
+    pstHeap->uiNum--;
+
+    return pvRet;
+}
+
+/*******************************************************************************
+    Func Name:  RadixHeapPrint
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  print all items in heap
+        Input:  IN RadixHeap_S *pstHeap
+       Output:  NONE
+       Return:  NONE
+      Caution:  bucket by bucket, the items of a bucket have keys less than
+                those of the buckets after it, but are not sorted in it
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID RadixHeapPrint(IN RadixHeap_S *pstHeap)
+{
+    UINT uiBucket = 0;
+    UINT uiNode = 0;
+
+    if (NULL == pstHeap || NULL == pstHeap->pfPrint)
+    {
+        return;
+    }
+
+    for (uiBucket = 0; uiBucket < RADIXHEAP_BUCKETS; uiBucket++)
+    {
+        uiNode = pstHeap->auiBucket[uiBucket];
+        while (RADIXHEAP_NIL != uiNode)
+        {
+            pstHeap->pfPrint(pstHeap->ppvItem[uiNode]);
+            uiNode = pstHeap->puiNext[uiNode];
+        }
+    }
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  RadixHeapNumber
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many items in heap
+        Input:  IN RadixHeap_S *pstHeap
+       Output:  NONE
+       Return:  UINT
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT RadixHeapNumber(IN RadixHeap_S *pstHeap)
+{
+    if (NULL == pstHeap)
+    {
+        return 0;
+    }
+
+    return pstHeap->uiNum;
+}
@@ -25,6 +25,35 @@ Copyright(C):   Huazhong University of Science & Technology.
 #include "../include/stack.h"
 /**module headfiles**/
 
+/**items moved to the next memery each time a growing stack is changed**/
+#define STACK_MOVESTEP  4
+
+/**the largest stack**/
+#define STACK_SIZEMAX   0x7FFFFFFF
+
+/*******************************************************************************
+    Func Name:  stack_value
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get the slot of a record in value stack
+        Input:  IN Stack_S *pstStack
+                IN UINT uiPlace, place of the record from the bottom
+       Output:  NONE
+       Return:  VOID*, the slot
+      Caution:  pstStack should not be NULL, and should be a value stack
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline VOID* stack_value(IN Stack_S *pstStack, IN UINT uiPlace)
+{
+    assert(NULL != pstStack && NULL != pstStack->pcValue);
+
+    return pstStack->pcValue + (ULONG)uiPlace * pstStack->uiElemSize;
+}
+
 /*******************************************************************************
     Func Name:  stack_isfull
  Date Created:  2014-9-18
@@ -48,7 +77,14 @@ static inline BOOL_T stack_isfull(IN Stack_S *pstStack)
 
     assert(NULL != pstStack);
 
-    if (pstStack->ppvTop - pstStack->ppvStack >= pstStack->uiSize)
+    if (NULL != pstStack->pcValue)
+    {
+        if (pstStack->uiValues >= pstStack->uiSize)
+        {
+            bRet = BOOL_TRUE;
+        }
+    }
+    else if (pstStack->ppvTop - pstStack->ppvStack >= pstStack->uiSize)
     {
         bRet = BOOL_TRUE;
     }
@@ -79,7 +115,8 @@ static inline BOOL_T stack_isempty(IN Stack_S *pstStack)
 
     assert(NULL != pstStack);
 
-    if (pstStack->ppvTop == pstStack->ppvStack)
+    if (pstStack->ppvTop == pstStack->ppvStack && 0 == pstStack->uiBelow &&
+        0 == pstStack->uiValues)
     {
         bRet = BOOL_TRUE;
     }
@@ -87,6 +124,362 @@ static inline BOOL_T stack_isempty(IN Stack_S *pstStack)
     return bRet;
 }
 
+/*******************************************************************************
+    Func Name:  stack_move
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Move some items of the stack to the next memery, and switch to
+                the next memery if all items are moved
+        Input:  IN Stack_S *pstStack
+                IN UINT uiSteps, how many items to move at most, 0 for all
+       Output:  OUT Stack_S *pstStack
+       Return:  NONE
+      Caution:  pstStack should not be NULL, the stack should be moving
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static VOID stack_move(INOUT Stack_S *pstStack, IN UINT uiSteps)
+{
+    UINT uiNum = 0;
+    UINT uiCount = 0;
+
+    assert(NULL != pstStack && NULL != pstStack->ppvNext);
+
+    uiNum = pstStack->ppvTop - pstStack->ppvStack;
+    assert(uiNum <= pstStack->uiNextSize);
+
+    /**items pushed above the moved ones haven't been moved**/
+    if (pstStack->uiMoved > uiNum)
+    {
+        pstStack->uiMoved = uiNum;
+    }
+
+    for (uiCount = 0; pstStack->uiMoved < uiNum; uiCount++)
+    {
+        if (0 != uiSteps && uiCount >= uiSteps)
+        {
+            return;
+        }
+        pstStack->ppvNext[pstStack->uiMoved] = pstStack->ppvStack[pstStack->uiMoved];
+        pstStack->uiMoved++;
+    }
+
+    free(pstStack->ppvStack);
+    pstStack->ppvStack = pstStack->ppvNext;
+    pstStack->ppvTop = pstStack->ppvNext + uiNum;
+    pstStack->uiSize = pstStack->uiNextSize;
+    pstStack->ppvNext = NULL;
+    pstStack->uiNextSize = 0;
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  stack_adjust
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Grow or shrink a StackSetGrow stack step by step, called before
+                an item is pushed and after an item is poped
+        Input:  IN Stack_S *pstStack
+       Output:  OUT Stack_S *pstStack
+       Return:  NONE
+      Caution:  pstStack should not be NULL. A stack starts growing when it is
+                3/4 full, and moves STACK_MOVESTEP items each time, so it has
+                switched to the double memery before it is full
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static VOID stack_adjust(INOUT Stack_S *pstStack)
+{
+    UINT uiNum = 0;
+    UINT uiNextSize = 0;
+
+    assert(NULL != pstStack);
+
+    if (BOOL_TRUE != pstStack->bGrow)
+    {
+        return;
+    }
+
+    uiNum = pstStack->ppvTop - pstStack->ppvStack;
+    if (NULL == pstStack->ppvNext)
+    {
+        if (uiNum >= pstStack->uiSize - pstStack->uiSize / 4 &&
+            pstStack->uiSize <= STACK_SIZEMAX / 2)
+        {
+            uiNextSize = pstStack->uiSize * 2;
+        }
+        else if (0 != pstStack->uiShrink &&
+                 uiNum < pstStack->uiSize / pstStack->uiShrink &&
+                 pstStack->uiSize / 2 >= pstStack->uiMinSize)
+        {
+            uiNextSize = pstStack->uiSize / 2;
+        }
+        else
+        {
+            return;
+        }
+
+        /**the next memery is filled a few a time, no need to initialize**/
+        pstStack->ppvNext = (VOID **)malloc(sizeof(VOID *) * uiNextSize);
+        if (NULL == pstStack->ppvNext)
+        {
+            return;
+        }
+        pstStack->uiNextSize = uiNextSize;
+        pstStack->uiMoved = 0;
+    }
+
+    stack_move(pstStack, STACK_MOVESTEP);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  stack_up
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Put an empty chunk on the full top chunk of chunked stack
+        Input:  IN Stack_S *pstStack
+       Output:  OUT Stack_S *pstStack
+       Return:  BOOL_T
+                BOOL_TRUE, there's room for an item
+                BOOL_FALSE, no memery or too many items
+      Caution:  pstStack should not be NULL, the spare chunk is taken first
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static BOOL_T stack_up(INOUT Stack_S *pstStack)
+{
+    StackChunk_S *pstChunk = NULL;
+
+    assert(NULL != pstStack && NULL != pstStack->pstChunk);
+
+    if (pstStack->uiBelow > STACK_SIZEMAX - 2 * pstStack->uiSize)
+    {
+        return BOOL_FALSE;
+    }
+
+    pstChunk = pstStack->pstSpare;
+    pstStack->pstSpare = NULL;
+    if (NULL == pstChunk)
+    {
+        pstChunk = (StackChunk_S *)malloc(sizeof(StackChunk_S) +
+                                          sizeof(VOID *) * pstStack->uiSize);
+        if (NULL == pstChunk)
+        {
+            return BOOL_FALSE;
+        }
+    }
+
+    pstChunk->pstBelow = pstStack->pstChunk;
+    pstStack->pstChunk = pstChunk;
+    pstStack->uiBelow += pstStack->uiSize;
+    pstStack->ppvStack = pstChunk->apvItem;
+    pstStack->ppvTop = pstChunk->apvItem;
+
+    return BOOL_TRUE;
+}
+
+/*******************************************************************************
+    Func Name:  stack_down
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Drop the empty top chunk of chunked stack to the spare one
+        Input:  IN Stack_S *pstStack
+       Output:  OUT Stack_S *pstStack
+       Return:  NONE
+      Caution:  pstStack should not be NULL, there should be a chunk below.
+                The old spare chunk is freed, so one is kept at most
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static VOID stack_down(INOUT Stack_S *pstStack)
+{
+    StackChunk_S *pstChunk = NULL;
+
+    assert(NULL != pstStack && NULL != pstStack->pstChunk);
+    assert(NULL != pstStack->pstChunk->pstBelow);
+
+    pstChunk = pstStack->pstChunk;
+    free(pstStack->pstSpare);
+    pstStack->pstSpare = pstChunk;
+    pstStack->pstChunk = pstChunk->pstBelow;
+    pstStack->uiBelow -= pstStack->uiSize;
+    pstStack->ppvStack = pstStack->pstChunk->apvItem;
+    pstStack->ppvTop = pstStack->ppvStack + pstStack->uiSize;
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  stack_room
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Make room for an item to be pushed
+        Input:  IN Stack_S *pstStack
+       Output:  OUT Stack_S *pstStack
+       Return:  BOOL_T
+                BOOL_TRUE, there's room for an item
+                BOOL_FALSE, the stack is full
+      Caution:  pstStack should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+static inline BOOL_T stack_room(INOUT Stack_S *pstStack)
+{
+    assert(NULL != pstStack);
+
+    if (NULL != pstStack->pstChunk)
+    {
+        if (BOOL_TRUE == stack_isfull(pstStack))
+        {
+            return stack_up(pstStack);
+        }
+        return BOOL_TRUE;
+    }
+
+    stack_adjust(pstStack);
+
+    /**it hardly happens, unless the stack is too small to move step by step**/
+    if (BOOL_TRUE == stack_isfull(pstStack) && NULL != pstStack->ppvNext)
+    {
+        stack_move(pstStack, 0);
+    }
+
+    if (BOOL_TRUE == stack_isfull(pstStack))
+    {
+        return BOOL_FALSE;
+    }
+
+    return BOOL_TRUE;
+}
+
+/*******************************************************************************
+    Func Name:  stack_reserve
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Make room for some items to be pushed at once
+        Input:  IN Stack_S *pstStack
+                IN UINT uiNum, how many items to be pushed
+       Output:  OUT Stack_S *pstStack
+       Return:  NONE
+      Caution:  pstStack should not be NULL, and not be chunked. If the items
+                fit, the moving to the next memery goes on step by step, see
+                stack_steps. Or else the moving is finished, and a growing
+                stack doubles at once till the items fit in 3/4 of it, so the
+                next push doesn't start growing again. It may still have less
+                room than uiNum if it's not growing or there's no memery
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static VOID stack_reserve(INOUT Stack_S *pstStack, IN UINT uiNum)
+{
+    UINT uiNeed = 0;
+    UINT uiLimit = 0;
+    UINT uiNextSize = 0;
+
+    assert(NULL != pstStack && NULL == pstStack->pstChunk);
+
+    stack_adjust(pstStack);
+
+    uiNeed = pstStack->ppvTop - pstStack->ppvStack;
+    uiNeed += (uiNum < STACK_SIZEMAX - uiNeed) ? uiNum : STACK_SIZEMAX - uiNeed;
+
+    /**the items must fit both memeries while moving, the next one is smaller
+       if the stack is shrinking**/
+    uiLimit = pstStack->uiSize;
+    if (NULL != pstStack->ppvNext && pstStack->uiNextSize < uiLimit)
+    {
+        uiLimit = pstStack->uiNextSize;
+    }
+    if (uiNeed <= uiLimit)
+    {
+        return;
+    }
+
+    if (NULL != pstStack->ppvNext)
+    {
+        stack_move(pstStack, 0);
+    }
+    if (BOOL_TRUE != pstStack->bGrow)
+    {
+        return;
+    }
+
+    uiNextSize = pstStack->uiSize;
+    while (uiNeed >= uiNextSize - uiNextSize / 4 &&
+           uiNextSize <= STACK_SIZEMAX / 2)
+    {
+        uiNextSize *= 2;
+    }
+    if (uiNextSize == pstStack->uiSize)
+    {
+        return;
+    }
+
+    pstStack->ppvNext = (VOID **)malloc(sizeof(VOID *) * uiNextSize);
+    if (NULL == pstStack->ppvNext)
+    {
+        return;
+    }
+    pstStack->uiNextSize = uiNextSize;
+    pstStack->uiMoved = 0;
+    stack_move(pstStack, 0);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  stack_steps
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Move a growing or shrinking stack on after some items pushed
+        Input:  IN Stack_S *pstStack
+                IN UINT uiNum, how many items pushed
+       Output:  OUT Stack_S *pstStack
+       Return:  NONE
+      Caution:  pstStack should not be NULL, and not be chunked. It moves
+                STACK_MOVESTEP items for each item pushed, as that many
+                StackPush would, so a batch costs O(k) for moving
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static VOID stack_steps(INOUT Stack_S *pstStack, IN UINT uiNum)
+{
+    assert(NULL != pstStack && NULL == pstStack->pstChunk);
+
+    stack_adjust(pstStack);
+    if (NULL != pstStack->ppvNext)
+    {
+        stack_move(pstStack, (uiNum < STACK_SIZEMAX / STACK_MOVESTEP) ?
+                             uiNum * STACK_MOVESTEP : 0);
+    }
+
+    return;
+}
+
 /*******************************************************************************
     Func Name:  StackCreate
  Date Created:  2014-9-18
@@ -133,6 +526,7 @@ Stack_S* StackCreate(IN UINT uiSize, PF_PRINT pfPrint, PF_FREE pfFree)
     memset(ppvStack, 0, sizeof(VOID *) * uiSize);
 
     pstStack->uiSize = uiSize;
+    pstStack->uiMinSize = uiSize;
     pstStack->ppvStack = ppvStack;
     pstStack->ppvTop = ppvStack;
     pstStack->pfPrint = pfPrint;
@@ -141,6 +535,170 @@ Stack_S* StackCreate(IN UINT uiSize, PF_PRINT pfPrint, PF_FREE pfFree)
     return pstStack;
 }
 
+/*******************************************************************************
+    Func Name:  StackCreateChunked
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a stack on a chain of chunks without a size limit
+        Input:  IN UINT uiChunkSize, how many items a chunk can store.
+                IN PF_PRINT pfPrint, callback function to print item
+                PF_FREE pfFree, callback function to free the memery of item
+       Output:  NONE  
+       Return:  Stack_S*,  the stack struct
+                NULL,     error occured
+      Caution:  A push onto a full chunk links a new one, and a pop leaves an
+                empty chunk to the spare one, so push and pop touch the top
+                chunk only and the items are never copied. One spare chunk is
+                kept, a push and pop at the edge of a chunk don't call malloc
+                and free each time. StackSetGrow fails on it
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+Stack_S* StackCreateChunked(IN UINT uiChunkSize, PF_PRINT pfPrint,
+                            PF_FREE pfFree)
+{
+    Stack_S *pstStack = NULL;
+    StackChunk_S *pstChunk = NULL;
+
+    if (0 == uiChunkSize || uiChunkSize > STACK_SIZEMAX / 2)
+    {
+        return NULL;
+    }
+
+    pstStack = (Stack_S *)malloc(sizeof(Stack_S));
+    if (NULL == pstStack)
+    {
+        return NULL;
+    }
+    memset(pstStack, 0, sizeof(Stack_S));
+
+    pstChunk = (StackChunk_S *)malloc(sizeof(StackChunk_S) +
+                                      sizeof(VOID *) * uiChunkSize);
+    if (NULL == pstChunk)
+    {
+        free(pstStack);
+        return NULL;
+    }
+    pstChunk->pstBelow = NULL;
+
+    pstStack->uiSize = uiChunkSize;
+    pstStack->uiMinSize = uiChunkSize;
+    pstStack->pstChunk = pstChunk;
+    pstStack->ppvStack = pstChunk->apvItem;
+    pstStack->ppvTop = pstChunk->apvItem;
+    pstStack->pfPrint = pfPrint;
+    pstStack->pfFree = pfFree;
+
+    return pstStack;
+}
+
+/*******************************************************************************
+    Func Name:  StackCreateValue
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a stack storing records by value
+        Input:  IN UINT uiSize, how many records the stack can store.
+                IN UINT uiElemSize, bytes of a record
+                IN PF_PRINT pfPrint, callback function to print record
+                PF_FREE pfFree, callback function to free what a record
+                                refers to
+       Output:  NONE
+       Return:  Stack_S*,  the stack struct
+                NULL,     error occured
+      Caution:  StackPush copies uiElemSize bytes from the item into the slot on
+                the top, so no memery is allocated for a record. StackPeek
+                returns the slot, and StackPop the slot it leaves, which keeps
+                the record till the next push. The callbacks get the slot,
+                pfFree should not free it. The stack never grows,
+                StackSetGrow fails on it, and so do StackPushN and StackPopN
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+Stack_S* StackCreateValue(IN UINT uiSize, IN UINT uiElemSize,
+                          PF_PRINT pfPrint, PF_FREE pfFree)
+{
+    Stack_S *pstStack = NULL;
+
+    if (0 == uiSize || 0 == uiElemSize || uiSize > STACK_SIZEMAX)
+    {
+        return NULL;
+    }
+
+    pstStack = (Stack_S *)malloc(sizeof(Stack_S));
+    if (NULL == pstStack)
+    {
+        return NULL;
+    }
+    memset(pstStack, 0, sizeof(Stack_S));
+
+    pstStack->pcValue = (CHAR *)malloc((ULONG)uiSize * uiElemSize);
+    if (NULL == pstStack->pcValue)
+    {
+        free(pstStack);
+        return NULL;
+    }
+
+    pstStack->uiSize = uiSize;
+    pstStack->uiMinSize = uiSize;
+    pstStack->uiElemSize = uiElemSize;
+    pstStack->pfPrint = pfPrint;
+    pstStack->pfFree = pfFree;
+
+    return pstStack;
+}
+
+/*******************************************************************************
+    Func Name:  StackSetGrow
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Make a stack grow automatically instead of being full
+        Input:  IN Stack_S *pstStack
+                IN UINT uiShrink, shrink the stack to half if less than 
+                                  1/uiShrink of it is used, 0 for never
+       Output:  OUT Stack_S *pstStack
+       Return:  ULONG
+                ERROR_SUCCESS, success
+                ERROR_FAILED, failed
+      Caution:  uiShrink should be 0 or not less than 4. The stack doubles when
+                it is 3/4 full, and never shrinks below the size it's created 
+                with. The items are copied to the new memery a few a time by
+                every push and pop, so no one of them stalls for copying the
+                whole stack. It fails on chunked stack and value stack
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD      
+*******************************************************************************/
+ULONG StackSetGrow(INOUT Stack_S *pstStack, IN UINT uiShrink)
+{
+    if (NULL == pstStack)
+    {
+        return ERROR_FAILED;
+    }
+
+    if (0 != uiShrink && uiShrink < 4)
+    {
+        return ERROR_FAILED;
+    }
+
+    if (NULL != pstStack->pstChunk || NULL != pstStack->pcValue)
+    {
+        return ERROR_FAILED;
+    }
+
+    pstStack->bGrow = BOOL_TRUE;
+    pstStack->uiShrink = uiShrink;
+
+    return ERROR_SUCCESS;
+}
+
 /*******************************************************************************
     Func Name:  StackFree
  Date Created:  2014-9-18
@@ -161,12 +719,48 @@ Stack_S* StackCreate(IN UINT uiSize, PF_PRINT pfPrint, PF_FREE pfFree)
 VOID StackFree(IN Stack_S *pstStack)
 {
     VOID **ppvCursor = NULL;;
+    StackChunk_S *pstChunk = NULL;
 
     if (NULL == pstStack)
     {
       return;
     }
 
+    /**free the chunks from the top, the ones below are full**/
+    while (NULL != pstStack->pstChunk)
+    {
+        ppvCursor = pstStack->ppvTop - 1;
+        while (NULL != pstStack->pfFree && ppvCursor >= pstStack->ppvStack)
+        {
+            pstStack->pfFree(*ppvCursor);
+            ppvCursor--;
+        }
+
+        pstChunk = pstStack->pstChunk;
+        pstStack->pstChunk = pstChunk->pstBelow;
+        free(pstChunk);
+        if (NULL == pstStack->pstChunk)
+        {
+            free(pstStack->pstSpare);
+            free(pstStack);
+            return;
+        }
+        pstStack->ppvStack = pstStack->pstChunk->apvItem;
+        pstStack->ppvTop = pstStack->ppvStack + pstStack->uiSize;
+    }
+
+    if (NULL != pstStack->pcValue)
+    {
+        while (NULL != pstStack->pfFree && 0 != pstStack->uiValues)
+        {
+            pstStack->uiValues--;
+            pstStack->pfFree(stack_value(pstStack, pstStack->uiValues));
+        }
+        free(pstStack->pcValue);
+        free(pstStack);
+        return;
+    }
+
     if (NULL == pstStack->ppvStack)
     {
         free(pstStack);
@@ -186,6 +780,7 @@ VOID StackFree(IN Stack_S *pstStack)
     free(pstStack->ppvStack);
     pstStack->ppvStack = NULL;
 
+    free(pstStack->ppvNext);
     free(pstStack);
 
     return;
@@ -216,17 +811,90 @@ ULONG StackPush(IN Stack_S *pstStack, IN VOID *pvItem)
         return ERROR_FAILED;
     }
 
-    if (BOOL_TRUE == stack_isfull(pstStack))
+    if (BOOL_TRUE != stack_room(pstStack))
     {
         return ERROR_FAILED;
     }
 
+    if (NULL != pstStack->pcValue)
+    {
+        memcpy(stack_value(pstStack, pstStack->uiValues), pvItem,
+               pstStack->uiElemSize);
+        pstStack->uiValues++;
+        return ERROR_SUCCESS;
+    }
+
     *pstStack->ppvTop = pvItem;
     pstStack->ppvTop++;
 
     return ERROR_SUCCESS;
 }
 
+/*******************************************************************************
+    Func Name:  StackPushN
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Push some items into stack at once
+        Input:  IN Stack_S *pstStack
+                IN VOID **ppvItems, items to be pushed, the last one is on the
+                                    top at the end
+                IN UINT uiNum, how many items in ppvItems
+       Output:  OUT Stack_S *pstStack
+       Return:  UINT, how many items pushed, less than uiNum if the
+                      stack is full
+      Caution:  Items in ppvItems should not be NULL, they're not checked one by
+                one. The room is checked once and the items are copied by a
+                memcpy, or one for each chunk of chunked stack. A growing
+                stack moves on as many steps as pushing the items one by one
+                would. Only if they can't fit, it finishes moving and doubles
+                at once till they fit in 3/4 of it
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT StackPushN(INOUT Stack_S *pstStack, IN VOID **ppvItems, IN UINT uiNum)
+{
+    UINT uiCount = 0;
+    UINT uiRoom = 0;
+
+    if (NULL == pstStack || NULL == ppvItems || NULL != pstStack->pcValue)
+    {
+        return 0;
+    }
+
+    if (NULL == pstStack->pstChunk)
+    {
+        stack_reserve(pstStack, uiNum);
+    }
+
+    while (uiCount < uiNum)
+    {
+        if (BOOL_TRUE == stack_isfull(pstStack) &&
+            (NULL == pstStack->pstChunk || BOOL_TRUE != stack_up(pstStack)))
+        {
+            break;
+        }
+
+        uiRoom = pstStack->uiSize - (pstStack->ppvTop - pstStack->ppvStack);
+        if (uiRoom > uiNum - uiCount)
+        {
+            uiRoom = uiNum - uiCount;
+        }
+        memcpy(pstStack->ppvTop, ppvItems + uiCount, sizeof(VOID *) * uiRoom);
+        pstStack->ppvTop += uiRoom;
+        uiCount += uiRoom;
+    }
+
+    if (NULL == pstStack->pstChunk)
+    {
+        stack_steps(pstStack, uiCount);
+    }
+
+    return uiCount;
+}
+
 /*******************************************************************************
     Func Name:  StackPop
  Date Created:  2014-9-18
@@ -257,13 +925,84 @@ VOID* StackPop(IN Stack_S *pstStack)
         return NULL;
     }
 
+    if (NULL != pstStack->pcValue)
+    {
+        pstStack->uiValues--;
+        return stack_value(pstStack, pstStack->uiValues);
+    }
+
+    if (pstStack->ppvTop == pstStack->ppvStack)
+    {
+        stack_down(pstStack);
+    }
+
     pvItem = *(pstStack->ppvTop - 1);
     *(pstStack->ppvTop - 1) = NULL;
     pstStack->ppvTop--;
+    stack_adjust(pstStack);
 
     return pvItem;
 }
 
+/*******************************************************************************
+    Func Name:  StackPopN
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Pop some items out of stack at once
+        Input:  IN Stack_S *pstStack
+                IN UINT uiNum, how many items to pop at most
+       Output:  OUT Stack_S *pstStack
+                OUT VOID **ppvItems, items popped, in the order they were in
+                                     stack, the top one is the last
+       Return:  UINT, how many items popped, less than uiNum if the
+                      stack runs out
+      Caution:  ppvItems should hold uiNum items. The items are copied by a
+                memcpy, or one for each chunk of chunked stack. They keep the
+                order, so StackPushN of them puts them back as they were
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT StackPopN(INOUT Stack_S *pstStack, IN UINT uiNum, OUT VOID **ppvItems)
+{
+    UINT uiLeft = 0;
+    UINT uiHave = 0;
+
+    if (NULL == pstStack || NULL == ppvItems || NULL != pstStack->pcValue)
+    {
+        return 0;
+    }
+
+    if (uiNum > StackNumber(pstStack))
+    {
+        uiNum = StackNumber(pstStack);
+    }
+
+    /**ppvItems is filled from its end, chunk by chunk from the top**/
+    uiLeft = uiNum;
+    while (uiLeft > 0)
+    {
+        if (pstStack->ppvTop == pstStack->ppvStack)
+        {
+            stack_down(pstStack);
+        }
+
+        uiHave = pstStack->ppvTop - pstStack->ppvStack;
+        if (uiHave > uiLeft)
+        {
+            uiHave = uiLeft;
+        }
+        pstStack->ppvTop -= uiHave;
+        uiLeft -= uiHave;
+        memcpy(ppvItems + uiLeft, pstStack->ppvTop, sizeof(VOID *) * uiHave);
+    }
+    stack_adjust(pstStack);
+
+    return uiNum;
+}
+
 /*******************************************************************************
     Func Name:  StackPeek
  Date Created:  2014-9-18
@@ -293,6 +1032,17 @@ VOID* StackPeek(IN Stack_S *pstStack)
         return NULL;
     }
 
+    if (NULL != pstStack->pcValue)
+    {
+        return stack_value(pstStack, pstStack->uiValues - 1);
+    }
+
+    /**the top chunk is empty, the item is on the top of the one below**/
+    if (pstStack->ppvTop == pstStack->ppvStack)
+    {
+        return pstStack->pstChunk->pstBelow->apvItem[pstStack->uiSize - 1];
+    }
+
     pvItem = *(pstStack->ppvTop - 1);
 
     return pvItem;    
@@ -316,6 +1066,8 @@ VOID* StackPeek(IN Stack_S *pstStack)
 VOID StackPrint(IN Stack_S *pstStack)
 {
     VOID **ppvCursor = NULL;
+    StackChunk_S *pstChunk = NULL;
+    UINT uiCount = 0;
 
     if (NULL == pstStack || NULL == pstStack->pfPrint)
     {
@@ -326,6 +1078,15 @@ VOID StackPrint(IN Stack_S *pstStack)
         return;
     }    
 
+    if (NULL != pstStack->pcValue)
+    {
+        for (uiCount = pstStack->uiValues; uiCount > 0; uiCount--)
+        {
+            pstStack->pfPrint(stack_value(pstStack, uiCount - 1));
+        }
+        return;
+    }
+
     ppvCursor = pstStack->ppvTop - 1;
     while (ppvCursor >= pstStack->ppvStack)
     {
@@ -333,6 +1094,19 @@ VOID StackPrint(IN Stack_S *pstStack)
         ppvCursor--;
     }
 
+    /**the chunks below the top one are full**/
+    pstChunk = pstStack->pstChunk;
+    while (NULL != pstChunk && NULL != pstChunk->pstBelow)
+    {
+        pstChunk = pstChunk->pstBelow;
+        ppvCursor = pstChunk->apvItem + pstStack->uiSize - 1;
+        while (ppvCursor >= pstChunk->apvItem)
+        {
+            pstStack->pfPrint(*ppvCursor);
+            ppvCursor--;
+        }
+    }
+
     return;
 }
 
@@ -360,6 +1134,7 @@ UINT StackNumber(IN Stack_S *pstStack)
         return 0;
     }
 
-    uiRet = pstStack->ppvTop - pstStack->ppvStack;
+    uiRet = pstStack->ppvTop - pstStack->ppvStack + pstStack->uiBelow +
+            pstStack->uiValues;
     return uiRet;
 }
\ No newline at end of file
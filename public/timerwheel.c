@@ -0,0 +1,615 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   timerwheel.c
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   A realization of hierarchical timing wheel.
+      Others:   Timers are nodes of arrays linked in both ways, a handle is
+                the index of a node
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+/**system headfiles**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+/**public headfiles**/
+#include "../include/type.h"
+#include "../include/err.h"
+#include "../include/timerwheel.h"
+/**module headfiles**/
+
+/**no node**/
+#define TIMERWHEEL_NIL   0xFFFFFFFF
+
+/**mask of slot index in a wheel**/
+#define TIMERWHEEL_MASK  (TIMERWHEEL_SLOTS - 1)
+
+/*******************************************************************************
+    Func Name:  timerwheel_slot
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Get the slot of a timer by its expire tick
+        Input:  IN TimerWheel_S *pstWheel
+                IN UINT64 ullExpire, expire tick of the timer
+       Output:  NONE
+       Return:  UINT, index of the slot in auiSlot
+      Caution:  pstWheel should not be NULL, ullExpire should not be less than
+                the current tick. The wheel is the lowest one whose round
+                covers the delay, so the slot is reached before it expires. A
+                timer beyond all wheels is put in the last slot of the top
+                one, and put again when it's cascaded
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline UINT timerwheel_slot(IN TimerWheel_S *pstWheel,
+                                   IN UINT64 ullExpire)
+{
+    UINT64 ullDelay = 0;
+    UINT uiLevel = 0;
+    UINT uiShift = 0;
+
+    assert(NULL != pstWheel && ullExpire >= pstWheel->ullNow);
+
+    ullDelay = ullExpire - pstWheel->ullNow;
+    for (uiLevel = 0; uiLevel < TIMERWHEEL_LEVELS; uiLevel++)
+    {
+        uiShift = uiLevel * TIMERWHEEL_BITS;
+        if ((ullDelay >> uiShift) < TIMERWHEEL_SLOTS)
+        {
+            return uiLevel * TIMERWHEEL_SLOTS +
+                   (UINT)((ullExpire >> uiShift) & TIMERWHEEL_MASK);
+        }
+    }
+
+    uiLevel = TIMERWHEEL_LEVELS - 1;
+    uiShift = uiLevel * TIMERWHEEL_BITS;
+
+    return uiLevel * TIMERWHEEL_SLOTS +
+           (UINT)(((pstWheel->ullNow >> uiShift) - 1) & TIMERWHEEL_MASK);
+}
+
+/*******************************************************************************
+    Func Name:  timerwheel_link
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Put a node into the slot of its expire tick
+        Input:  IN TimerWheel_S *pstWheel
+                IN UINT uiNode
+       Output:  OUT TimerWheel_S *pstWheel
+       Return:  NONE
+      Caution:  pstWheel should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline VOID timerwheel_link(INOUT TimerWheel_S *pstWheel, IN UINT uiNode)
+{
+    UINT uiSlot = 0;
+    UINT uiFirst = 0;
+
+    assert(NULL != pstWheel && uiNode < pstWheel->uiSize);
+
+    uiSlot = timerwheel_slot(pstWheel, pstWheel->pullExpire[uiNode]);
+    uiFirst = pstWheel->auiSlot[uiSlot];
+
+    pstWheel->puiSlot[uiNode] = uiSlot;
+    pstWheel->puiPrev[uiNode] = TIMERWHEEL_NIL;
+    pstWheel->puiNext[uiNode] = uiFirst;
+    if (TIMERWHEEL_NIL != uiFirst)
+    {
+        pstWheel->puiPrev[uiFirst] = uiNode;
+    }
+    pstWheel->auiSlot[uiSlot] = uiNode;
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  timerwheel_release
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Take a node out of its slot and put it into the free list
+        Input:  IN TimerWheel_S *pstWheel
+                IN UINT uiNode
+       Output:  OUT TimerWheel_S *pstWheel
+       Return:  VOID*, item of the node
+      Caution:  pstWheel should not be NULL, and the node should be in use
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static inline VOID* timerwheel_release(INOUT TimerWheel_S *pstWheel,
+                                       IN UINT uiNode)
+{
+    UINT uiPrev = 0;
+    UINT uiNext = 0;
+
+    assert(NULL != pstWheel && uiNode < pstWheel->uiSize);
+    assert(TIMERWHEEL_NIL != pstWheel->puiSlot[uiNode]);
+
+    uiPrev = pstWheel->puiPrev[uiNode];
+    uiNext = pstWheel->puiNext[uiNode];
+    if (TIMERWHEEL_NIL != uiPrev)
+    {
+        pstWheel->puiNext[uiPrev] = uiNext;
+    }
+    else
+    {
+        pstWheel->auiSlot[pstWheel->puiSlot[uiNode]] = uiNext;
+    }
+    if (TIMERWHEEL_NIL != uiNext)
+    {
+        pstWheel->puiPrev[uiNext] = uiPrev;
+    }
+
+    pstWheel->puiSlot[uiNode] = TIMERWHEEL_NIL;
+    pstWheel->puiNext[uiNode] = pstWheel->uiFree;
+    pstWheel->uiFree = uiNode;
+    pstWheel->uiNum--;
+
+    return pstWheel->ppvItem[uiNode];
+}
+
+/*******************************************************************************
+    Func Name:  timerwheel_cascade
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Put the timers of the current slot of a wheel into the lower
+                wheels
+        Input:  IN TimerWheel_S *pstWheel
+                IN UINT uiLevel, the wheel, not 0
+       Output:  OUT TimerWheel_S *pstWheel
+       Return:  NONE
+      Caution:  pstWheel should not be NULL
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static VOID timerwheel_cascade(INOUT TimerWheel_S *pstWheel, IN UINT uiLevel)
+{
+    UINT uiSlot = 0;
+    UINT uiNode = 0;
+    UINT uiNext = 0;
+
+    assert(NULL != pstWheel);
+    assert(0 != uiLevel && uiLevel < TIMERWHEEL_LEVELS);
+
+    uiSlot = uiLevel * TIMERWHEEL_SLOTS +
+             (UINT)((pstWheel->ullNow >> (uiLevel * TIMERWHEEL_BITS)) &
+                    TIMERWHEEL_MASK);
+
+    uiNode = pstWheel->auiSlot[uiSlot];
+    pstWheel->auiSlot[uiSlot] = TIMERWHEEL_NIL;
+    while (TIMERWHEEL_NIL != uiNode)
+    {
+        uiNext = pstWheel->puiNext[uiNode];
+        timerwheel_link(pstWheel, uiNode);
+        uiNode = uiNext;
+    }
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  timerwheel_tick
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Turn the wheel a tick on, and expire the timers of the tick
+        Input:  IN TimerWheel_S *pstWheel
+       Output:  OUT TimerWheel_S *pstWheel
+       Return:  UINT, how many timers expired
+      Caution:  pstWheel should not be NULL. The higher wheels are cascaded
+                first, so a timer falls through all wheels in the same tick
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+static UINT timerwheel_tick(INOUT TimerWheel_S *pstWheel)
+{
+    VOID *pvItem = NULL;
+    UINT uiLevel = 0;
+    UINT uiSlot = 0;
+    UINT uiRet = 0;
+
+    assert(NULL != pstWheel);
+
+    pstWheel->ullNow++;
+
+    /**wheel i turns a slot when all the wheels below it turn a round**/
+    while (uiLevel + 1 < TIMERWHEEL_LEVELS &&
+           0 == ((pstWheel->ullNow >> (uiLevel * TIMERWHEEL_BITS)) &
+                 TIMERWHEEL_MASK))
+    {
+        uiLevel++;
+    }
+    for (; uiLevel > 0; uiLevel--)
+    {
+        timerwheel_cascade(pstWheel, uiLevel);
+    }
+
+    uiSlot = (UINT)(pstWheel->ullNow & TIMERWHEEL_MASK);
+    while (TIMERWHEEL_NIL != pstWheel->auiSlot[uiSlot])
+    {
+        assert(pstWheel->pullExpire[pstWheel->auiSlot[uiSlot]] ==
+               pstWheel->ullNow);
+
+        /**removed before called, the callback can add or cancel timers**/
+        pvItem = timerwheel_release(pstWheel, pstWheel->auiSlot[uiSlot]);
+        if (NULL != pstWheel->pfExpire)
+        {
+            pstWheel->pfExpire(pvItem);
+        }
+        uiRet++;
+    }
+
+    return uiRet;
+}
+
+/*******************************************************************************
+    Func Name:  TimerWheelCreate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a hierarchical timing wheel
+        Input:  IN UINT uiSize, how many timers the wheel can store.
+                IN PF_EXPIRE pfExpire, callback function when a timer expires
+                IN PF_PRINT pfPrint, callback function to print item
+                IN PF_FREE pfFree, callback function to free item
+       Output:  NONE
+       Return:  TimerWheel_S*,  the wheel struct
+                NULL,           error occured
+      Caution:  The current tick is 0 at first.
+                pfExpire and pfPrint can be NULL
+                pfFree can be NULL if you don't want your data to be freed when
+                deleting the wheel
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+TimerWheel_S* TimerWheelCreate(IN UINT uiSize,
+                               IN PF_EXPIRE pfExpire,
+                               IN PF_PRINT pfPrint,
+                               IN PF_FREE pfFree)
+{
+    TimerWheel_S *pstWheel = NULL;
+    UINT uiCount = 0;
+
+    if (0 == uiSize || uiSize >= TIMERWHEEL_NIL)
+    {
+        return NULL;
+    }
+
+    pstWheel = (TimerWheel_S *)malloc(sizeof(TimerWheel_S));
+    if (NULL == pstWheel)
+    {
+        return NULL;
+    }
+    memset(pstWheel, 0, sizeof(TimerWheel_S));
+
+    pstWheel->pullExpire = (UINT64 *)malloc(sizeof(UINT64) * uiSize);
+    pstWheel->ppvItem = (VOID **)malloc(sizeof(VOID *) * uiSize);
+    pstWheel->puiNext = (UINT *)malloc(sizeof(UINT) * uiSize);
+    pstWheel->puiPrev = (UINT *)malloc(sizeof(UINT) * uiSize);
+    pstWheel->puiSlot = (UINT *)malloc(sizeof(UINT) * uiSize);
+    if (NULL == pstWheel->pullExpire || NULL == pstWheel->ppvItem ||
+        NULL == pstWheel->puiNext || NULL == pstWheel->puiPrev ||
+        NULL == pstWheel->puiSlot)
+    {
+        TimerWheelFree(pstWheel);
+        return NULL;
+    }
+
+    /**all nodes are free at first**/
+    for (uiCount = 0; uiCount < uiSize; uiCount++)
+    {
+        pstWheel->puiNext[uiCount] = uiCount + 1;
+        pstWheel->puiSlot[uiCount] = TIMERWHEEL_NIL;
+    }
+    pstWheel->puiNext[uiSize - 1] = TIMERWHEEL_NIL;
+    for (uiCount = 0; uiCount < TIMERWHEEL_LEVELS * TIMERWHEEL_SLOTS; uiCount++)
+    {
+        pstWheel->auiSlot[uiCount] = TIMERWHEEL_NIL;
+    }
+
+    pstWheel->uiSize = uiSize;
+    pstWheel->uiFree = 0;
+    pstWheel->pfExpire = pfExpire;
+    pstWheel->pfPrint = pfPrint;
+    pstWheel->pfFree = pfFree;
+
+    return pstWheel;
+}
+
+/*******************************************************************************
+    Func Name:  TimerWheelFree
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To free a given wheel
+        Input:  IN TimerWheel_S *pstWheel, the wheel to be freed
+       Output:  NONE
+       Return:  NONE
+      Caution:  If you have installed PF_FREE callback function, then items of
+                all timers not expired will be freed, otherwise it's the
+                user's responsibility to free the memeries of all items
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID TimerWheelFree(IN TimerWheel_S *pstWheel)
+{
+    UINT uiSlot = 0;
+    UINT uiNode = 0;
+
+    if (NULL == pstWheel)
+    {
+        return;
+    }
+
+    if (NULL != pstWheel->pfFree && 0 != pstWheel->uiNum)
+    {
+        for (uiSlot = 0; uiSlot < TIMERWHEEL_LEVELS * TIMERWHEEL_SLOTS; uiSlot++)
+        {
+            uiNode = pstWheel->auiSlot[uiSlot];
+            while (TIMERWHEEL_NIL != uiNode)
+            {
+                pstWheel->pfFree(pstWheel->ppvItem[uiNode]);
+                uiNode = pstWheel->puiNext[uiNode];
+            }
+        }
+    }
+
+    free(pstWheel->pullExpire);
+    free(pstWheel->ppvItem);
+    free(pstWheel->puiNext);
+    free(pstWheel->puiPrev);
+    free(pstWheel->puiSlot);
+    free(pstWheel);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  TimerWheelAdd
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Add a timer to wheel
+        Input:  IN TimerWheel_S *pstWheel
+                IN UINT64 ullDelay, how many ticks later the timer expires
+                IN VOID *pvItem, item of the timer
+       Output:  OUT TimerWheel_S *pstWheel
+                OUT UINT *puiHandle, handle of the timer, can be NULL
+       Return:  ULONG
+                ERROR_SUCCESS,  success
+                ERROR_FAILED,   failed
+      Caution:  pvItem should not be NULL, a delay of 0 is taken as 1. The
+                handle keeps valid until the timer expires or is cancelled,
+                then it may be reused by another timer. Costs O(1)
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+ULONG TimerWheelAdd(INOUT TimerWheel_S *pstWheel, IN UINT64 ullDelay,
+                    IN VOID *pvItem, OUT UINT *puiHandle)
+{
+    UINT uiNode = 0;
+
+    if (NULL == pstWheel || NULL == pvItem)
+    {
+        return ERROR_FAILED;
+    }
+
+    if (TIMERWHEEL_NIL == pstWheel->uiFree)
+    {
+        return ERROR_FAILED;
+    }
+
+    /**a timer of the current tick would never expire, its slot is passed**/
+    if (0 == ullDelay)
+    {
+        ullDelay = 1;
+    }
+    if (pstWheel->ullNow + ullDelay < pstWheel->ullNow)
+    {
+        return ERROR_FAILED;
+    }
+
+    uiNode = pstWheel->uiFree;
+    pstWheel->uiFree = pstWheel->puiNext[uiNode];
+    pstWheel->pullExpire[uiNode] = pstWheel->ullNow + ullDelay;
+    pstWheel->ppvItem[uiNode] = pvItem;
+    timerwheel_link(pstWheel, uiNode);
+    pstWheel->uiNum++;
+
+    if (NULL != puiHandle)
+    {
+        *puiHandle = uiNode;
+    }
+
+    return ERROR_SUCCESS;
+}
+
+/*******************************************************************************
+    Func Name:  TimerWheelRemove
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Cancel a timer
+        Input:  IN TimerWheel_S *pstWheel
+                IN UINT uiHandle, handle of the timer
+       Output:  OUT TimerWheel_S *pstWheel
+       Return:  VOID*, item of the timer cancelled
+                NULL, the handle is not in use
+      Caution:  Costs O(1). The memery of the item is left to users to free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* TimerWheelRemove(INOUT TimerWheel_S *pstWheel, IN UINT uiHandle)
+{
+    if (NULL == pstWheel || uiHandle >= pstWheel->uiSize)
+    {
+        return NULL;
+    }
+
+    if (TIMERWHEEL_NIL == pstWheel->puiSlot[uiHandle])
+    {
+        return NULL;
+    }
+
+    return timerwheel_release(pstWheel, uiHandle);
+}
+
+/*******************************************************************************
+    Func Name:  TimerWheelAdvance
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Turn the wheel some ticks on, and expire the timers due
+        Input:  IN TimerWheel_S *pstWheel
+                IN UINT64 ullTicks, how many ticks to turn
+       Output:  OUT TimerWheel_S *pstWheel
+       Return:  UINT, how many timers expired
+      Caution:  PF_EXPIRE is called for each timer expired, timers of the same
+                tick expire in no order. The ticks are turned one by one, but
+                at once if the wheel is empty
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT TimerWheelAdvance(INOUT TimerWheel_S *pstWheel, IN UINT64 ullTicks)
+{
+    UINT uiRet = 0;
+
+    if (NULL == pstWheel)
+    {
+        return 0;
+    }
+
+    while (0 != ullTicks)
+    {
+        /**no slot needs to be looked at, nor any timer cascaded**/
+        if (0 == pstWheel->uiNum)
+        {
+            pstWheel->ullNow += ullTicks;
+            break;
+        }
+
+        uiRet += timerwheel_tick(pstWheel);
+        ullTicks--;
+    }
+
+    return uiRet;
+}
+
+/*******************************************************************************
+    Func Name:  TimerWheelNow
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return the current tick of wheel
+        Input:  IN TimerWheel_S *pstWheel
+       Output:  NONE
+       Return:  UINT64
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT64 TimerWheelNow(IN TimerWheel_S *pstWheel)
+{
+    if (NULL == pstWheel)
+    {
+        return 0;
+    }
+
+    return pstWheel->ullNow;
+}
+
+/*******************************************************************************
+    Func Name:  TimerWheelPrint
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  print items of all timers in wheel
+        Input:  IN TimerWheel_S *pstWheel
+       Output:  NONE
+       Return:  NONE
+      Caution:  slot by slot, not in order of expire ticks
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID TimerWheelPrint(IN TimerWheel_S *pstWheel)
+{
+    UINT uiSlot = 0;
+    UINT uiNode = 0;
+
+    if (NULL == pstWheel || NULL == pstWheel->pfPrint)
+    {
+        return;
+    }
+
+    for (uiSlot = 0; uiSlot < TIMERWHEEL_LEVELS * TIMERWHEEL_SLOTS; uiSlot++)
+    {
+        uiNode = pstWheel->auiSlot[uiSlot];
+        while (TIMERWHEEL_NIL != uiNode)
+        {
+            pstWheel->pfPrint(pstWheel->ppvItem[uiNode]);
+            uiNode = pstWheel->puiNext[uiNode];
+        }
+    }
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  TimerWheelNumber
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many timers in wheel
+        Input:  IN TimerWheel_S *pstWheel
+       Output:  NONE
+       Return:  UINT
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT TimerWheelNumber(IN TimerWheel_S *pstWheel)
+{
+    if (NULL == pstWheel)
+    {
+        return 0;
+    }
+
+    return pstWheel->uiNum;
+}
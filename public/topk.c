@@ -0,0 +1,230 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   topk.c
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   A realization of top-k selector.
+      Others:
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+/**system headfiles**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+/**public headfiles**/
+#include "../include/type.h"
+#include "../include/err.h"
+#include "../include/length.h"
+#include "../include/heap.h"
+#include "../include/topk.h"
+/**module headfiles**/
+
+/*******************************************************************************
+    Func Name:  TopKCreate
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To create a top-k selector
+        Input:  IN UINT uiK, how many items to keep
+                IN UINT uiType, TOPK_MAXI to keep the k max items, TOPK_MINI
+                                to keep the k minimal items
+                IN PF_COMPARE pfCompare, callback function to compare two items
+                IN PF_PRINT pfPrint, callback function to print item
+                IN PF_FREE pfFree, callback function to free item
+       Output:  NONE
+       Return:  TopK_S*,  the selector struct
+                NULL,     error occured
+      Caution:  uiK should not be 0, pfCompare should not be NULL,
+                pfPrint can be NULL
+                pfFree can be NULL if you don't want your data to be freed when
+                deleting the selector
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+TopK_S* TopKCreate(IN UINT uiK, IN UINT uiType,
+                   IN PF_COMPARE pfCompare,
+                   IN PF_PRINT pfPrint,
+                   IN PF_FREE pfFree)
+{
+    TopK_S *pstTopK = NULL;
+    UINT uiHeapType = HEAP_MINI;
+
+    if (0 == uiK || uiType >= TOPK_UPSPACE)
+    {
+        return NULL;
+    }
+
+    pstTopK = (TopK_S *)malloc(sizeof(TopK_S));
+    if (NULL == pstTopK)
+    {
+        return NULL;
+    }
+
+    /**the root is the worst item kept, the first to be dropped**/
+    if (TOPK_MINI == uiType)
+    {
+        uiHeapType = HEAP_MAXI;
+    }
+
+    pstTopK->pstHeap = HeapCreate(uiK, uiHeapType, pfCompare, pfPrint, pfFree);
+    if (NULL == pstTopK->pstHeap)
+    {
+        free(pstTopK);
+        return NULL;
+    }
+    pstTopK->uiK = uiK;
+    pstTopK->uiType = uiType;
+
+    return pstTopK;
+}
+
+/*******************************************************************************
+    Func Name:  TopKFree
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  To free a given selector
+        Input:  IN TopK_S *pstTopK, the selector to be freed
+       Output:  NONE
+       Return:  NONE
+      Caution:  If you have installed PF_FREE callback function, then all the
+                itmes kept will be freed, otherwise it's the user's
+                responsibility to free the memeries of all items
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID TopKFree(IN TopK_S *pstTopK)
+{
+    if (NULL == pstTopK)
+    {
+        return;
+    }
+
+    HeapFree(pstTopK->pstHeap);
+    free(pstTopK);
+
+    return;
+}
+
+/*******************************************************************************
+    Func Name:  TopKOffer
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Offer a candidate to the selector
+        Input:  IN TopK_S *pstTopK
+                IN VOID *pvItem, the candidate
+       Output:  OUT TopK_S *pstTopK
+       Return:  VOID*, the item dropped, it's pvItem itself if it's rejected,
+                       or the worst item kept before if pvItem takes its place
+                NULL, pvItem is kept and nothing is dropped, or failed
+      Caution:  pvItem should not be NULL. A candidate equal to the worst item
+                kept is rejected. A rejection costs one compare, a take costs
+                O(log k). The memery of the item dropped is left to users to
+                free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+VOID* TopKOffer(INOUT TopK_S *pstTopK, IN VOID *pvItem)
+{
+    Heap_S *pstHeap = NULL;
+    INT iCmpRet = 0;
+
+    if (NULL == pstTopK || NULL == pvItem)
+    {
+        return NULL;
+    }
+
+    pstHeap = pstTopK->pstHeap;
+    if (HeapNumber(pstHeap) < pstTopK->uiK)
+    {
+        (VOID)HeapAdd(pstHeap, pvItem);
+        return NULL;
+    }
+
+    /**the hot path, most candidates of a long stream stop here**/
+    iCmpRet = pstHeap->pfCompare(pvItem, *(pstHeap->ppvHeap));
+    if ((TOPK_MAXI == pstTopK->uiType && iCmpRet <= 0) ||
+        (TOPK_MINI == pstTopK->uiType && iCmpRet >= 0))
+    {
+        return pvItem;
+    }
+
+    return HeapReplace(pstHeap, pvItem);
+}
+
+/*******************************************************************************
+    Func Name:  TopKDrainSorted
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Take all items kept out, the best first
+        Input:  IN TopK_S *pstTopK
+       Output:  OUT TopK_S *pstTopK, it's empty then
+                OUT VOID **ppvItems, items taken out
+       Return:  UINT, how many items taken out
+      Caution:  ppvItems should hold TopKNumber items at least, the max item
+                comes first for TOPK_MAXI, the minimal one for TOPK_MINI.
+                Costs O(k log k), the memery of items is left to users to free
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT TopKDrainSorted(INOUT TopK_S *pstTopK, OUT VOID **ppvItems)
+{
+    UINT uiRet = 0;
+    UINT uiCount = 0;
+
+    if (NULL == pstTopK || NULL == ppvItems)
+    {
+        return 0;
+    }
+
+    /**the worst item comes out first, so fill from the back**/
+    uiRet = HeapNumber(pstTopK->pstHeap);
+    for (uiCount = uiRet; uiCount > 0; uiCount--)
+    {
+        ppvItems[uiCount - 1] = HeapRemoveRoot(pstTopK->pstHeap);
+    }
+
+    return uiRet;
+}
+
+/*******************************************************************************
+    Func Name:  TopKNumber
+ Date Created:  2026-10-18
+       Author:  agent
+  Description:  Return how many items kept in selector
+        Input:  IN TopK_S *pstTopK
+       Output:  NONE
+       Return:  UINT
+      Caution:  NONE
+  ----------------------------------------------------------------------------
+  Modification History
+  Date    Author    Modification
+  ----------------------------------------------------------------------------
+  YYYY-MM-DD
+*******************************************************************************/
+UINT TopKNumber(IN TopK_S *pstTopK)
+{
+    if (NULL == pstTopK)
+    {
+        return 0;
+    }
+
+    return HeapNumber(pstTopK->pstHeap);
+}
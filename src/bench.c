@@ -0,0 +1,2655 @@
+/******************************************************************************\
+Copyright(C):   Huazhong University of Science & Technology.
+    FileName:   bench.c
+      Author:   agent
+     Version:   1.0
+        Date:   2026-10-18
+ Description:   benchmarks of data structures.
+      Others:   usage: ./bench [name] [max items], run all benchmarks if no
+                name is given
+    ----------------------------------------------------------------------------
+    Modification History
+    Date            Author          Modification
+    ----------------------------------------------------------------------------
+    YYYY-MM-DD
+\******************************************************************************/
+
+/**include system headfiles**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <assert.h>
+#include <pthread.h>
+
+/**include public headfiles**/
+#include "../include/type.h"
+#include "../include/err.h"
+#include "../include/length.h"
+
+/**include module headfiles**/
+#include "../include/heap.h"
+#include "../include/keyheap.h"
+#include "../include/radixheap.h"
+#include "../include/pairheap.h"
+#include "../include/multiqueue.h"
+#include "../include/topk.h"
+#include "../include/timerwheel.h"
+#include "../include/losertree.h"
+#include "../include/stack.h"
+#include "../include/lfstack.h"
+#include "../include/queue.h"
+#include "../include/linklist.h"
+#include "../include/heapdef.h"
+#include "../include/sllistdef.h"
+#include "../include/extheap.h"
+
+#define BENCH_ROUNDS  100000
+#define BENCH_DEGREE  4
+#define BENCH_SHARDS  1000
+#define BENCH_MQHEAPS 4
+#define BENCH_TOPK    1000
+#define BENCH_TICK    100     /*timers added a tick*/
+#define BENCH_SCAN    10000   /*most items a linear search is timed with*/
+#define BENCH_BATCH   256     /*roots a dispatcher drains a round*/
+#define BENCH_EXTMEM  8       /*keys are 8 times the memery of extheap*/
+#define BENCH_EVICT   3       /*tenths of the items evicted*/
+#define BENCH_CHUNK   1024    /*items of a chunk of chunked stack*/
+#define BENCH_GROWN   64      /*items a batch adds in bench grow*/
+
+typedef VOID (*PF_BENCH)(IN UINT uiMax);
+
+typedef struct tagBench_S
+{
+    CHAR *pcName;
+    PF_BENCH pfBench;
+    UINT uiDefMax;
+}Bench_S;
+
+/**an entry of the dijkstra queue, a vertex may be queued more than once**/
+typedef struct tagBenchPath_S
+{
+    UINT64 ullDist;
+    UINT uiVertex;
+}BenchPath_S;
+
+/**a timer, most are cancelled a few ticks after added**/
+typedef struct tagBenchTimer_S
+{
+    UINT64 ullExpire;
+    UINT uiHandle;
+}BenchTimer_S;
+
+/**a small message passed through a stack or a queue**/
+typedef struct tagBenchMsg_S
+{
+    UINT64 ullId;
+    UINT uiLen;
+    UINT uiFlag;
+}BenchMsg_S;
+
+/**a sorted run being merged**/
+typedef struct tagBenchRun_S
+{
+    UINT *puiCur;
+    UINT *puiEnd;
+}BenchRun_S;
+
+/**heaps and lists specialized on the item type, the order is inlined**/
+#define BENCH_LESS(a, b)      ((a) < (b))
+#define BENCH_PATHLESS(a, b)  ((a).ullDist < (b).ullDist)
+HEAP_DEFINE(BenchUintHeap, UINT, BENCH_LESS)
+HEAP_DEFINE(BenchPathHeap, BenchPath_S, BENCH_PATHLESS)
+SLLIST_DEFINE(BenchUintList, UINT, BENCH_LESS)
+
+/**work of a thread, it pushes and pops the multiqueue, or the heap under the
+   mutex if the multiqueue is NULL**/
+typedef struct tagBenchWorker_S
+{
+    MultiQueue_S *pstQueue;
+    Heap_S *pstHeap;
+    pthread_mutex_t *pstMutex;
+    UINT *puiKeys;
+    UINT uiOps;
+}BenchWorker_S;
+
+/**work of a thread on a shared stack, the lock-free one, or the stack under
+   the mutex if it's NULL, uiPush of every 10 operations are pushes**/
+typedef struct tagBenchStackWorker_S
+{
+    LFStack_S *pstLFStack;
+    Stack_S *pstStack;
+    pthread_mutex_t *pstMutex;
+    UINT *puiKeys;
+    UINT uiOps;
+    UINT uiPush;
+}BenchStackWorker_S;
+
+static INT compare_path(IN VOID *pvFirst, IN VOID *pvSecond)
+{
+    UINT64 ullFirst = ((BenchPath_S *)pvFirst)->ullDist;
+    UINT64 ullSecond = ((BenchPath_S *)pvSecond)->ullDist;
+
+    return (ullFirst > ullSecond) - (ullFirst < ullSecond);
+}
+
+static INT compare_timer(IN VOID *pvFirst, IN VOID *pvSecond)
+{
+    UINT64 ullFirst = ((BenchTimer_S *)pvFirst)->ullExpire;
+    UINT64 ullSecond = ((BenchTimer_S *)pvSecond)->ullExpire;
+
+    return (ullFirst > ullSecond) - (ullFirst < ullSecond);
+}
+
+static INT compare_run(IN VOID *pvFirst, IN VOID *pvSecond)
+{
+    UINT uiFirst = *((BenchRun_S *)pvFirst)->puiCur;
+    UINT uiSecond = *((BenchRun_S *)pvSecond)->puiCur;
+
+    return (uiFirst > uiSecond) - (uiFirst < uiSecond);
+}
+
+static INT compare(IN VOID *puiFirst, IN VOID *puiSecond)
+{
+    UINT uiFirst = *(UINT *)puiFirst;
+    UINT uiSecond = *(UINT *)puiSecond;
+
+    assert(NULL != puiFirst);
+    assert(NULL != puiSecond);
+
+    return (uiFirst > uiSecond) - (uiFirst < uiSecond);
+}
+
+static ULONG hash(IN VOID *puiItem)
+{
+    return (ULONG)(*(UINT *)puiItem * 0x9E3779B97F4A7C15ULL >> 17);
+}
+
+static int compare_key(const void *puiFirst, const void *puiSecond)
+{
+    return compare((VOID *)puiFirst, (VOID *)puiSecond);
+}
+
+static int compare_qsort(const void *ppvFirst, const void *ppvSecond)
+{
+    return compare(*(VOID **)ppvFirst, *(VOID **)ppvSecond);
+}
+
+static VOID* bench_next(IN VOID *pvRun)
+{
+    BenchRun_S *pstRun = (BenchRun_S *)pvRun;
+
+    if (pstRun->puiCur == pstRun->puiEnd)
+    {
+        return NULL;
+    }
+
+    return pstRun->puiCur++;
+}
+
+static DOUBLE bench_now(VOID)
+{
+    struct timespec stTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &stTime);
+
+    return stTime.tv_sec + stTime.tv_nsec / 1e9;
+}
+
+static UINT* bench_keys(IN UINT uiNum)
+{
+    UINT *puiKeys = NULL;
+    UINT uiCount = 0;
+
+    puiKeys = (UINT *)malloc(sizeof(UINT) * uiNum);
+    if (NULL == puiKeys)
+    {
+        printf("malloc %u keys failed\n", uiNum);
+        exit(1);
+    }
+
+    srand(uiNum);
+    for (uiCount = 0; uiCount < uiNum; uiCount++)
+    {
+        puiKeys[uiCount] = ((UINT)rand() << 16) ^ (UINT)rand();
+    }
+
+    return puiKeys;
+}
+
+static UINT bench_log2(IN UINT uiNum)
+{
+    UINT uiRet = 0;
+
+    while (uiNum > 1)
+    {
+        uiNum >>= 1;
+        uiRet++;
+    }
+
+    return uiRet;
+}
+
+/**pop and push back the root of a heap of n items, shows pop cost ~ log n**/
+static VOID bench_heap_pop(IN UINT uiMax)
+{
+    Heap_S *pstHeap = NULL;
+    UINT *puiKeys = NULL;
+    UINT uiNum = 0;
+    UINT uiCount = 0;
+    VOID *pvItem = NULL;
+    DOUBLE dBegin = 0;
+    DOUBLE dCost = 0;
+
+    printf("%-12s %12s %12s %14s\n", "heap_pop", "items", "ns/pop", "ns/pop/log2n");
+    for (uiNum = 1000; uiNum <= uiMax; uiNum *= 10)
+    {
+        puiKeys = bench_keys(uiNum);
+        pstHeap = HeapCreate(uiNum, HEAP_MINI, compare, NULL, NULL);
+        if (NULL == pstHeap)
+        {
+            printf("create heap of %u items failed\n", uiNum);
+            free(puiKeys);
+            return;
+        }
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            (VOID)HeapAdd(pstHeap, &puiKeys[uiCount]);
+        }
+
+        dBegin = bench_now();
+        for (uiCount = 0; uiCount < BENCH_ROUNDS; uiCount++)
+        {
+            pvItem = HeapRemoveRoot(pstHeap);
+            *(UINT *)pvItem += uiNum;
+            (VOID)HeapAdd(pstHeap, pvItem);
+        }
+        dCost = (bench_now() - dBegin) * 1e9 / BENCH_ROUNDS;
+
+        printf("%-12s %12u %12.1f %14.2f\n", "", uiNum, dCost,
+               dCost / bench_log2(uiNum));
+
+        HeapFree(pstHeap);
+        free(puiKeys);
+    }
+
+    return;
+}
+
+/**fill a heap by n HeapAdd against one HeapCreateFromArray**/
+static VOID bench_heap_build(IN UINT uiMax)
+{
+    Heap_S *pstHeap = NULL;
+    UINT *puiKeys = NULL;
+    VOID **ppvItems = NULL;
+    UINT uiNum = 0;
+    UINT uiCount = 0;
+    DOUBLE dBegin = 0;
+    DOUBLE dAdd = 0;
+    DOUBLE dBuild = 0;
+
+    printf("%-12s %12s %12s %12s\n", "heap_build", "items", "add ms", "build ms");
+    for (uiNum = 1000; uiNum <= uiMax; uiNum *= 10)
+    {
+        puiKeys = bench_keys(uiNum);
+        ppvItems = (VOID **)malloc(sizeof(VOID *) * uiNum);
+        if (NULL == ppvItems)
+        {
+            free(puiKeys);
+            return;
+        }
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            ppvItems[uiCount] = &puiKeys[uiCount];
+        }
+
+        dBegin = bench_now();
+        pstHeap = HeapCreate(uiNum, HEAP_MINI, compare, NULL, NULL);
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            (VOID)HeapAdd(pstHeap, ppvItems[uiCount]);
+        }
+        dAdd = (bench_now() - dBegin) * 1e3;
+        HeapFree(pstHeap);
+
+        dBegin = bench_now();
+        pstHeap = HeapCreateFromArray(ppvItems, uiNum, uiNum, HEAP_MINI,
+                                      compare, NULL, NULL);
+        dBuild = (bench_now() - dBegin) * 1e3;
+        HeapFree(pstHeap);
+
+        printf("%-12s %12u %12.2f %12.2f\n", "", uiNum, dAdd, dBuild);
+
+        free(ppvItems);
+        free(puiKeys);
+    }
+
+    return;
+}
+
+/**reschedule an item by HeapRemoveItem and HeapAdd against HeapUpdate**/
+static VOID bench_heap_update(IN UINT uiMax)
+{
+    Heap_S *pstHeap = NULL;
+    UINT *puiKeys = NULL;
+    UINT *puiHandle = NULL;
+    UINT uiNum = 0;
+    UINT uiCount = 0;
+    UINT uiPick = 0;
+    UINT uiRounds = 0;
+    DOUBLE dBegin = 0;
+    DOUBLE dRemove = 0;
+    DOUBLE dUpdate = 0;
+
+    printf("%-12s %12s %12s %12s\n", "heap_update", "items", "remove ns", "update ns");
+    for (uiNum = 1000; uiNum <= uiMax; uiNum *= 10)
+    {
+        puiKeys = bench_keys(uiNum);
+        puiHandle = (UINT *)malloc(sizeof(UINT) * uiNum);
+        pstHeap = HeapCreate(uiNum, HEAP_MINI | HEAP_INDEXED, compare, NULL, NULL);
+        if (NULL == puiHandle || NULL == pstHeap)
+        {
+            HeapFree(pstHeap);
+            free(puiHandle);
+            free(puiKeys);
+            return;
+        }
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            (VOID)HeapAddHandle(pstHeap, &puiKeys[uiCount], &puiHandle[uiCount]);
+        }
+
+        /**the linear removal is too slow to run as many rounds**/
+        uiRounds = BENCH_ROUNDS / 100;
+        dBegin = bench_now();
+        for (uiCount = 0; uiCount < uiRounds; uiCount++)
+        {
+            uiPick = (uiCount * 7919) % uiNum;
+            (VOID)HeapRemoveItem(pstHeap, &puiKeys[uiPick]);
+            puiKeys[uiPick] ^= uiCount;
+            (VOID)HeapAdd(pstHeap, &puiKeys[uiPick]);
+        }
+        dRemove = (bench_now() - dBegin) * 1e9 / uiRounds;
+
+        /**the heap is full, so every handle is in use**/
+        dBegin = bench_now();
+        for (uiCount = 0; uiCount < BENCH_ROUNDS; uiCount++)
+        {
+            uiPick = (uiCount * 7919) % uiNum;
+            *(UINT *)pstHeap->ppvHeap[pstHeap->puiPlace[uiPick]] ^= uiCount;
+            (VOID)HeapUpdate(pstHeap, uiPick);
+        }
+        dUpdate = (bench_now() - dBegin) * 1e9 / BENCH_ROUNDS;
+
+        printf("%-12s %12u %12.1f %12.1f\n", "", uiNum, dRemove, dUpdate);
+
+        HeapFree(pstHeap);
+        free(puiHandle);
+        free(puiKeys);
+    }
+
+    return;
+}
+
+/**pop and push back the root of binary, 4-ary and 8-ary heaps**/
+static VOID bench_heap_arity(IN UINT uiMax)
+{
+    Heap_S *pstHeap = NULL;
+    UINT *puiKeys = NULL;
+    VOID **ppvItems = NULL;
+    VOID *pvItem = NULL;
+    UINT auiArity[] = {0, HEAP_ARITY4, HEAP_ARITY8};
+    UINT auiNum[] = {1000, 1000000, 100000000};
+    UINT uiArity = 0;
+    UINT uiStep = 0;
+    UINT uiNum = 0;
+    UINT uiCount = 0;
+    DOUBLE dBegin = 0;
+    DOUBLE adCost[3];
+
+    printf("%-12s %12s %12s %12s %12s\n", "heap_arity", "items",
+           "2-ary ns", "4-ary ns", "8-ary ns");
+    for (uiStep = 0; uiStep < sizeof(auiNum) / sizeof(UINT); uiStep++)
+    {
+        uiNum = auiNum[uiStep];
+        if (uiNum > uiMax)
+        {
+            break;
+        }
+
+        puiKeys = bench_keys(uiNum);
+        ppvItems = (VOID **)malloc(sizeof(VOID *) * uiNum);
+        if (NULL == ppvItems)
+        {
+            free(puiKeys);
+            return;
+        }
+
+        for (uiArity = 0; uiArity < 3; uiArity++)
+        {
+            for (uiCount = 0; uiCount < uiNum; uiCount++)
+            {
+                ppvItems[uiCount] = &puiKeys[uiCount];
+            }
+            pstHeap = HeapCreateFromArray(ppvItems, uiNum, uiNum,
+                                          HEAP_MINI | auiArity[uiArity],
+                                          compare, NULL, NULL);
+            if (NULL == pstHeap)
+            {
+                printf("create heap of %u items failed\n", uiNum);
+                break;
+            }
+
+            dBegin = bench_now();
+            for (uiCount = 0; uiCount < BENCH_ROUNDS; uiCount++)
+            {
+                pvItem = HeapRemoveRoot(pstHeap);
+                *(UINT *)pvItem += uiNum;
+                (VOID)HeapAdd(pstHeap, pvItem);
+            }
+            adCost[uiArity] = (bench_now() - dBegin) * 1e9 / BENCH_ROUNDS;
+
+            HeapFree(pstHeap);
+        }
+
+        if (3 == uiArity)
+        {
+            printf("%-12s %12u %12.1f %12.1f %12.1f\n", "", uiNum,
+                   adCost[0], adCost[1], adCost[2]);
+        }
+
+        free(ppvItems);
+        free(puiKeys);
+    }
+
+    return;
+}
+
+/**peek both ends, drop the max and add a new item on every tick, HEAP_MINI
+   scans the leaves for the max while HEAP_MINMAX finds it at once, and the
+   cost of popping the root shows the price of it**/
+static VOID bench_heap_minmax(IN UINT uiMax)
+{
+    Heap_S *pstHeap = NULL;
+    UINT *puiKeys = NULL;
+    VOID *pvItem = NULL;
+    UINT auiType[] = {HEAP_MINI, HEAP_MINMAX};
+    UINT uiType = 0;
+    UINT uiNum = 0;
+    UINT uiCount = 0;
+    UINT uiRounds = 0;
+    DOUBLE dBegin = 0;
+    DOUBLE adTick[2];
+    DOUBLE adPop[2];
+
+    printf("%-12s %12s %12s %12s %12s %12s\n", "heap_minmax", "items",
+           "mini tick", "minmax tick", "mini pop", "minmax pop");
+    for (uiNum = 1000; uiNum <= uiMax; uiNum *= 10)
+    {
+        puiKeys = bench_keys(uiNum);
+
+        for (uiType = 0; uiType < 2; uiType++)
+        {
+            pstHeap = HeapCreate(uiNum, auiType[uiType], compare, NULL, NULL);
+            if (NULL == pstHeap)
+            {
+                printf("create heap of %u items failed\n", uiNum);
+                free(puiKeys);
+                return;
+            }
+            for (uiCount = 0; uiCount < uiNum; uiCount++)
+            {
+                (VOID)HeapAdd(pstHeap, &puiKeys[uiCount]);
+            }
+
+            /**the leaf scan is too slow to run as many rounds**/
+            uiRounds = (HEAP_MINI == auiType[uiType]) ? BENCH_ROUNDS / 100 : BENCH_ROUNDS;
+            dBegin = bench_now();
+            for (uiCount = 0; uiCount < uiRounds; uiCount++)
+            {
+                (VOID)HeapMin(pstHeap);
+                (VOID)HeapMax(pstHeap);
+                pvItem = HeapRemoveMax(pstHeap);
+                *(UINT *)pvItem ^= uiCount;
+                (VOID)HeapAdd(pstHeap, pvItem);
+            }
+            adTick[uiType] = (bench_now() - dBegin) * 1e9 / uiRounds;
+
+            dBegin = bench_now();
+            for (uiCount = 0; uiCount < BENCH_ROUNDS; uiCount++)
+            {
+                pvItem = HeapRemoveRoot(pstHeap);
+                *(UINT *)pvItem += uiNum;
+                (VOID)HeapAdd(pstHeap, pvItem);
+            }
+            adPop[uiType] = (bench_now() - dBegin) * 1e9 / BENCH_ROUNDS;
+
+            HeapFree(pstHeap);
+        }
+
+        printf("%-12s %12u %12.1f %12.1f %12.1f %12.1f\n", "", uiNum,
+               adTick[0], adTick[1], adPop[0], adPop[1]);
+
+        free(puiKeys);
+    }
+
+    return;
+}
+
+/**pop and push back the root of the callback heap and the inline-key heap**/
+static VOID bench_keyheap(IN UINT uiMax)
+{
+    Heap_S *pstHeap = NULL;
+    KeyHeap_S *pstKeyHeap = NULL;
+    UINT *puiKeys = NULL;
+    VOID *pvItem = NULL;
+    UINT64 ullKey = 0;
+    UINT uiNum = 0;
+    UINT uiCount = 0;
+    DOUBLE dBegin = 0;
+    DOUBLE dHeap = 0;
+    DOUBLE dKeyHeap = 0;
+
+    printf("%-12s %12s %12s %12s\n", "keyheap", "items", "heap ns", "keyheap ns");
+    for (uiNum = 1000; uiNum <= uiMax; uiNum *= 10)
+    {
+        puiKeys = bench_keys(uiNum);
+        pstHeap = HeapCreate(uiNum, HEAP_MINI, compare, NULL, NULL);
+        pstKeyHeap = KeyHeapCreate(uiNum, KEYHEAP_MINI, NULL, NULL);
+        if (NULL == pstHeap || NULL == pstKeyHeap)
+        {
+            printf("create heap of %u items failed\n", uiNum);
+            HeapFree(pstHeap);
+            KeyHeapFree(pstKeyHeap);
+            free(puiKeys);
+            return;
+        }
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            (VOID)HeapAdd(pstHeap, &puiKeys[uiCount]);
+            (VOID)KeyHeapAdd(pstKeyHeap, puiKeys[uiCount], &puiKeys[uiCount]);
+        }
+
+        dBegin = bench_now();
+        for (uiCount = 0; uiCount < BENCH_ROUNDS; uiCount++)
+        {
+            pvItem = HeapRemoveRoot(pstHeap);
+            *(UINT *)pvItem += uiNum;
+            (VOID)HeapAdd(pstHeap, pvItem);
+        }
+        dHeap = (bench_now() - dBegin) * 1e9 / BENCH_ROUNDS;
+
+        dBegin = bench_now();
+        for (uiCount = 0; uiCount < BENCH_ROUNDS; uiCount++)
+        {
+            pvItem = KeyHeapRemoveRoot(pstKeyHeap, &ullKey);
+            (VOID)KeyHeapAdd(pstKeyHeap, ullKey + uiNum, pvItem);
+        }
+        dKeyHeap = (bench_now() - dBegin) * 1e9 / BENCH_ROUNDS;
+
+        printf("%-12s %12u %12.1f %12.1f\n", "", uiNum, dHeap, dKeyHeap);
+
+        HeapFree(pstHeap);
+        KeyHeapFree(pstKeyHeap);
+        free(puiKeys);
+    }
+
+    return;
+}
+
+/**dijkstra from vertex 0 of a random graph, every vertex has BENCH_DEGREE
+   out edges of weight 1 to 1000, by Heap_S and by RadixHeap_S**/
+static VOID bench_dijkstra(IN UINT uiMax)
+{
+    Heap_S *pstHeap = NULL;
+    RadixHeap_S *pstRadix = NULL;
+    BenchPath_S *pstPath = NULL;
+    BenchPath_S *pstEntry = NULL;
+    UINT *puiTo = NULL;
+    UINT *puiWeight = NULL;
+    UINT64 *pullDist = NULL;
+    UINT64 ullDist = 0;
+    UINT64 aullSum[2];
+    UINT uiNum = 0;
+    UINT uiEdges = 0;
+    UINT uiCount = 0;
+    UINT uiVertex = 0;
+    UINT uiEdge = 0;
+    UINT uiUsed = 0;
+    DOUBLE dBegin = 0;
+    DOUBLE dHeap = 0;
+    DOUBLE dRadix = 0;
+
+    printf("%-12s %12s %12s %12s %12s\n", "dijkstra", "vertexes", "heap ms",
+           "radix ms", "same");
+    for (uiNum = 1000; uiNum <= uiMax; uiNum *= 10)
+    {
+        uiEdges = uiNum * BENCH_DEGREE;
+        puiTo = bench_keys(uiEdges);
+        puiWeight = bench_keys(uiEdges + 1);
+        pullDist = (UINT64 *)malloc(sizeof(UINT64) * uiNum);
+        pstPath = (BenchPath_S *)malloc(sizeof(BenchPath_S) * (uiEdges + 1));
+        pstHeap = HeapCreate(uiEdges + 1, HEAP_MINI, compare_path, NULL, NULL);
+        pstRadix = RadixHeapCreate(uiEdges + 1, NULL, NULL);
+        if (NULL == pullDist || NULL == pstPath || NULL == pstHeap ||
+            NULL == pstRadix)
+        {
+            printf("create graph of %u vertexes failed\n", uiNum);
+            HeapFree(pstHeap);
+            RadixHeapFree(pstRadix);
+            free(pstPath);
+            free(pullDist);
+            free(puiWeight);
+            free(puiTo);
+            return;
+        }
+        for (uiCount = 0; uiCount < uiEdges; uiCount++)
+        {
+            puiTo[uiCount] %= uiNum;
+            puiWeight[uiCount] = puiWeight[uiCount] % 1000 + 1;
+        }
+
+        /**every pop of a vertex not done yet pushes its out edges**/
+        dBegin = bench_now();
+        memset(pullDist, 0xFF, sizeof(UINT64) * uiNum);
+        pullDist[0] = 0;
+        pstPath[0].ullDist = 0;
+        pstPath[0].uiVertex = 0;
+        uiUsed = 1;
+        (VOID)HeapAdd(pstHeap, &pstPath[0]);
+        while (0 != HeapNumber(pstHeap))
+        {
+            pstEntry = (BenchPath_S *)HeapRemoveRoot(pstHeap);
+            uiVertex = pstEntry->uiVertex;
+            if (pstEntry->ullDist > pullDist[uiVertex])
+            {
+                continue;
+            }
+            for (uiEdge = uiVertex * BENCH_DEGREE;
+                 uiEdge < (uiVertex + 1) * BENCH_DEGREE; uiEdge++)
+            {
+                ullDist = pstEntry->ullDist + puiWeight[uiEdge];
+                if (ullDist < pullDist[puiTo[uiEdge]])
+                {
+                    pullDist[puiTo[uiEdge]] = ullDist;
+                    pstPath[uiUsed].ullDist = ullDist;
+                    pstPath[uiUsed].uiVertex = puiTo[uiEdge];
+                    (VOID)HeapAdd(pstHeap, &pstPath[uiUsed]);
+                    uiUsed++;
+                }
+            }
+        }
+        dHeap = (bench_now() - dBegin) * 1e3;
+        aullSum[0] = 0;
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            aullSum[0] += pullDist[uiCount];
+        }
+
+        /**the item is the vertex itself, the key is the distance**/
+        dBegin = bench_now();
+        memset(pullDist, 0xFF, sizeof(UINT64) * uiNum);
+        pullDist[0] = 0;
+        (VOID)RadixHeapAdd(pstRadix, 0, &pullDist[0]);
+        while (0 != RadixHeapNumber(pstRadix))
+        {
+            uiVertex = (UINT64 *)RadixHeapRemoveRoot(pstRadix, &ullDist) - pullDist;
+            if (ullDist > pullDist[uiVertex])
+            {
+                continue;
+            }
+            for (uiEdge = uiVertex * BENCH_DEGREE;
+                 uiEdge < (uiVertex + 1) * BENCH_DEGREE; uiEdge++)
+            {
+                if (ullDist + puiWeight[uiEdge] < pullDist[puiTo[uiEdge]])
+                {
+                    pullDist[puiTo[uiEdge]] = ullDist + puiWeight[uiEdge];
+                    (VOID)RadixHeapAdd(pstRadix, pullDist[puiTo[uiEdge]],
+                                       &pullDist[puiTo[uiEdge]]);
+                }
+            }
+        }
+        dRadix = (bench_now() - dBegin) * 1e3;
+        aullSum[1] = 0;
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            aullSum[1] += pullDist[uiCount];
+        }
+
+        printf("%-12s %12u %12.2f %12.2f %12s\n", "", uiNum, dHeap, dRadix,
+               (aullSum[0] == aullSum[1]) ? "yes" : "no");
+
+        HeapFree(pstHeap);
+        RadixHeapFree(pstRadix);
+        free(pstPath);
+        free(pullDist);
+        free(puiWeight);
+        free(puiTo);
+    }
+
+    return;
+}
+
+/**merge BENCH_SHARDS heaps into one, by popping and adding every item or 
+   adding each shard as a batch to Heap_S, and by melding PairHeap_S, then
+   pop all items of the merged heap**/
+static VOID bench_merge(IN UINT uiMax)
+{
+    Heap_S *apstHeap[BENCH_SHARDS];
+    PairHeap_S *apstPair[BENCH_SHARDS];
+    Heap_S *pstHeap = NULL;
+    UINT *puiKeys = NULL;
+    UINT uiNum = 0;
+    UINT uiPer = 0;
+    UINT uiShard = 0;
+    UINT uiCount = 0;
+    UINT uiMethod = 0;
+    DOUBLE dBegin = 0;
+    DOUBLE adMerge[3];
+    DOUBLE adDrain[2];
+
+    printf("%-12s %12s %12s %12s %12s %12s %12s\n", "merge", "items",
+           "pop-add ms", "batch ms", "meld ms", "heap pop ms", "pair pop ms");
+    for (uiNum = BENCH_SHARDS * 10; uiNum <= uiMax; uiNum *= 10)
+    {
+        uiPer = uiNum / BENCH_SHARDS;
+        puiKeys = bench_keys(uiNum);
+
+        for (uiMethod = 0; uiMethod < 2; uiMethod++)
+        {
+            for (uiShard = 0; uiShard < BENCH_SHARDS; uiShard++)
+            {
+                apstHeap[uiShard] = HeapCreate(uiPer, HEAP_MINI, compare,
+                                               NULL, NULL);
+                for (uiCount = 0; uiCount < uiPer; uiCount++)
+                {
+                    (VOID)HeapAdd(apstHeap[uiShard],
+                                  &puiKeys[uiShard * uiPer + uiCount]);
+                }
+            }
+            pstHeap = HeapCreate(uiNum, HEAP_MINI, compare, NULL, NULL);
+
+            dBegin = bench_now();
+            for (uiShard = 0; uiShard < BENCH_SHARDS; uiShard++)
+            {
+                if (0 == uiMethod)
+                {
+                    while (0 != HeapNumber(apstHeap[uiShard]))
+                    {
+                        (VOID)HeapAdd(pstHeap, HeapRemoveRoot(apstHeap[uiShard]));
+                    }
+                }
+                else
+                {
+                    (VOID)HeapAddBatch(pstHeap, apstHeap[uiShard]->ppvHeap,
+                                       HeapNumber(apstHeap[uiShard]));
+                }
+            }
+            adMerge[uiMethod] = (bench_now() - dBegin) * 1e3;
+
+            for (uiShard = 0; uiShard < BENCH_SHARDS; uiShard++)
+            {
+                HeapFree(apstHeap[uiShard]);
+            }
+
+            dBegin = bench_now();
+            while (0 != HeapNumber(pstHeap))
+            {
+                (VOID)HeapRemoveRoot(pstHeap);
+            }
+            adDrain[0] = (bench_now() - dBegin) * 1e3;
+            HeapFree(pstHeap);
+        }
+
+        for (uiShard = 0; uiShard < BENCH_SHARDS; uiShard++)
+        {
+            apstPair[uiShard] = PairHeapCreate(PAIRHEAP_MINI, compare, NULL, NULL);
+            for (uiCount = 0; uiCount < uiPer; uiCount++)
+            {
+                (VOID)PairHeapAdd(apstPair[uiShard],
+                                  &puiKeys[uiShard * uiPer + uiCount]);
+            }
+        }
+
+        dBegin = bench_now();
+        for (uiShard = 1; uiShard < BENCH_SHARDS; uiShard++)
+        {
+            (VOID)PairHeapMerge(apstPair[0], apstPair[uiShard]);
+        }
+        adMerge[2] = (bench_now() - dBegin) * 1e3;
+
+        dBegin = bench_now();
+        while (0 != PairHeapNumber(apstPair[0]))
+        {
+            (VOID)PairHeapRemoveRoot(apstPair[0]);
+        }
+        adDrain[1] = (bench_now() - dBegin) * 1e3;
+
+        for (uiShard = 0; uiShard < BENCH_SHARDS; uiShard++)
+        {
+            PairHeapFree(apstPair[uiShard]);
+        }
+
+        printf("%-12s %12u %12.2f %12.2f %12.3f %12.2f %12.2f\n", "", uiNum,
+               adMerge[0], adMerge[1], adMerge[2], adDrain[0], adDrain[1]);
+
+        free(puiKeys);
+    }
+
+    return;
+}
+
+static VOID* bench_worker(IN VOID *pvArg)
+{
+    BenchWorker_S *pstWorker = (BenchWorker_S *)pvArg;
+    UINT uiCount = 0;
+
+    for (uiCount = 0; uiCount < pstWorker->uiOps; uiCount++)
+    {
+        if (NULL != pstWorker->pstQueue)
+        {
+            if (0 == (uiCount & 1))
+            {
+                (VOID)MultiQueueAdd(pstWorker->pstQueue,
+                                    &pstWorker->puiKeys[uiCount]);
+            }
+            else
+            {
+                (VOID)MultiQueueRemoveRoot(pstWorker->pstQueue);
+            }
+            continue;
+        }
+
+        pthread_mutex_lock(pstWorker->pstMutex);
+        if (0 == (uiCount & 1))
+        {
+            (VOID)HeapAdd(pstWorker->pstHeap, &pstWorker->puiKeys[uiCount]);
+        }
+        else
+        {
+            (VOID)HeapRemoveRoot(pstWorker->pstHeap);
+        }
+        pthread_mutex_unlock(pstWorker->pstMutex);
+    }
+
+    return NULL;
+}
+
+/**threads push and pop in turn, one heap under a mutex against a multiqueue
+   of BENCH_MQHEAPS heaps a thread, both prefilled with BENCH_ROUNDS items.
+   The threads can't run in parallel on a machine of less cores**/
+static VOID bench_mq_threads(IN UINT uiMax)
+{
+    BenchWorker_S astWorker[64];
+    pthread_t astThread[64];
+    pthread_mutex_t stMutex;
+    MultiQueue_S *pstQueue = NULL;
+    Heap_S *pstHeap = NULL;
+    UINT *puiKeys = NULL;
+    UINT uiThreads = 0;
+    UINT uiCount = 0;
+    UINT uiMethod = 0;
+    DOUBLE dBegin = 0;
+    DOUBLE adMops[2];
+
+    if (uiMax > 64)
+    {
+        uiMax = 64;
+    }
+
+    pthread_mutex_init(&stMutex, NULL);
+    puiKeys = bench_keys(BENCH_ROUNDS);
+    printf("%-12s %12s %12s %12s\n", "mq_threads", "threads", "mutex Mops",
+           "mq Mops");
+    for (uiThreads = 1; uiThreads <= uiMax; uiThreads *= 2)
+    {
+        for (uiMethod = 0; uiMethod < 2; uiMethod++)
+        {
+            pstHeap = NULL;
+            pstQueue = NULL;
+            if (0 == uiMethod)
+            {
+                pstHeap = HeapCreate(BENCH_ROUNDS, HEAP_MINI, compare,
+                                     NULL, NULL);
+                (VOID)HeapSetGrow(pstHeap, 0);
+            }
+            else
+            {
+                pstQueue = MultiQueueCreate(BENCH_MQHEAPS * uiThreads + 1,
+                                            BENCH_ROUNDS / uiThreads,
+                                            HEAP_MINI, compare, NULL, NULL);
+            }
+            for (uiCount = 0; uiCount < BENCH_ROUNDS; uiCount++)
+            {
+                (VOID)((NULL != pstHeap) ?
+                       HeapAdd(pstHeap, &puiKeys[uiCount]) :
+                       MultiQueueAdd(pstQueue, &puiKeys[uiCount]));
+            }
+
+            dBegin = bench_now();
+            for (uiCount = 0; uiCount < uiThreads; uiCount++)
+            {
+                astWorker[uiCount].pstQueue = pstQueue;
+                astWorker[uiCount].pstHeap = pstHeap;
+                astWorker[uiCount].pstMutex = &stMutex;
+                astWorker[uiCount].puiKeys = puiKeys;
+                astWorker[uiCount].uiOps = BENCH_ROUNDS;
+                pthread_create(&astThread[uiCount], NULL, bench_worker,
+                               &astWorker[uiCount]);
+            }
+            for (uiCount = 0; uiCount < uiThreads; uiCount++)
+            {
+                pthread_join(astThread[uiCount], NULL);
+            }
+            adMops[uiMethod] = (DOUBLE)BENCH_ROUNDS * uiThreads /
+                               (bench_now() - dBegin) / 1e6;
+
+            HeapFree(pstHeap);
+            MultiQueueFree(pstQueue);
+        }
+
+        printf("%-12s %12u %12.2f %12.2f\n", "", uiThreads, adMops[0],
+               adMops[1]);
+    }
+
+    pthread_mutex_destroy(&stMutex);
+    free(puiKeys);
+
+    return;
+}
+
+/**pop half of n distinct keys from a multiqueue of m heaps, the rank of a
+   key popped is how many keys left are less than it, 0 for an exact pop**/
+static VOID bench_mq_rank(IN UINT uiMax)
+{
+    MultiQueue_S *pstQueue = NULL;
+    UINT *puiKeys = NULL;
+    UINT *puiTree = NULL;
+    UINT uiHeaps = 0;
+    UINT uiCount = 0;
+    UINT uiIndex = 0;
+    UINT uiSwap = 0;
+    UINT uiRank = 0;
+    UINT uiWorst = 0;
+    UINT64 ullSum = 0;
+
+    puiKeys = (UINT *)malloc(sizeof(UINT) * uiMax);
+    puiTree = (UINT *)malloc(sizeof(UINT) * (uiMax + 1));
+    if (NULL == puiKeys || NULL == puiTree)
+    {
+        printf("malloc %u keys failed\n", uiMax);
+        exit(1);
+    }
+
+    /**a shuffle of 0 ~ n-1**/
+    srand(uiMax);
+    for (uiCount = 0; uiCount < uiMax; uiCount++)
+    {
+        puiKeys[uiCount] = uiCount;
+    }
+    for (uiCount = uiMax - 1; uiCount > 0; uiCount--)
+    {
+        uiIndex = (((UINT)rand() << 16) ^ (UINT)rand()) % (uiCount + 1);
+        uiSwap = puiKeys[uiCount];
+        puiKeys[uiCount] = puiKeys[uiIndex];
+        puiKeys[uiIndex] = uiSwap;
+    }
+
+    printf("%-12s %12s %12s %12s %12s\n", "mq_rank", "heaps", "items",
+           "mean rank", "max rank");
+    for (uiHeaps = 2; uiHeaps <= 256; uiHeaps *= 4)
+    {
+        pstQueue = MultiQueueCreate(uiHeaps, uiMax / uiHeaps, HEAP_MINI,
+                                    compare, NULL, NULL);
+        for (uiCount = 0; uiCount < uiMax; uiCount++)
+        {
+            (VOID)MultiQueueAdd(pstQueue, &puiKeys[uiCount]);
+        }
+
+        /**fenwick tree of keys left, every key is left at first**/
+        for (uiCount = 1; uiCount <= uiMax; uiCount++)
+        {
+            puiTree[uiCount] = uiCount & (0 - uiCount);
+        }
+
+        ullSum = 0;
+        uiWorst = 0;
+        for (uiCount = 0; uiCount < uiMax / 2; uiCount++)
+        {
+            /**key k sits at k + 1, keys less than it are summed up to k**/
+            uiSwap = *(UINT *)MultiQueueRemoveRoot(pstQueue);
+            uiRank = 0;
+            for (uiIndex = uiSwap; uiIndex > 0; uiIndex &= uiIndex - 1)
+            {
+                uiRank += puiTree[uiIndex];
+            }
+            for (uiIndex = uiSwap + 1; uiIndex <= uiMax;
+                 uiIndex += uiIndex & (0 - uiIndex))
+            {
+                puiTree[uiIndex]--;
+            }
+            ullSum += uiRank;
+            uiWorst = (uiRank > uiWorst) ? uiRank : uiWorst;
+        }
+
+        printf("%-12s %12u %12u %12.2f %12u\n", "", uiHeaps, uiMax,
+               (DOUBLE)ullSum / (uiMax / 2), uiWorst);
+        MultiQueueFree(pstQueue);
+    }
+
+    free(puiKeys);
+    free(puiTree);
+
+    return;
+}
+
+/**keep the BENCH_TOPK max keys of a stream, by removing the root and adding
+   the candidate, by HeapPushPop, and by TopKOffer. In an ascending stream
+   every candidate is taken, in a random one most are rejected**/
+static VOID bench_topk(IN UINT uiMax)
+{
+    Heap_S *pstHeap = NULL;
+    TopK_S *pstTopK = NULL;
+    UINT *puiKeys = NULL;
+    VOID **ppvKept = NULL;
+    UINT uiNum = 0;
+    UINT uiOrder = 0;
+    UINT uiMethod = 0;
+    UINT uiCount = 0;
+    UINT64 aullSum[3];
+    DOUBLE dBegin = 0;
+    DOUBLE adCost[3];
+    const CHAR *apcOrder[] = {"random", "ascending"};
+
+    ppvKept = (VOID **)malloc(sizeof(VOID *) * BENCH_TOPK);
+    if (NULL == ppvKept)
+    {
+        printf("malloc %u items failed\n", BENCH_TOPK);
+        exit(1);
+    }
+
+    printf("%-12s %12s %12s %12s %12s %12s %12s\n", "topk", "order", "items",
+           "rm-add ms", "pushpop ms", "offer ms", "same");
+    for (uiNum = BENCH_TOPK * 10; uiNum <= uiMax; uiNum *= 10)
+    {
+        puiKeys = bench_keys(uiNum);
+        for (uiOrder = 0; uiOrder < 2; uiOrder++)
+        {
+            if (1 == uiOrder)
+            {
+                for (uiCount = 0; uiCount < uiNum; uiCount++)
+                {
+                    puiKeys[uiCount] = uiCount;
+                }
+            }
+
+            for (uiMethod = 0; uiMethod < 2; uiMethod++)
+            {
+                pstHeap = HeapCreate(BENCH_TOPK, HEAP_MINI, compare, NULL, NULL);
+                dBegin = bench_now();
+                for (uiCount = 0; uiCount < uiNum; uiCount++)
+                {
+                    if (HeapNumber(pstHeap) < BENCH_TOPK)
+                    {
+                        (VOID)HeapAdd(pstHeap, &puiKeys[uiCount]);
+                    }
+                    else if (1 == uiMethod)
+                    {
+                        (VOID)HeapPushPop(pstHeap, &puiKeys[uiCount]);
+                    }
+                    else if (compare(&puiKeys[uiCount], HeapMin(pstHeap)) > 0)
+                    {
+                        (VOID)HeapRemoveRoot(pstHeap);
+                        (VOID)HeapAdd(pstHeap, &puiKeys[uiCount]);
+                    }
+                }
+                adCost[uiMethod] = (bench_now() - dBegin) * 1e3;
+
+                aullSum[uiMethod] = 0;
+                while (0 != HeapNumber(pstHeap))
+                {
+                    aullSum[uiMethod] += *(UINT *)HeapRemoveRoot(pstHeap);
+                }
+                HeapFree(pstHeap);
+            }
+
+            pstTopK = TopKCreate(BENCH_TOPK, TOPK_MAXI, compare, NULL, NULL);
+            dBegin = bench_now();
+            for (uiCount = 0; uiCount < uiNum; uiCount++)
+            {
+                (VOID)TopKOffer(pstTopK, &puiKeys[uiCount]);
+            }
+            adCost[2] = (bench_now() - dBegin) * 1e3;
+
+            aullSum[2] = 0;
+            uiCount = TopKDrainSorted(pstTopK, ppvKept);
+            while (uiCount > 0)
+            {
+                uiCount--;
+                aullSum[2] += *(UINT *)ppvKept[uiCount];
+            }
+            TopKFree(pstTopK);
+
+            printf("%-12s %12s %12u %12.2f %12.2f %12.2f %12s\n", "",
+                   apcOrder[uiOrder], uiNum, adCost[0], adCost[1], adCost[2],
+                   (aullSum[0] == aullSum[1] && aullSum[1] == aullSum[2]) ?
+                   "yes" : "no");
+        }
+        free(puiKeys);
+    }
+
+    free(ppvKept);
+
+    return;
+}
+
+/**sort n pointers to keys by qsort, HeapSort, and the first BENCH_TOPK of
+   them by HeapPartialSort, all through the same compare callback**/
+static VOID bench_sort(IN UINT uiMax)
+{
+    UINT *puiKeys = NULL;
+    VOID **ppvItems = NULL;
+    UINT uiNum = 0;
+    UINT uiMethod = 0;
+    UINT uiCount = 0;
+    UINT uiCheck = 0;
+    BOOL_T bSorted = BOOL_TRUE;
+    DOUBLE dBegin = 0;
+    DOUBLE adCost[3];
+
+    printf("%-12s %12s %12s %12s %12s %12s\n", "sort", "items", "qsort ms",
+           "heapsort ms", "partial ms", "sorted");
+    for (uiNum = 1000; uiNum <= uiMax; uiNum *= 10)
+    {
+        puiKeys = bench_keys(uiNum);
+        ppvItems = (VOID **)malloc(sizeof(VOID *) * uiNum);
+        if (NULL == ppvItems)
+        {
+            printf("malloc %u items failed\n", uiNum);
+            exit(1);
+        }
+
+        bSorted = BOOL_TRUE;
+        for (uiMethod = 0; uiMethod < 3; uiMethod++)
+        {
+            for (uiCount = 0; uiCount < uiNum; uiCount++)
+            {
+                ppvItems[uiCount] = &puiKeys[uiCount];
+            }
+
+            dBegin = bench_now();
+            if (0 == uiMethod)
+            {
+                qsort(ppvItems, uiNum, sizeof(VOID *), compare_qsort);
+            }
+            else if (1 == uiMethod)
+            {
+                (VOID)HeapSort(ppvItems, uiNum, compare);
+            }
+            else
+            {
+                (VOID)HeapPartialSort(ppvItems, uiNum, BENCH_TOPK, compare);
+            }
+            adCost[uiMethod] = (bench_now() - dBegin) * 1e3;
+
+            uiCheck = (2 == uiMethod && uiNum > BENCH_TOPK) ? BENCH_TOPK : uiNum;
+            for (uiCount = 1; uiCount < uiCheck; uiCount++)
+            {
+                if (compare(ppvItems[uiCount - 1], ppvItems[uiCount]) > 0)
+                {
+                    bSorted = BOOL_FALSE;
+                }
+            }
+        }
+
+        printf("%-12s %12u %12.2f %12.2f %12.2f %12s\n", "", uiNum, adCost[0],
+               adCost[1], adCost[2], (BOOL_TRUE == bSorted) ? "yes" : "no");
+
+        free(ppvItems);
+        free(puiKeys);
+    }
+
+    return;
+}
+
+/**BENCH_TICK timers of 1000 ~ 2000 ticks are added a tick, 9 of 10 are
+   cancelled 10 ticks later, as retransmit timers acked in time, the others
+   expire. HEAP_INDEXED heap cancels by handle, it's the best a heap can do**/
+static VOID bench_timers(IN UINT uiMax)
+{
+    BenchTimer_S *pstTimer = NULL;
+    Heap_S *pstHeap = NULL;
+    TimerWheel_S *pstWheel = NULL;
+    BenchTimer_S *pstRoot = NULL;
+    UINT uiNum = 0;
+    UINT uiMethod = 0;
+    UINT uiCount = 0;
+    UINT uiSize = 0;
+    UINT64 ullNow = 0;
+    UINT auiFired[2];
+    DOUBLE dBegin = 0;
+    DOUBLE adCost[2];
+
+    uiSize = BENCH_TICK * 2048;
+    printf("%-12s %12s %12s %12s %12s %12s\n", "timers", "timers",
+           "heap ns/op", "wheel ns/op", "expired", "same");
+    for (uiNum = BENCH_TICK * 10000; uiNum <= uiMax; uiNum *= 10)
+    {
+        pstTimer = (BenchTimer_S *)malloc(sizeof(BenchTimer_S) * uiNum);
+        if (NULL == pstTimer)
+        {
+            printf("malloc %u timers failed\n", uiNum);
+            exit(1);
+        }
+        srand(uiNum);
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            pstTimer[uiCount].ullExpire = uiCount / BENCH_TICK + 1000 +
+                                          (UINT)rand() % 1000;
+        }
+
+        for (uiMethod = 0; uiMethod < 2; uiMethod++)
+        {
+            pstHeap = HeapCreate(uiSize, HEAP_MINI | HEAP_INDEXED,
+                                 compare_timer, NULL, NULL);
+            pstWheel = TimerWheelCreate(uiSize, NULL, NULL, NULL);
+            auiFired[uiMethod] = 0;
+
+            dBegin = bench_now();
+            for (ullNow = 0; ullNow * BENCH_TICK < uiNum; ullNow++)
+            {
+                for (uiCount = ullNow * BENCH_TICK;
+                     uiCount < (ullNow + 1) * BENCH_TICK; uiCount++)
+                {
+                    if (0 == uiMethod)
+                    {
+                        (VOID)HeapAddHandle(pstHeap, &pstTimer[uiCount],
+                                            &pstTimer[uiCount].uiHandle);
+                    }
+                    else
+                    {
+                        (VOID)TimerWheelAdd(pstWheel,
+                                            pstTimer[uiCount].ullExpire - ullNow,
+                                            &pstTimer[uiCount],
+                                            &pstTimer[uiCount].uiHandle);
+                    }
+                }
+
+                for (uiCount = (ullNow >= 10) ? (ullNow - 10) * BENCH_TICK : 0;
+                     ullNow >= 10 && uiCount < (ullNow - 9) * BENCH_TICK;
+                     uiCount++)
+                {
+                    if (0 == uiCount % 10)
+                    {
+                        continue;
+                    }
+                    if (0 == uiMethod)
+                    {
+                        (VOID)HeapRemoveHandle(pstHeap,
+                                               pstTimer[uiCount].uiHandle);
+                    }
+                    else
+                    {
+                        (VOID)TimerWheelRemove(pstWheel,
+                                               pstTimer[uiCount].uiHandle);
+                    }
+                }
+
+                if (1 == uiMethod)
+                {
+                    auiFired[1] += TimerWheelAdvance(pstWheel, 1);
+                    continue;
+                }
+                pstRoot = (BenchTimer_S *)HeapMin(pstHeap);
+                while (NULL != pstRoot && pstRoot->ullExpire <= ullNow + 1)
+                {
+                    (VOID)HeapRemoveRoot(pstHeap);
+                    auiFired[0]++;
+                    pstRoot = (BenchTimer_S *)HeapMin(pstHeap);
+                }
+            }
+            adCost[uiMethod] = (bench_now() - dBegin) * 1e9 / uiNum;
+
+            HeapFree(pstHeap);
+            TimerWheelFree(pstWheel);
+        }
+
+        printf("%-12s %12u %12.1f %12.1f %12u %12s\n", "", uiNum, adCost[0],
+               adCost[1], auiFired[1],
+               (auiFired[0] == auiFired[1]) ? "yes" : "no");
+        free(pstTimer);
+    }
+
+    return;
+}
+
+/**n keys of about 0.6n distinct values are added unless already in heap,
+   then removed by key, a dedupe-before-insert pattern. Searching the whole
+   heap makes it O(n^2), the hash index makes it O(n log n)**/
+static VOID bench_heap_search(IN UINT uiMax)
+{
+    Heap_S *pstHeap = NULL;
+    UINT *puiKeys = NULL;
+    UINT uiNum = 0;
+    UINT uiMethod = 0;
+    UINT uiCount = 0;
+    UINT uiAdded = 0;
+    DOUBLE dBegin = 0;
+    DOUBLE adCost[2];
+
+    printf("%-12s %12s %12s %12s %12s\n", "heap_search", "keys", "distinct",
+           "scan ms", "hash ms");
+    for (uiNum = 1000; uiNum <= uiMax; uiNum *= 10)
+    {
+        puiKeys = bench_keys(uiNum);
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            puiKeys[uiCount] %= uiNum;
+        }
+
+        for (uiMethod = 0; uiMethod < 2; uiMethod++)
+        {
+            adCost[uiMethod] = -1;
+            if (0 == uiMethod && uiNum > BENCH_SCAN)
+            {
+                continue;
+            }
+
+            pstHeap = HeapCreate(16, HEAP_MINI, compare, NULL, NULL);
+            (VOID)HeapSetGrow(pstHeap, 0);
+            if (1 == uiMethod)
+            {
+                (VOID)HeapSetHash(pstHeap, hash);
+            }
+
+            dBegin = bench_now();
+            for (uiCount = 0; uiCount < uiNum; uiCount++)
+            {
+                if (NULL == HeapSearch(pstHeap, &puiKeys[uiCount]))
+                {
+                    (VOID)HeapAdd(pstHeap, &puiKeys[uiCount]);
+                }
+            }
+            uiAdded = HeapNumber(pstHeap);
+            for (uiCount = 0; uiCount < uiNum; uiCount++)
+            {
+                (VOID)HeapRemoveItem(pstHeap, &puiKeys[uiCount]);
+            }
+            adCost[uiMethod] = (bench_now() - dBegin) * 1e3;
+
+            if (0 != HeapNumber(pstHeap))
+            {
+                printf("%u items left\n", HeapNumber(pstHeap));
+            }
+            HeapFree(pstHeap);
+        }
+
+        if (adCost[0] < 0)
+        {
+            printf("%-12s %12u %12u %12s %12.2f\n", "", uiNum, uiAdded, "-",
+                   adCost[1]);
+        }
+        else
+        {
+            printf("%-12s %12u %12u %12.2f %12.2f\n", "", uiNum, uiAdded,
+                   adCost[0], adCost[1]);
+        }
+
+        free(puiKeys);
+    }
+
+    return;
+}
+
+/**a dispatcher drains BENCH_BATCH roots a round by HeapRemoveRoot one by one
+   or by a HeapRemoveRootN, then adds them back with later deadlines**/
+static VOID bench_heap_rootn(IN UINT uiMax)
+{
+    Heap_S *pstHeap = NULL;
+    UINT *puiKeys = NULL;
+    UINT uiNum = 0;
+    UINT uiMethod = 0;
+    UINT uiRound = 0;
+    UINT uiCount = 0;
+    UINT uiGot = 0;
+    DOUBLE dBegin = 0;
+    DOUBLE adCost[2];
+    VOID *apvItems[BENCH_BATCH];
+
+    printf("%-12s %12s %12s %12s\n", "heap_rootn", "items", "ns/pop",
+           "ns/pop(N)");
+    for (uiNum = 1000; uiNum <= uiMax; uiNum *= 10)
+    {
+        for (uiMethod = 0; uiMethod < 2; uiMethod++)
+        {
+            puiKeys = bench_keys(uiNum);
+            pstHeap = HeapCreate(uiNum, HEAP_MINI, compare, NULL, NULL);
+            for (uiCount = 0; uiCount < uiNum; uiCount++)
+            {
+                puiKeys[uiCount] >>= 8;
+                (VOID)HeapAdd(pstHeap, &puiKeys[uiCount]);
+            }
+
+            srand(uiNum);
+            dBegin = bench_now();
+            for (uiRound = 0; uiRound < BENCH_ROUNDS / BENCH_BATCH; uiRound++)
+            {
+                if (0 == uiMethod)
+                {
+                    for (uiGot = 0; uiGot < BENCH_BATCH; uiGot++)
+                    {
+                        apvItems[uiGot] = HeapRemoveRoot(pstHeap);
+                    }
+                }
+                else
+                {
+                    uiGot = HeapRemoveRootN(pstHeap, BENCH_BATCH, apvItems);
+                }
+
+                for (uiCount = 0; uiCount < uiGot; uiCount++)
+                {
+                    *(UINT *)apvItems[uiCount] += (UINT)rand() >> 7;
+                    (VOID)HeapAdd(pstHeap, apvItems[uiCount]);
+                }
+            }
+            adCost[uiMethod] = (bench_now() - dBegin) * 1e9 /
+                               (BENCH_ROUNDS / BENCH_BATCH * BENCH_BATCH);
+
+            HeapFree(pstHeap);
+            free(puiKeys);
+        }
+
+        printf("%-12s %12u %12.1f %12.1f\n", "", uiNum, adCost[0], adCost[1]);
+    }
+
+    return;
+}
+
+/**merge BENCH_SHARDS sorted runs, by a Heap_S of runs popping and adding
+   back the run of every item, or by a loser tree, in millions of items a
+   second**/
+static VOID bench_losertree(IN UINT uiMax)
+{
+    BenchRun_S astRun[BENCH_SHARDS];
+    VOID *apvRun[BENCH_SHARDS];
+    VOID *apvItems[BENCH_BATCH];
+    Heap_S *pstHeap = NULL;
+    LoserTree_S *pstTree = NULL;
+    BenchRun_S *pstRun = NULL;
+    UINT *puiKeys = NULL;
+    UINT uiNum = 0;
+    UINT uiPer = 0;
+    UINT uiRun = 0;
+    UINT uiMethod = 0;
+    UINT uiGot = 0;
+    UINT uiOut = 0;
+    UINT uiLast = 0;
+    BOOL_T bSorted = BOOL_TRUE;
+    DOUBLE dBegin = 0;
+    DOUBLE adRate[3];
+
+    printf("%-12s %12s %12s %12s %12s %12s\n", "losertree", "items",
+           "heap Mops", "tree Mops", "treeN Mops", "sorted");
+    for (uiNum = BENCH_SHARDS * 10; uiNum <= uiMax; uiNum *= 10)
+    {
+        uiPer = uiNum / BENCH_SHARDS;
+        puiKeys = bench_keys(uiNum);
+        for (uiRun = 0; uiRun < BENCH_SHARDS; uiRun++)
+        {
+            qsort(puiKeys + uiRun * uiPer, uiPer, sizeof(UINT), compare_key);
+        }
+
+        bSorted = BOOL_TRUE;
+        for (uiMethod = 0; uiMethod < 3; uiMethod++)
+        {
+            for (uiRun = 0; uiRun < BENCH_SHARDS; uiRun++)
+            {
+                astRun[uiRun].puiCur = puiKeys + uiRun * uiPer;
+                astRun[uiRun].puiEnd = astRun[uiRun].puiCur + uiPer;
+                apvRun[uiRun] = &astRun[uiRun];
+            }
+
+            uiOut = 0;
+            uiLast = 0;
+            dBegin = bench_now();
+            if (0 == uiMethod)
+            {
+                pstHeap = HeapCreate(BENCH_SHARDS, HEAP_MINI, compare_run,
+                                     NULL, NULL);
+                (VOID)HeapAddBatch(pstHeap, apvRun, BENCH_SHARDS);
+                while (0 != HeapNumber(pstHeap))
+                {
+                    pstRun = (BenchRun_S *)HeapRemoveRoot(pstHeap);
+                    bSorted &= (uiLast <= *pstRun->puiCur);
+                    uiLast = *pstRun->puiCur;
+                    uiOut++;
+                    if (++pstRun->puiCur != pstRun->puiEnd)
+                    {
+                        (VOID)HeapAdd(pstHeap, pstRun);
+                    }
+                }
+                HeapFree(pstHeap);
+            }
+            else
+            {
+                pstTree = LoserTreeCreate(apvRun, BENCH_SHARDS, bench_next,
+                                          compare);
+                do
+                {
+                    if (1 == uiMethod)
+                    {
+                        apvItems[0] = LoserTreeNext(pstTree);
+                        uiGot = (NULL == apvItems[0]) ? 0 : 1;
+                    }
+                    else
+                    {
+                        uiGot = LoserTreeNextN(pstTree, BENCH_BATCH, apvItems);
+                    }
+                    if (0 != uiGot)
+                    {
+                        bSorted &= (uiLast <= *(UINT *)apvItems[0]);
+                        uiLast = *(UINT *)apvItems[uiGot - 1];
+                    }
+                    uiOut += uiGot;
+                }while (0 != uiGot);
+                LoserTreeFree(pstTree);
+            }
+            adRate[uiMethod] = uiNum / (bench_now() - dBegin) / 1e6;
+            bSorted &= (uiOut == uiNum);
+        }
+
+        printf("%-12s %12u %12.1f %12.1f %12.1f %12s\n", "", uiNum, adRate[0],
+               adRate[1], adRate[2], (BOOL_TRUE == bSorted) ? "yes" : "no");
+
+        free(puiKeys);
+    }
+
+    return;
+}
+
+/**add n items to a heap then pop them all, by Heap_S of pointers and the
+   PF_COMPARE callback, or by HEAP_DEFINE heaps of values with the order
+   inlined, for UINT keys and for BenchPath_S structs**/
+static VOID bench_heapdef(IN UINT uiMax)
+{
+    Heap_S *pstHeap = NULL;
+    BenchUintHeap_S *pstUint = NULL;
+    BenchPathHeap_S *pstPath = NULL;
+    BenchPath_S *pstPaths = NULL;
+    BenchPath_S stPath;
+    UINT *puiKeys = NULL;
+    UINT uiNum = 0;
+    UINT uiCount = 0;
+    UINT uiKey = 0;
+    UINT uiLast = 0;
+    BOOL_T bSorted = BOOL_TRUE;
+    DOUBLE dBegin = 0;
+    DOUBLE adCost[4];
+
+    printf("%-12s %12s %12s %12s %12s %12s %12s\n", "heapdef", "items",
+           "uint ms", "uint def ms", "path ms", "path def ms", "sorted");
+    for (uiNum = 1000; uiNum <= uiMax; uiNum *= 10)
+    {
+        puiKeys = bench_keys(uiNum);
+        pstPaths = (BenchPath_S *)malloc(sizeof(BenchPath_S) * uiNum);
+        if (NULL == pstPaths)
+        {
+            printf("malloc %u paths failed\n", uiNum);
+            exit(1);
+        }
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            pstPaths[uiCount].ullDist = puiKeys[uiCount];
+            pstPaths[uiCount].uiVertex = uiCount;
+        }
+        bSorted = BOOL_TRUE;
+
+        pstHeap = HeapCreate(uiNum, HEAP_MINI, compare, NULL, NULL);
+        dBegin = bench_now();
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            (VOID)HeapAdd(pstHeap, &puiKeys[uiCount]);
+        }
+        while (0 != HeapNumber(pstHeap))
+        {
+            (VOID)HeapRemoveRoot(pstHeap);
+        }
+        adCost[0] = (bench_now() - dBegin) * 1e3;
+        HeapFree(pstHeap);
+
+        pstUint = BenchUintHeapCreate(uiNum);
+        dBegin = bench_now();
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            (VOID)BenchUintHeapAdd(pstUint, puiKeys[uiCount]);
+        }
+        uiLast = 0;
+        while (ERROR_SUCCESS == BenchUintHeapRemoveRoot(pstUint, &uiKey))
+        {
+            bSorted &= (uiLast <= uiKey);
+            uiLast = uiKey;
+        }
+        adCost[1] = (bench_now() - dBegin) * 1e3;
+        BenchUintHeapFree(pstUint);
+
+        pstHeap = HeapCreate(uiNum, HEAP_MINI, compare_path, NULL, NULL);
+        dBegin = bench_now();
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            (VOID)HeapAdd(pstHeap, &pstPaths[uiCount]);
+        }
+        while (0 != HeapNumber(pstHeap))
+        {
+            (VOID)HeapRemoveRoot(pstHeap);
+        }
+        adCost[2] = (bench_now() - dBegin) * 1e3;
+        HeapFree(pstHeap);
+
+        pstPath = BenchPathHeapCreate(uiNum);
+        dBegin = bench_now();
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            (VOID)BenchPathHeapAdd(pstPath, pstPaths[uiCount]);
+        }
+        uiLast = 0;
+        while (ERROR_SUCCESS == BenchPathHeapRemoveRoot(pstPath, &stPath))
+        {
+            bSorted &= (uiLast <= stPath.ullDist);
+            uiLast = (UINT)stPath.ullDist;
+        }
+        adCost[3] = (bench_now() - dBegin) * 1e3;
+        BenchPathHeapFree(pstPath);
+
+        printf("%-12s %12u %12.2f %12.2f %12.2f %12.2f %12s\n", "", uiNum,
+               adCost[0], adCost[1], adCost[2], adCost[3],
+               (BOOL_TRUE == bSorted) ? "yes" : "no");
+
+        free(pstPaths);
+        free(puiKeys);
+    }
+
+    return;
+}
+
+/**add n keys to an ordered list then look each one up, by SLHead_S of
+   pointers and the PF_COMPARE callback, or by a SLLIST_DEFINE list of
+   values with the order inlined**/
+static VOID bench_sllistdef(IN UINT uiMax)
+{
+    SLHead_S *pstHead = NULL;
+    BenchUintList_S *pstList = NULL;
+    UINT *puiKeys = NULL;
+    UINT uiNum = 0;
+    UINT uiCount = 0;
+    UINT uiKey = 0;
+    UINT uiFound = 0;
+    DOUBLE dBegin = 0;
+    DOUBLE adCost[2];
+
+    printf("%-12s %12s %12s %12s %12s\n", "sllistdef", "items", "list ms",
+           "list def ms", "found");
+    for (uiNum = 1000; uiNum <= uiMax; uiNum *= 10)
+    {
+        puiKeys = bench_keys(uiNum);
+        uiFound = 0;
+
+        pstHead = SLHeadCreate(LNKLST_MINORDER, compare, NULL, NULL);
+        dBegin = bench_now();
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            (VOID)SLHeadAdd(pstHead, &puiKeys[uiCount]);
+        }
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            uiFound += (NULL != SLHeadGetItem(pstHead, &puiKeys[uiCount]));
+        }
+        adCost[0] = (bench_now() - dBegin) * 1e3;
+        SLHeadFree(pstHead);
+
+        pstList = BenchUintListCreate();
+        dBegin = bench_now();
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            (VOID)BenchUintListAdd(pstList, puiKeys[uiCount]);
+        }
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            uiFound += (ERROR_SUCCESS == BenchUintListGetItem(pstList,
+                                                puiKeys[uiCount], &uiKey));
+        }
+        adCost[1] = (bench_now() - dBegin) * 1e3;
+        BenchUintListFree(pstList);
+
+        printf("%-12s %12u %12.2f %12.2f %12u\n", "", uiNum, adCost[0],
+               adCost[1], uiFound);
+
+        free(puiKeys);
+    }
+
+    return;
+}
+
+/**pop and push back the root of flat and HEAP_BLOCKED binary heaps, the
+   pages pay off only when the heap is far larger than the caches**/
+static VOID bench_heap_blocked(IN UINT uiMax)
+{
+    Heap_S *pstHeap = NULL;
+    UINT *puiKeys = NULL;
+    VOID **ppvItems = NULL;
+    VOID *pvItem = NULL;
+    UINT auiLayout[] = {0, HEAP_BLOCKED};
+    UINT auiNum[] = {1000, 1000000, 10000000, 100000000};
+    UINT uiLayout = 0;
+    UINT uiStep = 0;
+    UINT uiNum = 0;
+    UINT uiCount = 0;
+    DOUBLE dBegin = 0;
+    DOUBLE adCost[2];
+
+    printf("%-12s %12s %12s %12s\n", "heap_blocked", "items",
+           "flat ns", "blocked ns");
+    for (uiStep = 0; uiStep < sizeof(auiNum) / sizeof(UINT); uiStep++)
+    {
+        uiNum = auiNum[uiStep];
+        if (uiNum > uiMax)
+        {
+            break;
+        }
+
+        puiKeys = bench_keys(uiNum);
+        ppvItems = (VOID **)malloc(sizeof(VOID *) * uiNum);
+        if (NULL == ppvItems)
+        {
+            free(puiKeys);
+            return;
+        }
+
+        for (uiLayout = 0; uiLayout < 2; uiLayout++)
+        {
+            for (uiCount = 0; uiCount < uiNum; uiCount++)
+            {
+                ppvItems[uiCount] = &puiKeys[uiCount];
+            }
+            pstHeap = HeapCreateFromArray(ppvItems, uiNum, uiNum,
+                                          HEAP_MINI | auiLayout[uiLayout],
+                                          compare, NULL, NULL);
+            if (NULL == pstHeap)
+            {
+                printf("create heap of %u items failed\n", uiNum);
+                break;
+            }
+
+            dBegin = bench_now();
+            for (uiCount = 0; uiCount < BENCH_ROUNDS; uiCount++)
+            {
+                pvItem = HeapRemoveRoot(pstHeap);
+                *(UINT *)pvItem += uiNum;
+                (VOID)HeapAdd(pstHeap, pvItem);
+            }
+            adCost[uiLayout] = (bench_now() - dBegin) * 1e9 / BENCH_ROUNDS;
+
+            HeapFree(pstHeap);
+        }
+
+        if (2 == uiLayout)
+        {
+            printf("%-12s %12u %12.1f %12.1f\n", "", uiNum,
+                   adCost[0], adCost[1]);
+        }
+
+        free(ppvItems);
+        free(puiKeys);
+    }
+
+    return;
+}
+
+/**add all keys then remove them all, by a heap in memery and by an extheap
+   given 1/BENCH_EXTMEM of the bytes of the keys, in ns per key**/
+static VOID bench_extheap(IN UINT uiMax)
+{
+    Heap_S *pstHeap = NULL;
+    ExtHeap_S *pstExt = NULL;
+    UINT *puiKeys = NULL;
+    UINT auiNum[] = {1000000, 10000000, 100000000};
+    UINT uiStep = 0;
+    UINT uiNum = 0;
+    UINT uiCount = 0;
+    UINT uiKey = 0;
+    UINT uiRuns = 0;
+    DOUBLE dBegin = 0;
+    DOUBLE dHeap = 0;
+    DOUBLE dExt = 0;
+
+    printf("%-12s %12s %12s %12s %12s\n", "extheap", "items",
+           "heap ns", "extheap ns", "runs");
+    for (uiStep = 0; uiStep < sizeof(auiNum) / sizeof(UINT); uiStep++)
+    {
+        uiNum = auiNum[uiStep];
+        if (uiNum > uiMax)
+        {
+            break;
+        }
+
+        puiKeys = bench_keys(uiNum);
+        pstHeap = HeapCreate(uiNum, HEAP_MINI, compare, NULL, NULL);
+        pstExt = ExtHeapCreate(sizeof(UINT),
+                               sizeof(UINT) * (ULONG)uiNum / BENCH_EXTMEM,
+                               NULL, compare);
+        if (NULL == pstHeap || NULL == pstExt)
+        {
+            printf("create heaps of %u items failed\n", uiNum);
+            HeapFree(pstHeap);
+            ExtHeapFree(pstExt);
+            free(puiKeys);
+            return;
+        }
+
+        dBegin = bench_now();
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            (VOID)HeapAdd(pstHeap, &puiKeys[uiCount]);
+        }
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            (VOID)HeapRemoveRoot(pstHeap);
+        }
+        dHeap = (bench_now() - dBegin) * 1e9 / uiNum;
+
+        dBegin = bench_now();
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            if (ERROR_SUCCESS != ExtHeapAdd(pstExt, &puiKeys[uiCount]))
+            {
+                printf("spill failed\n");
+                break;
+            }
+        }
+        uiRuns = ExtHeapRuns(pstExt);
+        while (ERROR_SUCCESS == ExtHeapRemoveRoot(pstExt, &uiKey))
+        {
+        }
+        dExt = (bench_now() - dBegin) * 1e9 / uiNum;
+
+        printf("%-12s %12u %12.1f %12.1f %12u\n", "", uiNum,
+               dHeap, dExt, uiRuns);
+
+        HeapFree(pstHeap);
+        ExtHeapFree(pstExt);
+        free(puiKeys);
+    }
+
+    return;
+}
+
+/**whether the item belongs to the tenant evicted**/
+static BOOL_T bench_evicted(IN VOID *pvItem, IN VOID *pvCtx)
+{
+    return (*(UINT *)pvItem % 10 < *(UINT *)pvCtx) ? BOOL_TRUE : BOOL_FALSE;
+}
+
+/**evict BENCH_EVICT tenths of a heap by HeapRemoveItem one by one and by
+   HeapRemoveIf at once**/
+static VOID bench_heap_evict(IN UINT uiMax)
+{
+    Heap_S *pstHeap = NULL;
+    UINT *puiKeys = NULL;
+    VOID **ppvItems = NULL;
+    UINT uiEvict = BENCH_EVICT;
+    UINT uiNum = 0;
+    UINT uiMethod = 0;
+    UINT uiCount = 0;
+    UINT uiLeft = 0;
+    DOUBLE dBegin = 0;
+    DOUBLE adCost[2];
+
+    printf("%-12s %12s %12s %12s %12s\n", "heap_evict", "items", "left",
+           "item ms", "if ms");
+    for (uiNum = 1000; uiNum <= uiMax; uiNum *= 10)
+    {
+        puiKeys = bench_keys(uiNum);
+        ppvItems = (VOID **)malloc(sizeof(VOID *) * uiNum);
+        if (NULL == ppvItems)
+        {
+            free(puiKeys);
+            return;
+        }
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            ppvItems[uiCount] = &puiKeys[uiCount];
+        }
+
+        for (uiMethod = 0; uiMethod < 2; uiMethod++)
+        {
+            adCost[uiMethod] = -1;
+            if (0 == uiMethod && uiNum > BENCH_SCAN)
+            {
+                continue;
+            }
+
+            pstHeap = HeapCreateFromArray(ppvItems, uiNum, uiNum, HEAP_MINI,
+                                          compare, NULL, NULL);
+            if (NULL == pstHeap)
+            {
+                printf("create heap of %u items failed\n", uiNum);
+                break;
+            }
+
+            dBegin = bench_now();
+            if (0 == uiMethod)
+            {
+                for (uiCount = 0; uiCount < uiNum; uiCount++)
+                {
+                    if (BOOL_TRUE == bench_evicted(&puiKeys[uiCount],
+                                                   &uiEvict))
+                    {
+                        (VOID)HeapRemoveItem(pstHeap, &puiKeys[uiCount]);
+                    }
+                }
+            }
+            else
+            {
+                (VOID)HeapRemoveIf(pstHeap, bench_evicted, &uiEvict, NULL);
+            }
+            adCost[uiMethod] = (bench_now() - dBegin) * 1e3;
+
+            uiLeft = HeapNumber(pstHeap);
+            HeapFree(pstHeap);
+        }
+
+        if (adCost[0] < 0)
+        {
+            printf("%-12s %12u %12u %12s %12.2f\n", "", uiNum, uiLeft, "-",
+                   adCost[1]);
+        }
+        else
+        {
+            printf("%-12s %12u %12u %12.2f %12.2f\n", "", uiNum, uiLeft,
+                   adCost[0], adCost[1]);
+        }
+
+        free(ppvItems);
+        free(puiKeys);
+    }
+
+    return;
+}
+
+/**push all keys and pop them all from a fixed, a growable and a chunked
+   stack, then push and pop at the edge of a chunk, in ns per item**/
+static VOID bench_stack_chunk(IN UINT uiMax)
+{
+    Stack_S *pstStack = NULL;
+    UINT *puiKeys = NULL;
+    UINT uiKind = 0;
+    UINT uiCount = 0;
+    UINT uiEdge = 0;
+    DOUBLE dBegin = 0;
+    DOUBLE dStart = 0;
+    DOUBLE dCost = 0;
+    DOUBLE dWorst = 0;
+    DOUBLE dPop = 0;
+    DOUBLE dEdge = 0;
+    CHAR *apcName[] = {"fixed", "grow", "chunked"};
+
+    puiKeys = bench_keys(uiMax);
+
+    printf("%-12s %12s %12s %12s %12s %12s\n", "stack_chunk", "kind",
+           "push ns", "worst ns", "pop ns", "edge ns");
+    for (uiKind = 0; uiKind < 3; uiKind++)
+    {
+        if (0 == uiKind)
+        {
+            pstStack = StackCreate(uiMax + 1, NULL, NULL);
+        }
+        else if (1 == uiKind)
+        {
+            pstStack = StackCreate(16, NULL, NULL);
+            (VOID)StackSetGrow(pstStack, 0);
+        }
+        else
+        {
+            pstStack = StackCreateChunked(BENCH_CHUNK, NULL, NULL);
+        }
+        if (NULL == pstStack)
+        {
+            printf("create %s stack failed\n", apcName[uiKind]);
+            break;
+        }
+
+        dWorst = 0;
+        dStart = bench_now();
+        for (uiCount = 0; uiCount < uiMax; uiCount++)
+        {
+            dBegin = bench_now();
+            (VOID)StackPush(pstStack, &puiKeys[uiCount]);
+            dCost = bench_now() - dBegin;
+            if (dCost > dWorst)
+            {
+                dWorst = dCost;
+            }
+        }
+        dCost = (bench_now() - dStart) * 1e9 / uiMax;
+
+        dBegin = bench_now();
+        for (uiCount = 0; uiCount < uiMax; uiCount++)
+        {
+            (VOID)StackPop(pstStack);
+        }
+        dPop = (bench_now() - dBegin) * 1e9 / uiMax;
+
+        /**fill to the edge of a chunk, then cross it back and forth**/
+        uiEdge = (uiMax < BENCH_CHUNK) ? uiMax : BENCH_CHUNK;
+        for (uiCount = 0; uiCount < uiEdge; uiCount++)
+        {
+            (VOID)StackPush(pstStack, &puiKeys[uiCount]);
+        }
+        dBegin = bench_now();
+        for (uiCount = 0; uiCount < BENCH_ROUNDS; uiCount++)
+        {
+            (VOID)StackPush(pstStack, &puiKeys[0]);
+            (VOID)StackPush(pstStack, &puiKeys[0]);
+            (VOID)StackPop(pstStack);
+            (VOID)StackPop(pstStack);
+        }
+        dEdge = (bench_now() - dBegin) * 1e9 / (4 * BENCH_ROUNDS);
+
+        printf("%-12s %12s %12.1f %12.1f %12.1f %12.1f\n", "",
+               apcName[uiKind], dCost, dWorst * 1e9, dPop, dEdge);
+
+        StackFree(pstStack);
+    }
+
+    free(puiKeys);
+
+    return;
+}
+
+static VOID* bench_stack_worker(IN VOID *pvArg)
+{
+    BenchStackWorker_S *pstWorker = (BenchStackWorker_S *)pvArg;
+    VOID *pvItem = NULL;
+    UINT uiCount = 0;
+    BOOL_T bPush = BOOL_FALSE;
+
+    for (uiCount = 0; uiCount < pstWorker->uiOps; uiCount++)
+    {
+        bPush = (uiCount % 10 < pstWorker->uiPush) ? BOOL_TRUE : BOOL_FALSE;
+        pvItem = &pstWorker->puiKeys[uiCount % BENCH_ROUNDS];
+        if (NULL != pstWorker->pstLFStack)
+        {
+            if (BOOL_TRUE == bPush)
+            {
+                (VOID)LFStackPush(pstWorker->pstLFStack, pvItem);
+            }
+            else
+            {
+                (VOID)LFStackPop(pstWorker->pstLFStack);
+            }
+            continue;
+        }
+
+        pthread_mutex_lock(pstWorker->pstMutex);
+        if (BOOL_TRUE == bPush)
+        {
+            (VOID)StackPush(pstWorker->pstStack, pvItem);
+        }
+        else
+        {
+            (VOID)StackPop(pstWorker->pstStack);
+        }
+        pthread_mutex_unlock(pstWorker->pstMutex);
+    }
+
+    return NULL;
+}
+
+/**threads push and pop a shared stack at 50%, 80% and 20% pushes, one stack
+   under a mutex against the lock-free one, both prefilled with BENCH_ROUNDS
+   items and large enough never to be full. The threads can't contend for
+   the head in parallel on a machine of less cores**/
+static VOID bench_lfstack(IN UINT uiMax)
+{
+    BenchStackWorker_S astWorker[64];
+    pthread_t astThread[64];
+    pthread_mutex_t stMutex;
+    LFStack_S *pstLFStack = NULL;
+    Stack_S *pstStack = NULL;
+    UINT *puiKeys = NULL;
+    UINT auiPush[] = {5, 8, 2};
+    UINT uiThreads = 0;
+    UINT uiRatio = 0;
+    UINT uiSize = 0;
+    UINT uiCount = 0;
+    UINT uiMethod = 0;
+    DOUBLE dBegin = 0;
+    DOUBLE adMops[2];
+
+    if (uiMax > 64)
+    {
+        uiMax = 64;
+    }
+
+    pthread_mutex_init(&stMutex, NULL);
+    puiKeys = bench_keys(BENCH_ROUNDS);
+    printf("%-12s %12s %12s %12s %12s\n", "lfstack", "threads", "push %",
+           "mutex Mops", "lf Mops");
+    for (uiThreads = 1; uiThreads <= uiMax; uiThreads *= 2)
+    {
+        for (uiRatio = 0; uiRatio < sizeof(auiPush) / sizeof(UINT); uiRatio++)
+        {
+            uiSize = BENCH_ROUNDS * (uiThreads + 1);
+            for (uiMethod = 0; uiMethod < 2; uiMethod++)
+            {
+                pstStack = NULL;
+                pstLFStack = NULL;
+                if (0 == uiMethod)
+                {
+                    pstStack = StackCreate(uiSize, NULL, NULL);
+                }
+                else
+                {
+                    pstLFStack = LFStackCreate(uiSize, NULL, NULL);
+                }
+                for (uiCount = 0; uiCount < BENCH_ROUNDS; uiCount++)
+                {
+                    (VOID)((NULL != pstStack) ?
+                           StackPush(pstStack, &puiKeys[uiCount]) :
+                           LFStackPush(pstLFStack, &puiKeys[uiCount]));
+                }
+
+                dBegin = bench_now();
+                for (uiCount = 0; uiCount < uiThreads; uiCount++)
+                {
+                    astWorker[uiCount].pstLFStack = pstLFStack;
+                    astWorker[uiCount].pstStack = pstStack;
+                    astWorker[uiCount].pstMutex = &stMutex;
+                    astWorker[uiCount].puiKeys = puiKeys;
+                    astWorker[uiCount].uiOps = BENCH_ROUNDS;
+                    astWorker[uiCount].uiPush = auiPush[uiRatio];
+                    pthread_create(&astThread[uiCount], NULL,
+                                   bench_stack_worker, &astWorker[uiCount]);
+                }
+                for (uiCount = 0; uiCount < uiThreads; uiCount++)
+                {
+                    pthread_join(astThread[uiCount], NULL);
+                }
+                adMops[uiMethod] = (DOUBLE)BENCH_ROUNDS * uiThreads /
+                                   (bench_now() - dBegin) / 1e6;
+
+                StackFree(pstStack);
+                LFStackFree(pstLFStack);
+            }
+
+            printf("%-12s %12u %12u %12.2f %12.2f\n", "", uiThreads,
+                   auiPush[uiRatio] * 10, adMops[0], adMops[1]);
+        }
+    }
+
+    pthread_mutex_destroy(&stMutex);
+    free(puiKeys);
+
+    return;
+}
+
+/**threads push and pop the lock-free stack in balanced bursts, plain against
+   an elimination array of a slot for every 2 threads, at 8, 32 and 96
+   threads up to uiMax. The elimination pays only if the threads contend for
+   the top in parallel, which needs as many cores**/
+static VOID bench_lfstack_elim(IN UINT uiMax)
+{
+    BenchStackWorker_S astWorker[128];
+    pthread_t astThread[128];
+    LFStack_S *pstStack = NULL;
+    UINT *puiKeys = NULL;
+    UINT auiThreads[] = {8, 32, 96};
+    UINT uiThreads = 0;
+    UINT uiStep = 0;
+    UINT uiCount = 0;
+    UINT uiMethod = 0;
+    DOUBLE dBegin = 0;
+    DOUBLE adMops[2];
+
+    puiKeys = bench_keys(BENCH_ROUNDS);
+    printf("%-12s %12s %12s %12s\n", "lfstack_elim", "threads", "plain Mops",
+           "elim Mops");
+    for (uiStep = 0; uiStep < sizeof(auiThreads) / sizeof(UINT); uiStep++)
+    {
+        uiThreads = auiThreads[uiStep];
+        if (uiThreads > uiMax || uiThreads > 128)
+        {
+            break;
+        }
+
+        for (uiMethod = 0; uiMethod < 2; uiMethod++)
+        {
+            pstStack = LFStackCreate(BENCH_ROUNDS * (uiThreads + 1), NULL,
+                                     NULL);
+            if (1 == uiMethod)
+            {
+                (VOID)LFStackSetEliminate(pstStack, (uiThreads + 1) / 2);
+            }
+            for (uiCount = 0; uiCount < BENCH_ROUNDS; uiCount++)
+            {
+                (VOID)LFStackPush(pstStack, &puiKeys[uiCount]);
+            }
+
+            dBegin = bench_now();
+            for (uiCount = 0; uiCount < uiThreads; uiCount++)
+            {
+                astWorker[uiCount].pstLFStack = pstStack;
+                astWorker[uiCount].pstStack = NULL;
+                astWorker[uiCount].pstMutex = NULL;
+                astWorker[uiCount].puiKeys = puiKeys;
+                astWorker[uiCount].uiOps = BENCH_ROUNDS;
+                astWorker[uiCount].uiPush = 5;
+                pthread_create(&astThread[uiCount], NULL, bench_stack_worker,
+                               &astWorker[uiCount]);
+            }
+            for (uiCount = 0; uiCount < uiThreads; uiCount++)
+            {
+                pthread_join(astThread[uiCount], NULL);
+            }
+            adMops[uiMethod] = (DOUBLE)BENCH_ROUNDS * uiThreads /
+                               (bench_now() - dBegin) / 1e6;
+
+            LFStackFree(pstStack);
+        }
+
+        printf("%-12s %12u %12.2f %12.2f\n", "", uiThreads, adMops[0],
+               adMops[1]);
+    }
+
+    free(puiKeys);
+
+    return;
+}
+
+/**move uiMax items through a stack and a queue in batches, by an item a call
+   against a batch a call, the time is of a push and a pop of an item**/
+static VOID bench_bulk(IN UINT uiMax)
+{
+    Stack_S *pstStack = NULL;
+    Queue_S *pstQueue = NULL;
+    VOID **ppvBatch = NULL;
+    UINT *puiKeys = NULL;
+    UINT auiBatch[] = {64, 256, 1024};
+    UINT uiBatch = 0;
+    UINT uiStep = 0;
+    UINT uiRound = 0;
+    UINT uiCount = 0;
+    DOUBLE dBegin = 0;
+    DOUBLE adNs[4];
+
+    puiKeys = bench_keys(1024);
+    ppvBatch = (VOID **)malloc(sizeof(VOID *) * 1024);
+    pstStack = StackCreate(1024, NULL, NULL);
+    pstQueue = QueueCreate(1024, NULL, NULL);
+    if (NULL == ppvBatch || NULL == pstStack || NULL == pstQueue)
+    {
+        printf("create bulk stack or queue failed\n");
+        free(puiKeys);
+        free(ppvBatch);
+        StackFree(pstStack);
+        QueueFree(pstQueue);
+        return;
+    }
+    for (uiCount = 0; uiCount < 1024; uiCount++)
+    {
+        ppvBatch[uiCount] = &puiKeys[uiCount];
+    }
+
+    printf("%-12s %12s %12s %12s %12s %12s\n", "bulk", "batch",
+           "stack 1 ns", "stack N ns", "queue 1 ns", "queue N ns");
+    for (uiStep = 0; uiStep < sizeof(auiBatch) / sizeof(UINT); uiStep++)
+    {
+        uiBatch = auiBatch[uiStep];
+
+        /**the head is moved off the start, so the batches wrap**/
+        (VOID)QueueAddN(pstQueue, ppvBatch, 512 - uiBatch / 2);
+        (VOID)QueueRemoveN(pstQueue, 512 - uiBatch / 2, ppvBatch);
+
+        dBegin = bench_now();
+        for (uiRound = 0; uiRound < uiMax / uiBatch; uiRound++)
+        {
+            for (uiCount = 0; uiCount < uiBatch; uiCount++)
+            {
+                (VOID)StackPush(pstStack, ppvBatch[uiCount]);
+            }
+            for (uiCount = 0; uiCount < uiBatch; uiCount++)
+            {
+                ppvBatch[uiBatch - 1 - uiCount] = StackPop(pstStack);
+            }
+        }
+        adNs[0] = (bench_now() - dBegin) * 1e9 / (uiRound * uiBatch);
+
+        dBegin = bench_now();
+        for (uiRound = 0; uiRound < uiMax / uiBatch; uiRound++)
+        {
+            (VOID)StackPushN(pstStack, ppvBatch, uiBatch);
+            (VOID)StackPopN(pstStack, uiBatch, ppvBatch);
+        }
+        adNs[1] = (bench_now() - dBegin) * 1e9 / (uiRound * uiBatch);
+
+        dBegin = bench_now();
+        for (uiRound = 0; uiRound < uiMax / uiBatch; uiRound++)
+        {
+            for (uiCount = 0; uiCount < uiBatch; uiCount++)
+            {
+                (VOID)QueueAdd(pstQueue, ppvBatch[uiCount]);
+            }
+            for (uiCount = 0; uiCount < uiBatch; uiCount++)
+            {
+                ppvBatch[uiCount] = QueueRemoveFirst(pstQueue);
+            }
+        }
+        adNs[2] = (bench_now() - dBegin) * 1e9 / (uiRound * uiBatch);
+
+        dBegin = bench_now();
+        for (uiRound = 0; uiRound < uiMax / uiBatch; uiRound++)
+        {
+            (VOID)QueueAddN(pstQueue, ppvBatch, uiBatch);
+            (VOID)QueueRemoveN(pstQueue, uiBatch, ppvBatch);
+        }
+        adNs[3] = (bench_now() - dBegin) * 1e9 / (uiRound * uiBatch);
+
+        printf("%-12s %12u %12.2f %12.2f %12.2f %12.2f\n", "", uiBatch,
+               adNs[0], adNs[1], adNs[2], adNs[3]);
+    }
+
+    StackFree(pstStack);
+    QueueFree(pstQueue);
+    free(ppvBatch);
+    free(puiKeys);
+
+    return;
+}
+
+/**pass uiMax messages through a stack and a queue BENCH_BATCH at a time, a
+   message malloced and freed against one copied in and out of a slot**/
+static VOID bench_value(IN UINT uiMax)
+{
+    Stack_S *apstStack[2];
+    Queue_S *apstQueue[2];
+    BenchMsg_S stMsg;
+    BenchMsg_S *pstMsg = NULL;
+    UINT uiRound = 0;
+    UINT uiCount = 0;
+    UINT uiMethod = 0;
+    DOUBLE dBegin = 0;
+    DOUBLE adNs[4];
+
+    apstStack[0] = StackCreate(BENCH_BATCH, NULL, NULL);
+    apstStack[1] = StackCreateValue(BENCH_BATCH, sizeof(BenchMsg_S), NULL,
+                                    NULL);
+    apstQueue[0] = QueueCreate(BENCH_BATCH, NULL, NULL);
+    apstQueue[1] = QueueCreateValue(BENCH_BATCH, sizeof(BenchMsg_S), NULL,
+                                    NULL);
+    memset(&stMsg, 0, sizeof(BenchMsg_S));
+
+    for (uiMethod = 0; uiMethod < 2; uiMethod++)
+    {
+        dBegin = bench_now();
+        for (uiRound = 0; uiRound < uiMax / BENCH_BATCH; uiRound++)
+        {
+            for (uiCount = 0; uiCount < BENCH_BATCH; uiCount++)
+            {
+                stMsg.ullId = uiCount;
+                pstMsg = &stMsg;
+                if (0 == uiMethod)
+                {
+                    pstMsg = (BenchMsg_S *)malloc(sizeof(BenchMsg_S));
+                    *pstMsg = stMsg;
+                }
+                (VOID)StackPush(apstStack[uiMethod], pstMsg);
+            }
+            for (uiCount = 0; uiCount < BENCH_BATCH; uiCount++)
+            {
+                pstMsg = (BenchMsg_S *)StackPop(apstStack[uiMethod]);
+                if (0 == uiMethod)
+                {
+                    free(pstMsg);
+                }
+            }
+        }
+        adNs[uiMethod] = (bench_now() - dBegin) * 1e9 /
+                         (uiRound * BENCH_BATCH);
+
+        dBegin = bench_now();
+        for (uiRound = 0; uiRound < uiMax / BENCH_BATCH; uiRound++)
+        {
+            for (uiCount = 0; uiCount < BENCH_BATCH; uiCount++)
+            {
+                stMsg.ullId = uiCount;
+                pstMsg = &stMsg;
+                if (0 == uiMethod)
+                {
+                    pstMsg = (BenchMsg_S *)malloc(sizeof(BenchMsg_S));
+                    *pstMsg = stMsg;
+                }
+                (VOID)QueueAdd(apstQueue[uiMethod], pstMsg);
+            }
+            for (uiCount = 0; uiCount < BENCH_BATCH; uiCount++)
+            {
+                pstMsg = (BenchMsg_S *)QueueRemoveFirst(apstQueue[uiMethod]);
+                if (0 == uiMethod)
+                {
+                    free(pstMsg);
+                }
+            }
+        }
+        adNs[2 + uiMethod] = (bench_now() - dBegin) * 1e9 /
+                             (uiRound * BENCH_BATCH);
+    }
+
+    printf("%-12s %12s %12s %12s %12s\n", "value", "stack ptr ns",
+           "stack val ns", "queue ptr ns", "queue val ns");
+    printf("%-12s %12.2f %12.2f %12.2f %12.2f\n", "", adNs[0], adNs[1],
+           adNs[2], adNs[3]);
+
+    for (uiMethod = 0; uiMethod < 2; uiMethod++)
+    {
+        StackFree(apstStack[uiMethod]);
+        QueueFree(apstQueue[uiMethod]);
+    }
+
+    return;
+}
+
+/**point a batch at the keys in a row**/
+static VOID bench_batch(OUT VOID **ppvItems, IN UINT *puiKeys,
+                        IN UINT uiNum)
+{
+    UINT uiCount = 0;
+
+    for (uiCount = 0; uiCount < uiNum; uiCount++)
+    {
+        ppvItems[uiCount] = &puiKeys[uiCount];
+    }
+
+    return;
+}
+
+/**fill growable heap, stack and queue from 16 slots, one by one and by
+   batches, the slow adds show whether any add stalls for copying the whole
+   structure**/
+static VOID bench_grow(IN UINT uiMax)
+{
+    Heap_S *pstHeap = NULL;
+    Heap_S *pstBatch = NULL;
+    Stack_S *pstStack = NULL;
+    Stack_S *pstStackN = NULL;
+    Queue_S *pstQueue = NULL;
+    Queue_S *pstQueueN = NULL;
+    UINT *puiKeys = NULL;
+    UINT uiKind = 0;
+    UINT uiCount = 0;
+    UINT uiStep = 0;
+    UINT uiSlow = 0;
+    ULONG ulRet = ERROR_SUCCESS;
+    DOUBLE dBegin = 0;
+    DOUBLE dStart = 0;
+    DOUBLE dCost = 0;
+    DOUBLE dWorst = 0;
+    VOID *apvItems[BENCH_GROWN];
+    CHAR *apcName[] = {"heap", "stack", "queue", "heap batch", "stack batch",
+                       "queue batch"};
+
+    puiKeys = bench_keys(uiMax);
+    pstHeap = HeapCreate(16, HEAP_MINI, compare, NULL, NULL);
+    pstBatch = HeapCreate(16, HEAP_MINI, compare, NULL, NULL);
+    pstStack = StackCreate(16, NULL, NULL);
+    pstStackN = StackCreate(16, NULL, NULL);
+    pstQueue = QueueCreate(16, NULL, NULL);
+    pstQueueN = QueueCreate(16, NULL, NULL);
+    if (NULL == pstHeap || NULL == pstBatch || NULL == pstStack ||
+        NULL == pstStackN || NULL == pstQueue || NULL == pstQueueN)
+    {
+        HeapFree(pstHeap);
+        HeapFree(pstBatch);
+        StackFree(pstStack);
+        StackFree(pstStackN);
+        QueueFree(pstQueue);
+        QueueFree(pstQueueN);
+        free(puiKeys);
+        return;
+    }
+    (VOID)HeapSetGrow(pstHeap, 0);
+    (VOID)HeapSetGrow(pstBatch, 0);
+    (VOID)StackSetGrow(pstStack, 0);
+    (VOID)StackSetGrow(pstStackN, 0);
+    (VOID)QueueSetGrow(pstQueue, 0);
+    (VOID)QueueSetGrow(pstQueueN, 0);
+
+    printf("%-12s %12s %12s %12s %12s %12s\n", "grow", "kind", "items",
+           "avg ns", "worst ns", "adds >10us");
+    for (uiKind = 0; uiKind < 6; uiKind++)
+    {
+        dWorst = 0;
+        uiSlow = 0;
+        uiStep = (uiKind < 3) ? 1 : BENCH_GROWN;
+        dStart = bench_now();
+        for (uiCount = 0; uiCount + uiStep <= uiMax; uiCount += uiStep)
+        {
+            bench_batch(apvItems, &puiKeys[uiCount], uiStep);
+            dBegin = bench_now();
+            if (0 == uiKind)
+            {
+                ulRet = HeapAdd(pstHeap, &puiKeys[uiCount]);
+            }
+            else if (1 == uiKind)
+            {
+                ulRet = StackPush(pstStack, &puiKeys[uiCount]);
+            }
+            else if (2 == uiKind)
+            {
+                ulRet = QueueAdd(pstQueue, &puiKeys[uiCount]);
+            }
+            else if (3 == uiKind)
+            {
+                ulRet = HeapAddBatch(pstBatch, apvItems, uiStep);
+            }
+            else if (4 == uiKind)
+            {
+                ulRet = (uiStep == StackPushN(pstStackN, apvItems, uiStep)) ?
+                        ERROR_SUCCESS : ERROR_FAILED;
+            }
+            else
+            {
+                ulRet = (uiStep == QueueAddN(pstQueueN, apvItems, uiStep)) ?
+                        ERROR_SUCCESS : ERROR_FAILED;
+            }
+            dCost = bench_now() - dBegin;
+            if (dCost > dWorst)
+            {
+                dWorst = dCost;
+            }
+            if (dCost > 10e-6)
+            {
+                uiSlow++;
+            }
+            if (ERROR_SUCCESS != ulRet)
+            {
+                printf("add %u items failed\n", uiCount);
+                break;
+            }
+        }
+        dCost = (bench_now() - dStart) * 1e9 / uiMax;
+
+        printf("%-12s %12s %12u %12.1f %12.1f %12u\n", "", apcName[uiKind],
+               uiMax, dCost, dWorst * 1e9, uiSlow);
+    }
+
+    HeapFree(pstHeap);
+    HeapFree(pstBatch);
+    StackFree(pstStack);
+    StackFree(pstStackN);
+    QueueFree(pstQueue);
+    QueueFree(pstQueueN);
+    free(puiKeys);
+
+    return;
+}
+
+static Bench_S g_astBench[] =
+{
+    {"heap_pop", bench_heap_pop, 1000000},
+    {"heap_build", bench_heap_build, 1000000},
+    {"heap_update", bench_heap_update, 1000000},
+    {"heap_arity", bench_heap_arity, 1000000},
+    {"heap_minmax", bench_heap_minmax, 1000000},
+    {"keyheap", bench_keyheap, 1000000},
+    {"dijkstra", bench_dijkstra, 1000000},
+    {"merge", bench_merge, 1000000},
+    {"mq_threads", bench_mq_threads, 64},
+    {"mq_rank", bench_mq_rank, 1000000},
+    {"topk", bench_topk, 10000000},
+    {"sort", bench_sort, 10000000},
+    {"timers", bench_timers, 10000000},
+    {"heap_search", bench_heap_search, 1000000},
+    {"heap_rootn", bench_heap_rootn, 1000000},
+    {"losertree", bench_losertree, 10000000},
+    {"heapdef", bench_heapdef, 1000000},
+    {"sllistdef", bench_sllistdef, 10000},
+    {"heap_blocked", bench_heap_blocked, 10000000},
+    {"extheap", bench_extheap, 10000000},
+    {"heap_evict", bench_heap_evict, 10000000},
+    {"stack_chunk", bench_stack_chunk, 10000000},
+    {"lfstack", bench_lfstack, 8},
+    {"lfstack_elim", bench_lfstack_elim, 96},
+    {"bulk", bench_bulk, 10000000},
+    {"value", bench_value, 10000000},
+    {"grow", bench_grow, 10000000},
+};
+
+int main(int argc, char *argv[])
+{
+    UINT uiCount = 0;
+    UINT uiMax = 0;
+    BOOL_T bFound = BOOL_FALSE;
+
+    for (uiCount = 0; uiCount < sizeof(g_astBench) / sizeof(Bench_S); uiCount++)
+    {
+        if (argc > 1 && 0 != strcmp(argv[1], g_astBench[uiCount].pcName))
+        {
+            continue;
+        }
+
+        uiMax = g_astBench[uiCount].uiDefMax;
+        if (argc > 2)
+        {
+            uiMax = (UINT)strtoul(argv[2], NULL, 10);
+        }
+
+        g_astBench[uiCount].pfBench(uiMax);
+        bFound = BOOL_TRUE;
+    }
+
+    if (BOOL_FALSE == bFound)
+    {
+        printf("usage: %s [name] [max items]\n", argv[0]);
+        return 1;
+    }
+
+    return 0;
+}
@@ -16,9 +16,11 @@ Copyright(C):   Huazhong University of Science & Technology.
 /**include system headfiles**/
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <time.h>    
 #include <assert.h>
+#include <pthread.h>
 
 /**include public headfiles**/
 #include "../include/type.h"
@@ -27,7 +29,10 @@ Copyright(C):   Huazhong University of Science & Technology.
 
 /**include module headfiles**/
 #include "../include/heap.h"
+#include "../include/extheap.h"
+#include "../include/timerwheel.h"
 #include "../include/stack.h"
+#include "../include/lfstack.h"
 #include "../include/queue.h"
 #include "../include/linklist.h"
 
@@ -46,11 +51,862 @@ static VOID print(IN VOID *puiNum)
     return;
 }
 
+static ULONG hash(IN VOID *puiNum)
+{
+    assert(NULL != puiNum);
+
+    return *(UINT *)puiNum * 2654435761UL;
+}
+
+static UINT g_auiNum[4096];
+
+static VOID test_heapshrink(VOID)
+{
+    VOID *apvItems[4096];
+    Heap_S *pstHeap = NULL;
+    UINT *puiLast = NULL;
+    UINT *puiNum = NULL;
+    UINT uiRound = 0;
+    UINT uiCount = 0;
+    UINT uiNum = 0;
+
+    pstHeap = HeapCreate(16, HEAP_MINI, compare, print, NULL);
+    assert(NULL != pstHeap);
+    assert(ERROR_SUCCESS == HeapSetGrow(pstHeap, 4));
+
+    for (uiCount = 0; uiCount < 4096; uiCount++)
+    {
+        g_auiNum[uiCount] = rand() % 1000;
+        apvItems[uiCount] = &g_auiNum[uiCount];
+    }
+
+    /**a batch that fits the old memery but not the half being moved to**/
+    for (uiRound = 0; uiRound < 1000; uiRound++)
+    {
+        uiNum = rand() % (2048 - HeapNumber(pstHeap));
+        assert(ERROR_SUCCESS == HeapAddBatch(pstHeap, apvItems, uiNum));
+        uiNum = rand() % (HeapNumber(pstHeap) + 1);
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            assert(NULL != HeapRemoveRoot(pstHeap));
+        }
+        uiNum = rand() % (pstHeap->uiSize - HeapNumber(pstHeap) + 1);
+        assert(ERROR_SUCCESS == HeapAddBatch(pstHeap, apvItems, uiNum));
+        uiNum = HeapNumber(pstHeap) - rand() % (HeapNumber(pstHeap) / 8 + 1);
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            assert(NULL != HeapRemoveRoot(pstHeap));
+        }
+    }
+
+    puiLast = NULL;
+    while (NULL != (puiNum = (UINT *)HeapRemoveRoot(pstHeap)))
+    {
+        assert(NULL == puiLast || *puiLast <= *puiNum);
+        puiLast = puiNum;
+    }
+
+    HeapFree(pstHeap);
+    return;
+}
+
+static VOID test_heapminmax(VOID)
+{
+    UINT auiCount[1000] = {0};
+    VOID *apvItems[64];
+    Heap_S *pstHeap = NULL;
+    UINT *puiNum = NULL;
+    UINT uiRound = 0;
+    UINT uiCount = 0;
+    UINT uiNum = 0;
+    UINT uiMin = 0;
+    UINT uiMax = 0;
+
+    pstHeap = HeapCreate(256, HEAP_MINMAX, compare, print, NULL);
+    assert(NULL != pstHeap);
+
+    for (uiRound = 0; uiRound < 2000; uiRound++)
+    {
+        /**a batch bigger than the heap, but still sifted one by one, so
+           some new items are parents of others**/
+        uiNum = rand() % (2 * HeapNumber(pstHeap) + 4);
+        if (uiNum > 64)
+        {
+            uiNum = 64;
+        }
+        if (HeapNumber(pstHeap) + uiNum > 256)
+        {
+            uiNum = 0;
+        }
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            apvItems[uiCount] = &g_auiNum[rand() % 4096];
+            auiCount[*(UINT *)apvItems[uiCount]]++;
+        }
+        assert(ERROR_SUCCESS == HeapAddBatch(pstHeap, apvItems, uiNum));
+
+        if (0 == HeapNumber(pstHeap))
+        {
+            continue;
+        }
+
+        for (uiMin = 0; 0 == auiCount[uiMin]; uiMin++);
+        for (uiMax = 999; 0 == auiCount[uiMax]; uiMax--);
+        assert(uiMin == *(UINT *)HeapMin(pstHeap));
+        assert(uiMax == *(UINT *)HeapMax(pstHeap));
+
+        uiNum = rand() % (HeapNumber(pstHeap) + 1);
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            puiNum = (UINT *)((rand() & 1) ? HeapRemoveMin(pstHeap) :
+                                             HeapRemoveMax(pstHeap));
+            assert(NULL != puiNum);
+            auiCount[*puiNum]--;
+        }
+    }
+
+    HeapFree(pstHeap);
+    return;
+}
+
+static VOID test_heaprekey(VOID)
+{
+    UINT auiNum[64];
+    UINT auiHandle[64];
+    Heap_S *pstHeap = NULL;
+    UINT uiKey = 0;
+    UINT uiCount = 0;
+
+    pstHeap = HeapCreate(64, HEAP_MINI | HEAP_INDEXED, compare, print, NULL);
+    assert(NULL != pstHeap);
+    assert(ERROR_SUCCESS == HeapSetHash(pstHeap, hash));
+
+    for (uiCount = 0; uiCount < 64; uiCount++)
+    {
+        auiNum[uiCount] = 10 * (uiCount + 1);
+        assert(ERROR_SUCCESS ==
+               HeapAddHandle(pstHeap, &auiNum[uiCount], &auiHandle[uiCount]));
+    }
+
+    /**change 30 to 7 in place, then it must be found by the new key**/
+    auiNum[2] = 7;
+    assert(ERROR_SUCCESS == HeapDecreaseKey(pstHeap, auiHandle[2]));
+    uiKey = 7;
+    assert(&auiNum[2] == HeapSearch(pstHeap, &uiKey));
+    uiKey = 30;
+    assert(NULL == HeapSearch(pstHeap, &uiKey));
+
+    /**and both ways by HeapUpdate**/
+    for (uiCount = 0; uiCount < 1000; uiCount++)
+    {
+        auiNum[uiCount % 64] = 1000 + uiCount;
+        assert(ERROR_SUCCESS == HeapUpdate(pstHeap, auiHandle[uiCount % 64]));
+        uiKey = 1000 + uiCount;
+        assert(&auiNum[uiCount % 64] == HeapSearch(pstHeap, &uiKey));
+    }
+    assert(&auiNum[(1000 - 64) % 64] == HeapRemoveRoot(pstHeap));
+
+    HeapFree(pstHeap);
+    return;
+}
+
+static VOID test_heapblocked(VOID)
+{
+    VOID *apvItems[4096];
+    Heap_S *pstBlocked = NULL;
+    Heap_S *pstFlat = NULL;
+    UINT *puiBlocked = NULL;
+    UINT *puiFlat = NULL;
+    UINT uiRound = 0;
+    UINT uiCount = 0;
+    UINT uiNum = 0;
+
+    pstBlocked = HeapCreate(16, HEAP_MINI | HEAP_BLOCKED, compare, print, NULL);
+    pstFlat = HeapCreate(16, HEAP_MINI, compare, print, NULL);
+    assert(NULL != pstBlocked && NULL != pstFlat);
+    assert(ERROR_SUCCESS == HeapSetGrow(pstBlocked, 4));
+    assert(ERROR_SUCCESS == HeapSetGrow(pstFlat, 4));
+    assert(ERROR_SUCCESS == HeapSetHash(pstBlocked, hash));
+
+    for (uiCount = 0; uiCount < 4096; uiCount++)
+    {
+        g_auiNum[uiCount] = rand() % 100000;
+        apvItems[uiCount] = &g_auiNum[uiCount];
+    }
+
+    /**grow and shrink through several layouts of pages, the blocked heap
+       must give the same keys as the flat one**/
+    for (uiRound = 0; uiRound < 200; uiRound++)
+    {
+        uiNum = rand() % (4096 - HeapNumber(pstBlocked));
+        assert(ERROR_SUCCESS == HeapAddBatch(pstBlocked, apvItems, uiNum));
+        assert(ERROR_SUCCESS == HeapAddBatch(pstFlat, apvItems, uiNum));
+        assert(*(UINT *)HeapMax(pstBlocked) == *(UINT *)HeapMax(pstFlat));
+        puiBlocked = (UINT *)HeapSearch(pstBlocked, apvItems[0]);
+        puiFlat = (UINT *)HeapSearch(pstFlat, apvItems[0]);
+        assert((NULL == puiBlocked) == (NULL == puiFlat));
+
+        uiNum = rand() % (HeapNumber(pstBlocked) + 1);
+        for (uiCount = 0; uiCount < uiNum; uiCount++)
+        {
+            puiBlocked = (UINT *)HeapRemoveRoot(pstBlocked);
+            puiFlat = (UINT *)HeapRemoveRoot(pstFlat);
+            assert(*puiBlocked == *puiFlat);
+        }
+    }
+
+    while (NULL != (puiBlocked = (UINT *)HeapRemoveRoot(pstBlocked)))
+    {
+        puiFlat = (UINT *)HeapRemoveRoot(pstFlat);
+        assert(NULL != puiFlat && *puiBlocked == *puiFlat);
+    }
+    assert(0 == HeapNumber(pstFlat));
+
+    HeapFree(pstBlocked);
+    HeapFree(pstFlat);
+    return;
+}
+
+static VOID test_extpop(IN ExtHeap_S *pstHeap, INOUT UINT *puiCount,
+                        INOUT UCHAR *pucSeen)
+{
+    UINT auiRoot[2];
+    UINT auiItem[2];
+    UINT uiKey = 0;
+
+    assert(ERROR_SUCCESS == ExtHeapGetRoot(pstHeap, auiRoot));
+    assert(ERROR_SUCCESS == ExtHeapRemoveRoot(pstHeap, auiItem));
+    assert(auiRoot[0] == auiItem[0]);
+
+    /**the least key left by the counting sort**/
+    for (uiKey = 0; 0 == puiCount[uiKey]; uiKey++)
+    {
+    }
+    assert(auiItem[0] == uiKey);
+    puiCount[uiKey]--;
+
+    assert(0 == pucSeen[auiItem[1]]);
+    pucSeen[auiItem[1]] = 1;
+
+    return;
+}
+
+static VOID test_extheap(VOID)
+{
+    UINT auiCount[1000] = {0};
+    UCHAR aucSeen[4096] = {0};
+    UINT auiItem[2];
+    ExtHeap_S *pstHeap = NULL;
+    BOOL_T bMerged = BOOL_FALSE;
+    ULONG ulNum = 0;
+    UINT uiId = 0;
+    UINT uiRun = 0;
+
+    /**a tiny memery keeps a few dozen items, so 4096 adds spill many runs
+       and merge EXTHEAP_WAYS of them into a run of level 1**/
+    pstHeap = ExtHeapCreate(sizeof(auiItem), 1024, NULL, compare);
+    assert(NULL != pstHeap);
+    assert(pstHeap->uiMemSize < 64);
+
+    for (uiId = 0; uiId < 4096; uiId++)
+    {
+        auiItem[0] = rand() % 1000;
+        auiItem[1] = uiId;
+        assert(ERROR_SUCCESS == ExtHeapAdd(pstHeap, auiItem));
+        auiCount[auiItem[0]]++;
+        ulNum++;
+
+        for (uiRun = 0; uiRun < pstHeap->uiRuns; uiRun++)
+        {
+            if (0 != pstHeap->ppstRun[uiRun]->uiLevel)
+            {
+                bMerged = BOOL_TRUE;
+            }
+        }
+
+        /**take roots out between the spills, from memery and runs both**/
+        if (0 == rand() % 3)
+        {
+            test_extpop(pstHeap, auiCount, aucSeen);
+            ulNum--;
+        }
+        assert(ulNum == ExtHeapNumber(pstHeap));
+    }
+    assert(BOOL_TRUE == bMerged);
+
+    for (; ulNum > 0; ulNum--)
+    {
+        test_extpop(pstHeap, auiCount, aucSeen);
+        assert(ulNum - 1 == ExtHeapNumber(pstHeap));
+    }
+    assert(ERROR_FAILED == ExtHeapRemoveRoot(pstHeap, auiItem));
+    assert(0 == ExtHeapRuns(pstHeap));
+
+    ExtHeapFree(pstHeap);
+    return;
+}
+
+#define TEST_TIMERS 512
+
+static TimerWheel_S *g_pstWheel;
+static UINT64 g_aullExpire[TEST_TIMERS];  /*brute force list of expire ticks*/
+static UINT g_auiHandle[TEST_TIMERS];
+static UCHAR g_aucLive[TEST_TIMERS];
+static UINT g_uiFired;
+static UINT g_uiFreed;
+
+static UINT64 test_delay(VOID)
+{
+    switch (rand() % 6)
+    {
+        case 0:
+            return rand() % 3;
+        case 1:
+            return 1 + rand() % 255;
+        case 2:
+            return 256 + rand() % 65280;
+        case 3:
+            return 65536 + rand() % (1 << 24);
+        case 4:
+            /**beyond all wheels, parked in the top one**/
+            return (1ULL << 32) + ((UINT64)rand() << 8);
+        default:
+            return 1 + rand() % 5000;
+    }
+}
+
+static VOID test_timeradd(IN UINT uiTimer, IN UINT64 ullDelay)
+{
+    assert(0 == g_aucLive[uiTimer]);
+    assert(ERROR_SUCCESS == TimerWheelAdd(g_pstWheel, ullDelay,
+                                          &g_aullExpire[uiTimer],
+                                          &g_auiHandle[uiTimer]));
+
+    /**a delay of 0 is taken as 1**/
+    g_aullExpire[uiTimer] = TimerWheelNow(g_pstWheel) +
+                            (0 == ullDelay ? 1 : ullDelay);
+    g_aucLive[uiTimer] = 1;
+
+    return;
+}
+
+static VOID test_timercancel(IN UINT uiTimer)
+{
+    assert(1 == g_aucLive[uiTimer]);
+    assert(&g_aullExpire[uiTimer] ==
+           TimerWheelRemove(g_pstWheel, g_auiHandle[uiTimer]));
+    g_aucLive[uiTimer] = 0;
+
+    return;
+}
+
+static VOID test_expire(IN VOID *pvItem)
+{
+    UINT uiTimer = (UINT64 *)pvItem - g_aullExpire;
+    UINT uiOther = rand() % TEST_TIMERS;
+
+    assert(1 == g_aucLive[uiTimer]);
+    assert(g_aullExpire[uiTimer] == TimerWheelNow(g_pstWheel));
+    g_aucLive[uiTimer] = 0;
+    g_uiFired++;
+
+    /**add or cancel timers while the wheel is ticking, even in this slot**/
+    if (0 == rand() % 4)
+    {
+        if (1 == g_aucLive[uiOther])
+        {
+            test_timercancel(uiOther);
+        }
+        else
+        {
+            test_timeradd(uiOther, rand() % 300);
+        }
+    }
+
+    return;
+}
+
+static VOID test_timerfree(IN VOID *pvItem)
+{
+    UINT uiTimer = (UINT64 *)pvItem - g_aullExpire;
+
+    assert(1 == g_aucLive[uiTimer]);
+    g_uiFreed++;
+
+    return;
+}
+
+static VOID test_timerwheel(VOID)
+{
+    UINT64 ullTicks = 0;
+    UINT uiFired = 0;
+    UINT uiLive = 0;
+    UINT uiRound = 0;
+    UINT uiTimer = 0;
+    UINT uiOp = 0;
+
+    g_pstWheel = TimerWheelCreate(TEST_TIMERS, test_expire, NULL,
+                                  test_timerfree);
+    assert(NULL != g_pstWheel);
+
+    /**an empty wheel turns at once, start a little before the top wheel
+       turns a round so that every wheel is cascaded**/
+    TimerWheelAdvance(g_pstWheel, (1ULL << 32) - 50000);
+
+    for (uiRound = 0; uiRound < 10000; uiRound++)
+    {
+        uiOp = rand() % 10;
+        uiTimer = rand() % TEST_TIMERS;
+        if (uiOp < 4)
+        {
+            if (0 == g_aucLive[uiTimer])
+            {
+                test_timeradd(uiTimer, test_delay());
+            }
+        }
+        else if (uiOp < 6)
+        {
+            if (1 == g_aucLive[uiTimer])
+            {
+                test_timercancel(uiTimer);
+            }
+        }
+        else
+        {
+            ullTicks = (0 == rand() % 8) ? rand() % 70000 : rand() % 50;
+            uiFired = g_uiFired;
+            uiFired = TimerWheelAdvance(g_pstWheel, ullTicks) + uiFired;
+            assert(g_uiFired == uiFired);
+
+            /**no timer due is left in the wheel**/
+            for (uiTimer = 0; uiTimer < TEST_TIMERS; uiTimer++)
+            {
+                assert(0 == g_aucLive[uiTimer] ||
+                       g_aullExpire[uiTimer] > TimerWheelNow(g_pstWheel));
+            }
+        }
+
+        uiLive = 0;
+        for (uiTimer = 0; uiTimer < TEST_TIMERS; uiTimer++)
+        {
+            uiLive += g_aucLive[uiTimer];
+        }
+        assert(uiLive == TimerWheelNumber(g_pstWheel));
+    }
+    assert(TimerWheelNow(g_pstWheel) > (1ULL << 32));
+
+    TimerWheelFree(g_pstWheel);
+    assert(uiLive == g_uiFreed);
+    return;
+}
+
+static UINT g_uiLFFreed;
+
+static VOID test_lffree(IN VOID *pvItem)
+{
+    assert(NULL != pvItem);
+    g_uiLFFreed++;
+
+    return;
+}
+
+static VOID test_lfstack(VOID)
+{
+    LFStack_S *pstStack = NULL;
+    UINT uiCount = 0;
+
+    assert(NULL == LFStackCreate(0, NULL, NULL));
+    pstStack = LFStackCreate(8, print, test_lffree);
+    assert(NULL != pstStack);
+    assert(NULL == LFStackPop(pstStack));
+    assert(NULL == LFStackPeek(pstStack));
+
+    /**the pool runs out after uiSize items**/
+    for (uiCount = 0; uiCount < 8; uiCount++)
+    {
+        g_auiNum[uiCount] = uiCount;
+        assert(ERROR_SUCCESS == LFStackPush(pstStack, &g_auiNum[uiCount]));
+        assert(&g_auiNum[uiCount] == LFStackPeek(pstStack));
+    }
+    assert(ERROR_FAILED == LFStackPush(pstStack, &g_auiNum[8]));
+    assert(ERROR_FAILED == LFStackPush(pstStack, NULL));
+    assert(8 == LFStackNumber(pstStack));
+
+    /**last in first out, and a node popped is used again**/
+    for (uiCount = 8; uiCount > 5; uiCount--)
+    {
+        assert(&g_auiNum[uiCount - 1] == LFStackPop(pstStack));
+    }
+    assert(&g_auiNum[4] == LFStackPeek(pstStack));
+    assert(ERROR_SUCCESS == LFStackPush(pstStack, &g_auiNum[8]));
+    assert(&g_auiNum[8] == LFStackPop(pstStack));
+    assert(5 == LFStackNumber(pstStack));
+
+    g_uiLFFreed = 0;
+    LFStackFree(pstStack);
+    assert(5 == g_uiLFFreed);
+    return;
+}
+
+#define TEST_LFTHREADS 4
+#define TEST_LFITEMS   20000
+
+static LFStack_S *g_pstLFStack;
+static UINT g_auiLFItem[TEST_LFTHREADS][TEST_LFITEMS];
+static UINT g_auiLFPopped[TEST_LFTHREADS][TEST_LFTHREADS * TEST_LFITEMS];
+static UINT g_auiLFPops[TEST_LFTHREADS];
+
+static VOID test_lfpop(IN UINT uiThread)
+{
+    UINT *puiItem = LFStackPop(g_pstLFStack);
+
+    if (NULL != puiItem)
+    {
+        g_auiLFPopped[uiThread][g_auiLFPops[uiThread]++] = *puiItem;
+    }
+
+    return;
+}
+
+static VOID* test_lfworker(IN VOID *pvThread)
+{
+    UINT uiThread = (UINT)(ULONG)pvThread;
+    UINT uiCount = 0;
+
+    for (uiCount = 0; uiCount < TEST_LFITEMS; uiCount++)
+    {
+        g_auiLFItem[uiThread][uiCount] = uiThread * TEST_LFITEMS + uiCount;
+
+        /**a small pool, so it's often full**/
+        while (ERROR_SUCCESS !=
+               LFStackPush(g_pstLFStack, &g_auiLFItem[uiThread][uiCount]))
+        {
+            test_lfpop(uiThread);
+        }
+        if (0 != uiCount % 3)
+        {
+            test_lfpop(uiThread);
+            (VOID)LFStackPeek(g_pstLFStack);
+        }
+    }
+
+    return NULL;
+}
+
+static VOID test_lfthreads(IN UINT uiSlots)
+{
+    static UCHAR aucSeen[TEST_LFTHREADS * TEST_LFITEMS];
+    pthread_t astThread[TEST_LFTHREADS];
+    UINT *puiItem = NULL;
+    UINT uiThread = 0;
+    UINT uiCount = 0;
+    UINT uiTotal = 0;
+
+    g_pstLFStack = LFStackCreate(64, NULL, NULL);
+    assert(NULL != g_pstLFStack);
+    assert(ERROR_SUCCESS == LFStackSetEliminate(g_pstLFStack, uiSlots));
+
+    for (uiThread = 0; uiThread < TEST_LFTHREADS; uiThread++)
+    {
+        g_auiLFPops[uiThread] = 0;
+        assert(0 == pthread_create(&astThread[uiThread], NULL, test_lfworker,
+                                   (VOID *)(ULONG)uiThread));
+    }
+    for (uiThread = 0; uiThread < TEST_LFTHREADS; uiThread++)
+    {
+        assert(0 == pthread_join(astThread[uiThread], NULL));
+    }
+
+    /**every item pushed is popped once, by a worker or at last here**/
+    memset(aucSeen, 0, sizeof(aucSeen));
+    for (uiThread = 0; uiThread < TEST_LFTHREADS; uiThread++)
+    {
+        for (uiCount = 0; uiCount < g_auiLFPops[uiThread]; uiCount++)
+        {
+            assert(0 == aucSeen[g_auiLFPopped[uiThread][uiCount]]);
+            aucSeen[g_auiLFPopped[uiThread][uiCount]] = 1;
+            uiTotal++;
+        }
+    }
+    assert(TEST_LFTHREADS * TEST_LFITEMS - uiTotal ==
+           LFStackNumber(g_pstLFStack));
+    while (NULL != (puiItem = LFStackPop(g_pstLFStack)))
+    {
+        assert(0 == aucSeen[*puiItem]);
+        aucSeen[*puiItem] = 1;
+        uiTotal++;
+    }
+    assert(TEST_LFTHREADS * TEST_LFITEMS == uiTotal);
+
+    LFStackFree(g_pstLFStack);
+    return;
+}
+
+static VOID test_stackbulk(VOID)
+{
+    VOID *apvItem[16];
+    VOID *apvOut[16];
+    Stack_S *pstStack = NULL;
+    UINT uiCount = 0;
+
+    for (uiCount = 0; uiCount < 16; uiCount++)
+    {
+        g_auiNum[uiCount] = uiCount;
+        apvItem[uiCount] = &g_auiNum[uiCount];
+    }
+
+    pstStack = StackCreate(8, print, NULL);
+    assert(NULL != pstStack);
+    assert(0 == StackPopN(pstStack, 4, apvOut));
+
+    /**only the room left is filled when it's full**/
+    assert(5 == StackPushN(pstStack, apvItem, 5));
+    assert(3 == StackPushN(pstStack, apvItem + 5, 5));
+    assert(0 == StackPushN(pstStack, apvItem + 8, 1));
+    assert(8 == StackNumber(pstStack));
+    assert(&g_auiNum[7] == StackPeek(pstStack));
+
+    /**popped in the order they were in stack, the top one last**/
+    assert(3 == StackPopN(pstStack, 3, apvOut));
+    for (uiCount = 0; uiCount < 3; uiCount++)
+    {
+        assert(apvItem[5 + uiCount] == apvOut[uiCount]);
+    }
+    assert(5 == StackPopN(pstStack, 16, apvOut));
+    for (uiCount = 0; uiCount < 5; uiCount++)
+    {
+        assert(apvItem[uiCount] == apvOut[uiCount]);
+    }
+    assert(0 == StackNumber(pstStack));
+    assert(0 == StackPopN(pstStack, 1, apvOut));
+
+    StackFree(pstStack);
+    return;
+}
+
+static VOID test_queuebulk(VOID)
+{
+    VOID *apvItem[16];
+    VOID *apvOut[16];
+    Queue_S *pstQueue = NULL;
+    UINT uiCount = 0;
+
+    for (uiCount = 0; uiCount < 16; uiCount++)
+    {
+        g_auiNum[uiCount] = uiCount;
+        apvItem[uiCount] = &g_auiNum[uiCount];
+    }
+
+    pstQueue = QueueCreate(8, print, NULL);
+    assert(NULL != pstQueue);
+    assert(0 == QueueRemoveN(pstQueue, 4, apvOut));
+
+    /**move the head on, so the next items wrap to the start of memery**/
+    assert(6 == QueueAddN(pstQueue, apvItem, 6));
+    assert(4 == QueueRemoveN(pstQueue, 4, apvOut));
+    for (uiCount = 0; uiCount < 4; uiCount++)
+    {
+        assert(apvItem[uiCount] == apvOut[uiCount]);
+    }
+
+    /**copied in two pieces, and only the room left is filled when full**/
+    assert(5 == QueueAddN(pstQueue, apvItem + 6, 5));
+    assert(pstQueue->ppvTail < pstQueue->ppvHead);
+    assert(1 == QueueAddN(pstQueue, apvItem + 11, 3));
+    assert(0 == QueueAddN(pstQueue, apvItem + 12, 1));
+    assert(8 == QueueNumber(pstQueue));
+
+    /**removed in two pieces too, the first one first**/
+    assert(3 == QueueRemoveN(pstQueue, 3, apvOut));
+    assert(5 == QueueRemoveN(pstQueue, 16, apvOut + 3));
+    for (uiCount = 0; uiCount < 8; uiCount++)
+    {
+        assert(apvItem[4 + uiCount] == apvOut[uiCount]);
+    }
+    assert(0 == QueueNumber(pstQueue));
+    assert(0 == QueueRemoveN(pstQueue, 1, apvOut));
+
+    QueueFree(pstQueue);
+    return;
+}
+
+static UCHAR g_aucFreed[4096];
+
+static VOID test_stackfree(IN VOID *puiNum)
+{
+    assert(NULL != puiNum);
+    assert(0 == g_aucFreed[*(UINT *)puiNum]);
+    g_aucFreed[*(UINT *)puiNum] = 1;
+
+    return;
+}
+
+static VOID test_stackchunked(VOID)
+{
+    Stack_S *pstStack = NULL;
+    StackChunk_S *pstChunk = NULL;
+    UINT uiRound = 0;
+    UINT uiCount = 0;
+
+    pstStack = StackCreateChunked(4, print, test_stackfree);
+    assert(NULL != pstStack);
+
+    /**a full chunk and an item in the next one**/
+    for (uiCount = 0; uiCount < 5; uiCount++)
+    {
+        g_auiNum[uiCount] = uiCount;
+        assert(ERROR_SUCCESS == StackPush(pstStack, &g_auiNum[uiCount]));
+    }
+    pstChunk = pstStack->pstChunk;
+    assert(NULL == pstStack->pstSpare);
+
+    /**oscillate across the edge, the same chunk is dropped and taken back**/
+    for (uiRound = 0; uiRound < 8; uiRound++)
+    {
+        assert(&g_auiNum[4] == StackPop(pstStack));
+        assert(&g_auiNum[3] == StackPop(pstStack));
+        assert(pstChunk == pstStack->pstSpare);
+        assert(3 == StackNumber(pstStack));
+
+        assert(ERROR_SUCCESS == StackPush(pstStack, &g_auiNum[3]));
+        assert(ERROR_SUCCESS == StackPush(pstStack, &g_auiNum[4]));
+        assert(pstChunk == pstStack->pstChunk);
+        assert(NULL == pstStack->pstSpare);
+        assert(5 == StackNumber(pstStack));
+    }
+
+    /**items in every chunk are freed once**/
+    for (uiCount = 5; uiCount < 18; uiCount++)
+    {
+        g_auiNum[uiCount] = uiCount;
+        assert(ERROR_SUCCESS == StackPush(pstStack, &g_auiNum[uiCount]));
+    }
+    assert(&g_auiNum[17] == StackPop(pstStack));
+    memset(g_aucFreed, 0, sizeof(g_aucFreed));
+    StackFree(pstStack);
+    for (uiCount = 0; uiCount < 18; uiCount++)
+    {
+        assert((17 != uiCount) == g_aucFreed[uiCount]);
+    }
+
+    return;
+}
+
+static VOID test_stackvalue(VOID)
+{
+    UINT auiItem[2];
+    VOID *pvItem = &auiItem;
+    Stack_S *pstStack = NULL;
+    UINT *puiSlot = NULL;
+    UINT uiCount = 0;
+
+    pstStack = StackCreateValue(4, sizeof(auiItem), print, test_stackfree);
+    assert(NULL != pstStack);
+    assert(NULL == StackPeek(pstStack));
+
+    /**a record is copied, changing the item later doesn't change it**/
+    for (uiCount = 0; uiCount < 4; uiCount++)
+    {
+        auiItem[0] = uiCount;
+        auiItem[1] = uiCount * 10;
+        assert(ERROR_SUCCESS == StackPush(pstStack, auiItem));
+        auiItem[0] = 99;
+
+        puiSlot = StackPeek(pstStack);
+        assert((CHAR *)puiSlot ==
+               pstStack->pcValue + uiCount * sizeof(auiItem));
+        assert(uiCount == puiSlot[0] && uiCount * 10 == puiSlot[1]);
+    }
+    assert(ERROR_FAILED == StackPush(pstStack, auiItem));
+    assert(0 == StackPushN(pstStack, &pvItem, 1));
+
+    /**the slot popped keeps the record till the next push**/
+    puiSlot = StackPop(pstStack);
+    assert((CHAR *)puiSlot == pstStack->pcValue + 3 * sizeof(auiItem));
+    assert(3 == puiSlot[0] && 30 == puiSlot[1]);
+    assert(3 == StackNumber(pstStack));
+    assert(2 == ((UINT *)StackPeek(pstStack))[0]);
+
+    memset(g_aucFreed, 0, sizeof(g_aucFreed));
+    StackFree(pstStack);
+    for (uiCount = 0; uiCount < 4; uiCount++)
+    {
+        assert((3 != uiCount) == g_aucFreed[uiCount]);
+    }
+
+    return;
+}
+
+static VOID test_queuevalue(VOID)
+{
+    UINT auiItem[2];
+    VOID *pvItem = &auiItem;
+    Queue_S *pstQueue = NULL;
+    UINT *puiSlot = NULL;
+    UINT uiCount = 0;
+
+    pstQueue = QueueCreateValue(4, sizeof(auiItem), print, NULL);
+    assert(NULL != pstQueue);
+    assert(NULL == QueueGetFirst(pstQueue));
+    assert(0 == QueueAddN(pstQueue, &pvItem, 1));
+
+    for (uiCount = 0; uiCount < 3; uiCount++)
+    {
+        auiItem[0] = uiCount;
+        auiItem[1] = uiCount * 10;
+        assert(ERROR_SUCCESS == QueueAdd(pstQueue, auiItem));
+    }
+    auiItem[0] = 99;
+    assert(0 == ((UINT *)QueueRemoveFirst(pstQueue))[0]);
+    assert(1 == ((UINT *)QueueRemoveFirst(pstQueue))[0]);
+
+    /**uiSize slots in a ring, not one more as a pointer queue has**/
+    for (uiCount = 3; uiCount < 6; uiCount++)
+    {
+        auiItem[0] = uiCount;
+        auiItem[1] = uiCount * 10;
+        assert(ERROR_SUCCESS == QueueAdd(pstQueue, auiItem));
+    }
+    assert(ERROR_FAILED == QueueAdd(pstQueue, auiItem));
+    assert(4 == QueueNumber(pstQueue));
+
+    /**the records wrap to the start of memery and come out in order**/
+    for (uiCount = 2; uiCount < 6; uiCount++)
+    {
+        puiSlot = QueueGetFirst(pstQueue);
+        assert((CHAR *)puiSlot ==
+               pstQueue->pcValue + (uiCount % 4) * sizeof(auiItem));
+        assert(puiSlot == QueueRemoveFirst(pstQueue));
+        assert(uiCount == puiSlot[0] && uiCount * 10 == puiSlot[1]);
+    }
+    assert(NULL == QueueRemoveFirst(pstQueue));
+    assert(0 == QueueRemoveN(pstQueue, 1, &pvItem));
+
+    QueueFree(pstQueue);
+    return;
+}
+
 int main()
 { 
     UINT uiCount = 100;
     UINT *puiNum = NULL;
 
+    srand(time(NULL));
+    test_heapshrink();
+    test_heapminmax();
+    test_heaprekey();
+    test_heapblocked();
+    test_extheap();
+    test_timerwheel();
+    test_lfstack();
+    test_lfthreads(0);
+    test_lfthreads(TEST_LFTHREADS / 2);
+    test_stackbulk();
+    test_queuebulk();
+    test_stackchunked();
+    test_stackvalue();
+    test_queuevalue();
+
     SLHead_S *pstSL = SLHeadCreate(LNKLST_NOORDER, compare, print, free);
     if (NULL == pstSL)
     {